@@ -0,0 +1,120 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if ALLOCATION_TRACKING
+
+//one per tracked thread, never handed back, a thread that exits keeps its count
+static std::atomic<unsigned long long> s_Tracked[AllocationCounter::MaxTrackedThreads]; 
+static std::atomic<unsigned int> s_TrackedThreads(0); 
+//the calling thread's slot of s_Tracked, null while it is not tracked
+static thread_local std::atomic<unsigned long long>* t_Counter = nullptr; 
+
+bool AllocationCounter::TrackThread()
+{
+    if (t_Counter)
+        return true; 
+    unsigned int slot = s_TrackedThreads.load(std::memory_order_relaxed); 
+    do
+    { 
+        if (slot >= MaxTrackedThreads)
+            return false; 
+    } while (!s_TrackedThreads.compare_exchange_weak(slot, slot + 1, std::memory_order_relaxed)); 
+    t_Counter = &s_Tracked[slot]; 
+    return true; 
+}
+
+unsigned long long AllocationCounter::GetCount()
+{
+    unsigned int threads = s_TrackedThreads.load(std::memory_order_relaxed); 
+    unsigned long long count = 0; 
+    for (unsigned int i = 0; i < threads; i++)
+        count += s_Tracked[i].load(std::memory_order_relaxed); 
+    return count; 
+}
+
+//only the owning thread writes its counter, no read-modify-write needed
+static inline void CountAllocation()
+{
+    std::atomic<unsigned long long>* counter = t_Counter; 
+    if (counter)
+        counter->store(counter->load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); 
+}
+
+static void* CountedAlloc(size_t size)
+{
+    CountAllocation(); 
+    return malloc(size ? size : 1); 
+}
+
+static void* CountedAlignedAlloc(size_t size, size_t alignment)
+{
+    CountAllocation(); 
+    void* memory = nullptr; 
+    if (alignment < sizeof(void*))
+        alignment = sizeof(void*); 
+    if (posix_memalign(&memory, alignment, size ? size : 1) != 0)
+        return nullptr; 
+    return memory; 
+}
+
+void* operator new(size_t size)
+{
+    void* memory = CountedAlloc(size); 
+    if (!memory)
+        throw std::bad_alloc(); 
+    return memory; 
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size); 
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size); 
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size); 
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    void* memory = CountedAlignedAlloc(size, (size_t)alignment); 
+    if (!memory)
+        throw std::bad_alloc(); 
+    return memory; 
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment); 
+}
+
+void operator delete(void* memory) noexcept { free(memory); }
+void operator delete[](void* memory) noexcept { free(memory); }
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+void operator delete[](void* memory, size_t) noexcept { free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { free(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { free(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { free(memory); }
+
+#else
+
+bool AllocationCounter::TrackThread()
+{
+    return false; 
+}
+
+unsigned long long AllocationCounter::GetCount()
+{
+    return 0; 
+}
+
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Assert.h"
+
+//Counts calls to the global operator new so a frame can be checked for heap
+//allocations. Linking AllocationCounter.cpp replaces the global new/delete;
+//tracking is on in debug builds and can be forced with ALLOCATION_TRACKING.
+//
+//Every thread counts its own allocations, GetCount only adds up the threads
+//that called TrackThread, e.g. the render thread and the ones recording for
+//it. The logger's writer and other background threads allocate whenever
+//they like without failing a frame.
+#ifndef ALLOCATION_TRACKING
+#ifdef NDEBUG
+#define ALLOCATION_TRACKING 0
+#else
+#define ALLOCATION_TRACKING 1
+#endif
+#endif
+
+class AllocationCounter
+{ 
+public: 
+	static const unsigned int MaxTrackedThreads = 64; 
+
+	//counts the calling thread's allocations from now on, calling it again
+	//does nothing; false once MaxTrackedThreads are tracked
+	static bool TrackThread(); 
+	//allocations on the tracked threads since they called TrackThread, 0 when tracking is off
+	static unsigned long long GetCount(); 
+	static inline bool IsEnabled() { return ALLOCATION_TRACKING != 0; }
+}; 
+
+//allocations made between construction and GetCount()
+class AllocationScope
+{ 
+private: 
+	unsigned long long m_Start; 
+public: 
+	AllocationScope() : m_Start(AllocationCounter::GetCount()) {}
+	inline unsigned long long GetCount() const { return AllocationCounter::GetCount() - m_Start; }
+}; 
+
+//wrap the steady state render loop body, after the pools and arenas have warmed up
+#define ASSERT_NO_ALLOCATIONS(scope) ASSERT((scope).GetCount() == 0)
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <signal.h>
+
+#include "Log.h"
+
+//flush first, the messages explaining the failure are still queued
+#define ASSERT(x) if (!(x)) { Logger::Flush(); raise(SIGTRAP); }
@@ -0,0 +1,277 @@
+#include <GL/glew.h>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Renderer.h"
+#include "Context.h"
+#include "AssetLoader.h"
+#include "JobSystem.h"
+#include "Shader.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+
+using namespace std; 
+
+//Writes a few hundred meshes to raw vertex and index files, then loads them
+//twice while a render loop keeps drawing whatever is loaded: once through an
+//AssetLoader, with the reads on the JobSystem, the uploads on a shared
+//context and a budget for finalizing each frame, and once on the render
+//thread, one mesh a frame, the way the VertexBuffer and IndexBuffer
+//constructors would. Prints the frame times of both as JSON, e.g.
+//
+//  ./AssetBench --meshes 200 --vertices 20000 --budget 2 > assets.json
+//
+//The loader goes first, so the files are only in the OS cache for the run
+//on the render thread and the comparison leans its way.
+
+static double Now()
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now().time_since_epoch()).count(); 
+}
+
+static string MeshPath(const string& prefix, unsigned int mesh, const char* kind)
+{
+    return prefix + to_string(mesh) + "." + kind; 
+}
+
+//a fan around a random point, vertices as Float2 and 32 bit indices, as the loader reads them
+static bool WriteMesh(const string& prefix, unsigned int mesh, unsigned int vertexCount)
+{
+    vector<Float2> vertices; 
+    vector<unsigned int> indices; 
+    float x = rand() / (float)RAND_MAX * 1.8f - 0.9f; 
+    float y = rand() / (float)RAND_MAX * 1.8f - 0.9f; 
+    vertices.push_back({ x, y }); 
+    unsigned int sides = vertexCount - 1; 
+    for (unsigned int i = 0; i < sides; i++)
+    {
+        float angle = 6.2831853f * i / sides; 
+        vertices.push_back({ x + 0.05f * cosf(angle), y + 0.05f * sinf(angle) }); 
+        indices.push_back(0); 
+        indices.push_back(1 + i); 
+        indices.push_back(1 + (i + 1) % sides); 
+    }
+
+    ofstream vertexFile(MeshPath(prefix, mesh, "vertices"), ios::binary); 
+    vertexFile.write((const char*)vertices.data(), vertices.size() * sizeof(Float2)); 
+    ofstream indexFile(MeshPath(prefix, mesh, "indices"), ios::binary); 
+    indexFile.write((const char*)indices.data(), indices.size() * sizeof(unsigned int)); 
+    return (bool)vertexFile && (bool)indexFile; 
+}
+
+static bool ReadFile(const string& path, vector<char>& data)
+{
+    ifstream stream(path, ios::binary | ios::ate); 
+    if (!stream)
+        return false; 
+    data.resize((size_t)stream.tellg()); 
+    stream.seekg(0); 
+    return (bool)stream.read(data.data(), data.size()); 
+}
+
+struct FrameTimes
+{
+    unsigned int Frames = 0; 
+    double LongestMs = 0.0; 
+    double TotalMs = 0.0; 
+    unsigned long long Draws = 0; 
+
+    void Add(double ms)
+    {
+        Frames++; 
+        if (ms > LongestMs)
+            LongestMs = ms; 
+    }
+}; 
+
+static void DrawMeshes(const vector<VertexArray*>& arrays, const vector<IndexBuffer*>& indexBuffers, FrameTimes& times)
+{
+    for (unsigned int i = 0; i < arrays.size(); i++)
+    {
+        if (!arrays[i])
+            continue; 
+        arrays[i]->Bind(); 
+        GLCall(glDrawElements(GL_TRIANGLES, indexBuffers[i]->GetCount(), indexBuffers[i]->GetType(), nullptr));
+        times.Draws++; 
+    }
+}
+
+static void PrintTimes(const char* name, const FrameTimes& times, bool last)
+{
+    cout << "  \"" << name << "\": { \"total_ms\": " << times.TotalMs << ", \"frames\": " << times.Frames
+         << ", \"longest_frame_ms\": " << times.LongestMs
+         << ", \"average_frame_ms\": " << (times.Frames ? times.TotalMs / times.Frames : 0.0)
+         << ", \"draws\": " << times.Draws << " }" << (last ? "\n" : ",\n"); 
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int meshCount = 200; 
+    unsigned int vertexCount = 20000; 
+    double budgetMs = 2.0; 
+    string prefix = "AssetBench.mesh"; 
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--meshes") && i + 1 < argc)
+            meshCount = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--vertices") && i + 1 < argc)
+            vertexCount = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--budget") && i + 1 < argc)
+            budgetMs = atof(argv[++i]); 
+        else if (!strcmp(argv[i], "--prefix") && i + 1 < argc)
+            prefix = argv[++i]; 
+        else
+        {
+            cerr << "usage: AssetBench [--meshes n] [--vertices n] [--budget ms] [--prefix path]" << endl; 
+            return -1; 
+        }
+    }
+    if (!meshCount || vertexCount < 3)
+    {
+        cerr << "needs at least one mesh of at least 3 vertices" << endl; 
+        return -1; 
+    }
+
+    ContextOptions options; 
+    options.Title = "AssetBench"; 
+    options.SwapInterval = 0; 
+    options.Headless = true; 
+    Context context(options); 
+    if (!context.IsValid())
+        return -1; 
+
+    srand(1); 
+    for (unsigned int i = 0; i < meshCount; i++)
+    {
+        if (!WriteMesh(prefix, i, vertexCount))
+        {
+            cerr << "cannot write " << MeshPath(prefix, i, "vertices") << endl; 
+            return -1; 
+        }
+    }
+
+    FrameTimes loaded; 
+    FrameTimes blocking; 
+    AssetLoader::Stats stats; 
+    {
+    JobSystem jobs; 
+
+    //through the loader, the render loop never waits for a file or an upload
+    {
+    AssetLoader loader(context, jobs); 
+    ShaderAsset* shader = loader.LoadShader("res/shaders/Basic.shader"); 
+    vector<VertexBufferAsset*> vertexAssets; 
+    vector<IndexBufferAsset*> indexAssets; 
+    double start = Now(); 
+    for (unsigned int i = 0; i < meshCount; i++)
+    {
+        vertexAssets.push_back(loader.LoadVertexBuffer(MeshPath(prefix, i, "vertices"))); 
+        indexAssets.push_back(loader.LoadIndexBuffer(MeshPath(prefix, i, "indices"))); 
+    }
+
+    vector<VertexArray*> arrays(meshCount, nullptr); 
+    vector<IndexBuffer*> indexBuffers(meshCount, nullptr); 
+    bool colorSet = false; 
+    while (loader.GetPendingCount())
+    {
+        double frameStart = Now(); 
+        loader.Update(budgetMs); 
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+        for (unsigned int i = 0; i < meshCount; i++)
+        {
+            if (arrays[i] || !vertexAssets[i]->IsReady() || !indexAssets[i]->IsReady())
+                continue; 
+            arrays[i] = new VertexArray(); 
+            arrays[i]->AddBuffer<Float2>(*vertexAssets[i]->Get()); 
+            indexBuffers[i] = indexAssets[i]->Get(); 
+            arrays[i]->SetIndexBuffer(*indexBuffers[i]); 
+        }
+        //nothing is drawn until the shader is there either
+        if (shader->IsReady())
+        {
+            if (!colorSet)
+            {
+                shader->Get()->SetUniform4f("u_Color", 0.2f, 0.3f, 0.8f, 1.0f); 
+                colorSet = true; 
+            }
+            shader->Get()->Bind(); 
+            DrawMeshes(arrays, indexBuffers, loaded); 
+        }
+        context.SwapBuffers(); 
+        loaded.Add(Now() - frameStart); 
+    }
+    GLCall(glFinish());
+    loaded.TotalMs = Now() - start; 
+    stats = loader.GetStats(); 
+
+    for (VertexArray* va : arrays)
+        delete va; 
+    }
+
+    //on the render thread, every frame reads and uploads one more mesh
+    {
+    Shader shader("res/shaders/Basic.shader"); 
+    shader.SetUniform4f("u_Color", 0.2f, 0.3f, 0.8f, 1.0f); 
+    vector<VertexArray*> arrays(meshCount, nullptr); 
+    vector<VertexBuffer*> vertexBuffers(meshCount, nullptr); 
+    vector<IndexBuffer*> indexBuffers(meshCount, nullptr); 
+    vector<char> data; 
+    double start = Now(); 
+    for (unsigned int i = 0; i < meshCount; i++)
+    {
+        double frameStart = Now(); 
+        if (ReadFile(MeshPath(prefix, i, "vertices"), data))
+            vertexBuffers[i] = new VertexBuffer(data.data(), (unsigned int)data.size()); 
+        if (ReadFile(MeshPath(prefix, i, "indices"), data))
+            indexBuffers[i] = new IndexBuffer((const unsigned int*)data.data(), (unsigned int)(data.size() / sizeof(unsigned int))); 
+        if (vertexBuffers[i] && indexBuffers[i])
+        {
+            arrays[i] = new VertexArray(); 
+            arrays[i]->AddBuffer<Float2>(*vertexBuffers[i]); 
+            arrays[i]->SetIndexBuffer(*indexBuffers[i]); 
+        }
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+        shader.Bind(); 
+        DrawMeshes(arrays, indexBuffers, blocking); 
+        context.SwapBuffers(); 
+        blocking.Add(Now() - frameStart); 
+    }
+    GLCall(glFinish());
+    blocking.TotalMs = Now() - start; 
+
+    for (VertexArray* va : arrays)
+        delete va; 
+    for (VertexBuffer* vb : vertexBuffers)
+        delete vb; 
+    for (IndexBuffer* ib : indexBuffers)
+        delete ib; 
+    }
+    }
+
+    for (unsigned int i = 0; i < meshCount; i++)
+    {
+        remove(MeshPath(prefix, i, "vertices").c_str()); 
+        remove(MeshPath(prefix, i, "indices").c_str()); 
+    }
+
+    cout.setf(ios::fixed); 
+    cout.precision(4); 
+    cout << "{\n  \"renderer\": \"" << glGetString(GL_RENDERER) << "\",\n"
+         << "  \"meshes\": " << meshCount << ",\n"
+         << "  \"bytes_per_mesh\": " << vertexCount * sizeof(Float2) + (vertexCount - 1) * 3 * sizeof(unsigned int) << ",\n"
+         << "  \"budget_ms\": " << budgetMs << ",\n"
+         << "  \"assets\": { \"requested\": " << stats.Requested << ", \"ready\": " << stats.Ready << ", \"failed\": " << stats.Failed << " },\n"; 
+    PrintTimes("asset_loader", loaded, false); 
+    PrintTimes("render_thread", blocking, true); 
+    cout << "}" << endl; 
+    return 0; 
+}
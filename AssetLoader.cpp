@@ -0,0 +1,317 @@
+#include "AssetLoader.h"
+#include "Context.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "Renderer.h"
+
+#include <chrono>
+#include <fstream>
+
+using namespace std; 
+
+static bool ReadFile(const std::string& path, std::vector<char>& data)
+{
+    std::ifstream stream(path, std::ios::binary | std::ios::ate); 
+    if (!stream)
+        return false; 
+    data.resize((size_t)stream.tellg()); 
+    stream.seekg(0); 
+    return (bool)stream.read(data.data(), data.size()); 
+}
+
+//creates a buffer on the upload context, binding to a target nobody else uses on it
+static unsigned int UploadBuffer(const std::vector<char>& data)
+{
+    unsigned int buffer; 
+    GLCall(glGenBuffers(1, &buffer)); 
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, buffer)); 
+    GLCall(glBufferData(GL_COPY_WRITE_BUFFER, data.size(), data.data(), GL_STATIC_DRAW)); 
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, 0)); 
+    return buffer; 
+}
+
+ShaderAsset::~ShaderAsset()
+{
+    //still ours until Finalize hands it to the Shader, e.g. when the loader goes first
+    if (m_Program && !m_Shader)
+        GLCall(glDeleteProgram(m_Program)); 
+}
+
+bool ShaderAsset::Load()
+{
+    std::ifstream stream(m_Path); 
+    if (!stream)
+        return false; 
+    m_Source = ParseShader(m_Path); 
+    return !m_Source.VertexSource.empty() && !m_Source.FragmentSource.empty(); 
+}
+
+bool ShaderAsset::Upload()
+{
+    //programs are shared between contexts, so even compiling happens off the render thread
+    m_Program = CreateShader(m_Source.VertexSource, m_Source.FragmentSource); 
+    int linked = 0; 
+    GLCall(glGetProgramiv(m_Program, GL_LINK_STATUS, &linked)); 
+    m_Source = ShaderProgramSource(); 
+    if (!linked)
+    { 
+        GLCall(glDeleteProgram(m_Program)); 
+        m_Program = 0; 
+    }
+    return linked != 0; 
+}
+
+bool ShaderAsset::Finalize()
+{
+    m_Shader.reset(new Shader(m_Program)); 
+    return true; 
+}
+
+VertexBufferAsset::VertexBufferAsset(const std::string& path)
+  : Asset(path), m_Buffer(0)
+{
+}
+
+VertexBufferAsset::~VertexBufferAsset()
+{
+    //still ours until Finalize hands it to the VertexBuffer
+    if (m_Buffer && !m_VertexBuffer)
+        GLCall(glDeleteBuffers(1, &m_Buffer)); 
+}
+
+bool VertexBufferAsset::Load()
+{
+    return ReadFile(m_Path, m_Data) && !m_Data.empty(); 
+}
+
+bool VertexBufferAsset::Upload()
+{
+    m_Buffer = UploadBuffer(m_Data); 
+    return true; 
+}
+
+bool VertexBufferAsset::Finalize()
+{
+    m_VertexBuffer.reset(VertexBuffer::Adopt(m_Buffer, (unsigned int)m_Data.size())); 
+    std::vector<char>().swap(m_Data); 
+    return true; 
+}
+
+IndexBufferAsset::IndexBufferAsset(const std::string& path)
+  : Asset(path), m_Count(0), m_Type(GL_UNSIGNED_INT), m_Buffer(0)
+{
+}
+
+IndexBufferAsset::~IndexBufferAsset()
+{
+    if (m_Buffer && !m_IndexBuffer)
+        GLCall(glDeleteBuffers(1, &m_Buffer)); 
+}
+
+bool IndexBufferAsset::Load()
+{
+    if (!ReadFile(m_Path, m_Data) || m_Data.empty() || m_Data.size() % sizeof(unsigned int) != 0)
+        return false; 
+
+    //done here on the worker, the same choice the IndexBuffer constructor makes
+    m_Count = (unsigned int)(m_Data.size() / sizeof(unsigned int)); 
+    const unsigned int* indices = (const unsigned int*)m_Data.data(); 
+    for (unsigned int i = 0; i < m_Count; i++)
+    { 
+        if (indices[i] > 0xffff)
+            return true; 
+    }
+    std::vector<char> shorts(m_Count * sizeof(unsigned short)); 
+    for (unsigned int i = 0; i < m_Count; i++)
+        ((unsigned short*)shorts.data())[i] = (unsigned short)indices[i]; 
+    m_Data.swap(shorts); 
+    m_Type = GL_UNSIGNED_SHORT; 
+    return true; 
+}
+
+bool IndexBufferAsset::Upload()
+{
+    m_Buffer = UploadBuffer(m_Data); 
+    return true; 
+}
+
+bool IndexBufferAsset::Finalize()
+{
+    m_IndexBuffer.reset(IndexBuffer::Adopt(m_Buffer, m_Count, m_Type)); 
+    std::vector<char>().swap(m_Data); 
+    return true; 
+}
+
+AssetLoader::AssetLoader(Context& context, JobSystem& jobs)
+  : m_Jobs(jobs), m_Running(true), m_Failed(0)
+{
+    m_UploadContext = context.CreateShared(); 
+    if (!m_UploadContext->IsValid())
+        LOG_ERROR("Failed to create the asset upload context"); 
+    m_UploadThread = std::thread(&AssetLoader::UploadLoop, this); 
+}
+
+AssetLoader::~AssetLoader()
+{
+    m_Jobs.Wait(m_LoadCounter); 
+    { 
+        std::lock_guard<std::mutex> lock(m_Mutex); 
+        m_Running = false; 
+    }
+    m_UploadReady.notify_all(); 
+    m_UploadThread.join(); 
+
+    for (Asset* asset : m_FinalizeQueue)
+        GLCall(glDeleteSync((GLsync)asset->m_Fence)); 
+    m_Assets.clear(); 
+    delete m_UploadContext; 
+}
+
+template<typename T>
+T* AssetLoader::Request(const std::string& path)
+{
+    T* asset = new T(path); 
+    //the job only gets the asset, this is how it finds the upload queue
+    asset->m_Loader = this; 
+    m_Assets.emplace_back(asset); 
+    m_Stats.Requested++; 
+    m_Jobs.Dispatch(1, 1, LoadJob, static_cast<Asset*>(asset), m_LoadCounter); 
+    return asset; 
+}
+
+ShaderAsset* AssetLoader::LoadShader(const std::string& path)
+{
+    return Request<ShaderAsset>(path); 
+}
+
+VertexBufferAsset* AssetLoader::LoadVertexBuffer(const std::string& path)
+{
+    return Request<VertexBufferAsset>(path); 
+}
+
+IndexBufferAsset* AssetLoader::LoadIndexBuffer(const std::string& path)
+{
+    return Request<IndexBufferAsset>(path); 
+}
+
+void AssetLoader::LoadJob(void* context, unsigned int, unsigned int, unsigned int)
+{
+    Asset* asset = (Asset*)context; 
+    AssetLoader* loader = asset->m_Loader; 
+    if (!asset->Load())
+    { 
+        loader->Fail(asset); 
+        return; 
+    }
+
+    asset->m_State.store(AssetState::Uploading, std::memory_order_release); 
+    { 
+        std::lock_guard<std::mutex> lock(loader->m_Mutex); 
+        loader->m_UploadQueue.push_back(asset); 
+    }
+    loader->m_UploadReady.notify_one(); 
+}
+
+void AssetLoader::UploadLoop()
+{
+    m_UploadContext->MakeCurrent(); 
+
+    std::unique_lock<std::mutex> lock(m_Mutex); 
+    while (true)
+    { 
+        m_UploadReady.wait(lock, [this] { return !m_Running || !m_UploadQueue.empty(); }); 
+        if (!m_Running)
+            break; 
+
+        Asset* asset = m_UploadQueue.front(); 
+        m_UploadQueue.pop_front(); 
+        lock.unlock(); 
+
+        //GLState shadows the render thread's context, so uploads only use raw GL here
+        bool uploaded = m_UploadContext->IsValid() && asset->Upload(); 
+        if (uploaded)
+        { 
+            //the flush makes the fence visible to the render thread's context
+            GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0); 
+            GLCall(glFlush()); 
+            asset->m_Fence = fence; 
+        }
+
+        lock.lock(); 
+        if (uploaded)
+        { 
+            asset->m_State.store(AssetState::Finalizing, std::memory_order_release); 
+            m_FinalizeQueue.push_back(asset); 
+        }
+        else
+        { 
+            lock.unlock(); 
+            Fail(asset); 
+            lock.lock(); 
+        }
+    }
+    lock.unlock(); 
+
+    m_UploadContext->ReleaseCurrent(); 
+}
+
+void AssetLoader::Fail(Asset* asset)
+{
+    LOG_ERROR("Failed to load asset {}", asset->GetPath()); 
+    asset->m_State.store(AssetState::Failed, std::memory_order_release); 
+    m_Failed++; 
+}
+
+void AssetLoader::Update(double budgetMs)
+{
+    auto start = std::chrono::steady_clock::now(); 
+
+    while (true)
+    { 
+        Asset* asset; 
+        { 
+            std::lock_guard<std::mutex> lock(m_Mutex); 
+            if (m_FinalizeQueue.empty())
+                break; 
+            asset = m_FinalizeQueue.front(); 
+        }
+
+        //fences signal in submission order, so the first unsignalled one ends the pass
+        GLsync fence = (GLsync)asset->m_Fence; 
+        GLenum result = glClientWaitSync(fence, 0, 0); 
+        if (result == GL_TIMEOUT_EXPIRED)
+            break; 
+        { 
+            std::lock_guard<std::mutex> lock(m_Mutex); 
+            m_FinalizeQueue.pop_front(); 
+        }
+        GLCall(glDeleteSync(fence)); 
+        asset->m_Fence = nullptr; 
+
+        if (result != GL_WAIT_FAILED && asset->Finalize())
+        { 
+            asset->m_State.store(AssetState::Ready, std::memory_order_release); 
+            m_Stats.Ready++; 
+        }
+        else
+        { 
+            Fail(asset); 
+        }
+
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start; 
+        if (elapsed.count() >= budgetMs)
+            break; 
+    }
+}
+
+unsigned int AssetLoader::GetPendingCount() const
+{
+    unsigned int pending = 0; 
+    for (const auto& asset : m_Assets)
+    { 
+        AssetState state = asset->GetState(); 
+        if (state != AssetState::Ready && state != AssetState::Failed)
+            pending++; 
+    }
+    return pending; 
+}
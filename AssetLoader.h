@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Shader.h"
+#include "JobSystem.h"
+
+class Context; 
+class AssetLoader; 
+class VertexBuffer; 
+class IndexBuffer; 
+
+enum class AssetState { Loading, Uploading, Finalizing, Ready, Failed }; 
+
+//Something the AssetLoader brings in over three stages: Load() reads and
+//decodes it on a JobSystem worker, Upload() creates the GL objects on the
+//upload thread's shared context and Finalize() does the little work left
+//that has to happen on the render thread.
+class Asset
+{ 
+	friend class AssetLoader; 
+private: 
+	std::atomic<AssetState> m_State; 
+	AssetLoader* m_Loader; 
+	void* m_Fence; 
+protected: 
+	std::string m_Path; 
+
+	virtual bool Load() = 0; 
+	virtual bool Upload() = 0; 
+	virtual bool Finalize() { return true; }
+public: 
+	Asset(const std::string& path) : m_State(AssetState::Loading), m_Loader(nullptr), m_Fence(nullptr), m_Path(path) {}
+	virtual ~Asset() {}
+
+	//never blocks, the renderer skips or substitutes assets that are not ready
+	inline AssetState GetState() const { return m_State.load(std::memory_order_acquire); }
+	inline bool IsReady() const { return GetState() == AssetState::Ready; }
+	inline const std::string& GetPath() const { return m_Path; }
+}; 
+
+class ShaderAsset : public Asset
+{ 
+private: 
+	ShaderProgramSource m_Source; 
+	unsigned int m_Program; 
+	std::unique_ptr<Shader> m_Shader; 
+protected: 
+	bool Load() override; 
+	bool Upload() override; 
+	bool Finalize() override; 
+public: 
+	ShaderAsset(const std::string& path) : Asset(path), m_Program(0) {}
+	~ShaderAsset(); 
+	inline Shader* Get() const { return m_Shader.get(); }
+}; 
+
+//raw file contents as a vertex buffer
+class VertexBufferAsset : public Asset
+{ 
+private: 
+	std::vector<char> m_Data; 
+	unsigned int m_Buffer; 
+	std::unique_ptr<VertexBuffer> m_VertexBuffer; 
+protected: 
+	bool Load() override; 
+	bool Upload() override; 
+	bool Finalize() override; 
+public: 
+	VertexBufferAsset(const std::string& path); 
+	~VertexBufferAsset(); 
+	inline VertexBuffer* Get() const { return m_VertexBuffer.get(); }
+}; 
+
+//raw file of 32 bit indices as an index buffer, narrowed to 16 bit when they fit
+class IndexBufferAsset : public Asset
+{ 
+private: 
+	std::vector<char> m_Data; 
+	unsigned int m_Count; 
+	unsigned int m_Type; 
+	unsigned int m_Buffer; 
+	std::unique_ptr<IndexBuffer> m_IndexBuffer; 
+protected: 
+	bool Load() override; 
+	bool Upload() override; 
+	bool Finalize() override; 
+public: 
+	IndexBufferAsset(const std::string& path); 
+	~IndexBufferAsset(); 
+	inline IndexBuffer* Get() const { return m_IndexBuffer.get(); }
+}; 
+
+//Loads assets without ever blocking the render thread. File I/O and
+//decoding run on the JobSystem, GL uploads on a thread of its own with a
+//context shared with the main one. Each upload is followed by a fence, and
+//Update() finalizes only the assets whose fence has signalled, stopping once
+//the frame's time budget is used up, so a big load is spread over frames.
+class AssetLoader
+{ 
+public: 
+	struct Stats
+	{ 
+		unsigned int Requested = 0; 
+		unsigned int Ready = 0; 
+		unsigned int Failed = 0; 
+	}; 
+private: 
+	JobSystem& m_Jobs; 
+	JobCounter m_LoadCounter; 
+	Context* m_UploadContext; 
+	std::thread m_UploadThread; 
+
+	std::mutex m_Mutex; 
+	std::condition_variable m_UploadReady; 
+	std::deque<Asset*> m_UploadQueue; 
+	//uploaded and fenced, waiting for the render thread
+	std::deque<Asset*> m_FinalizeQueue; 
+	bool m_Running; 
+
+	std::vector<std::unique_ptr<Asset>> m_Assets; 
+	Stats m_Stats; 
+	//failures come from workers and the upload thread as well
+	std::atomic<unsigned int> m_Failed; 
+
+	template<typename T> T* Request(const std::string& path); 
+	static void LoadJob(void* context, unsigned int begin, unsigned int end, unsigned int worker); 
+	void UploadLoop(); 
+	void Fail(Asset* asset); 
+public: 
+	//needs the main context current on the calling thread
+	AssetLoader(Context& context, JobSystem& jobs); 
+	~AssetLoader(); 
+
+	AssetLoader(const AssetLoader&) = delete; 
+	AssetLoader& operator=(const AssetLoader&) = delete; 
+
+	ShaderAsset* LoadShader(const std::string& path); 
+	VertexBufferAsset* LoadVertexBuffer(const std::string& path); 
+	IndexBufferAsset* LoadIndexBuffer(const std::string& path); 
+
+	//render thread, once a frame; finalizes at least one finished asset
+	void Update(double budgetMs); 
+
+	unsigned int GetPendingCount() const; 
+	inline Stats GetStats() const { Stats stats = m_Stats; stats.Failed = m_Failed.load(); return stats; }
+}; 
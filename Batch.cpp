@@ -0,0 +1,124 @@
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+#include <string>
+#include <cmath>
+
+#include "Renderer.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "ShaderCache.h"
+#include "BatchRenderer.h"
+#include "GLState.h"
+#include "Context.h"
+
+using namespace std; 
+
+int main(void)
+{
+    GLFWwindow* window;
+
+    /* Initialize the library */
+    if (!glfwInit()){
+        cout << "FAILED TO INITIALIZE GLFW!" << endl; 
+        return -1;
+    }
+
+    //COMMANDS TO GET EVERYTHING RUNNING WITH MAC
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#if GL_CHECK_LEVEL != GL_CHECK_OFF
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+#endif
+    
+    /* Create a windowed mode window and its OpenGL context */
+    window = glfwCreateWindow(640, 480, "Batch", NULL, NULL);
+    if (!window)    
+    {
+        cout << "FAILED TO CREATE WINDOW!" << endl; 
+        glfwTerminate();
+        return -1;
+    }
+
+    /* Make the window's context current */
+    glfwMakeContextCurrent(window);
+
+    //no vsync, we want to see what the batcher can push
+    glfwSwapInterval(0);
+
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK)
+        cout << "FAILED TO INITIALIZE GLEW!" <<  endl; 
+    
+    //errors are reported by the driver callback when KHR_debug is there
+    GLInitDebugOutput(); 
+
+    //print open gl versions
+    cout << glGetString(GL_VERSION) << endl; 
+
+    {
+    ShaderCache shaderCache; 
+    unsigned int shader = shaderCache.Load("res/shaders/Batch.shader");
+    shaderCache.PrintStats(); 
+    BatchRenderer::SetupShader(shader); 
+
+    BatchRenderer batch; 
+
+    //grid of 400 x 250 = 100k quads covering the window
+    const int columns = 400; 
+    const int rows = 250; 
+    const float w = 2.0f / columns; 
+    const float h = 2.0f / rows; 
+
+    double lastReport = glfwGetTime(); 
+    unsigned int frames = 0; 
+    float t = 0.0f; 
+    /* Loop until the user closes the window */
+    while (!glfwWindowShouldClose(window))
+    {
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+        batch.BeginFrame(); 
+        GLState::ResetStats(); 
+        batch.Begin(); 
+        for (int y = 0; y < rows; y++)
+        { 
+            for (int x = 0; x < columns; x++)
+            { 
+                float color[4] = { (float)x / columns, (float)y / rows, 0.5f + 0.5f * sin(t), 1.0f }; 
+                batch.DrawQuad(-1.0f + x * w, -1.0f + y * h, w * 0.9f, h * 0.9f, color); 
+            }
+        }
+        batch.End(); 
+        t += 0.01f; 
+        frames++; 
+
+        double now = glfwGetTime(); 
+        if (now - lastReport >= 1.0)
+        { 
+            const BatchRenderer::Stats& stats = batch.GetStats(); 
+            cout << frames / (now - lastReport) << " fps, " << stats.QuadCount << " quads, "
+                 << stats.VertexCount << " vertices, " << stats.DrawCalls << " draw calls, "
+                 << stats.Flushes << " flushes, " << GLState::GetStats().Issued << " state changes issued, "
+                 << GLState::GetStats().Elided << " elided, "
+                 << stats.FenceWaitSeconds * 1000.0 << " ms waiting on fences" << endl; 
+            lastReport = now; 
+            frames = 0; 
+        }
+
+        /* Swap front and back buffers */
+        Context::SwapWindow(window); 
+
+        /* Poll for and process events */
+        glfwPollEvents();
+    }
+
+    GLState::DeleteProgram(shader); 
+    }
+    Context::Terminate(); 
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include "BatchRenderer.h"
+#include "Renderer.h"
+#include "GLState.h"
+#include "Profiler.h"
+
+#include <cstring>
+#include "VertexArray.h"
+#include "StreamBuffer.h"
+#include "IndexBuffer.h"
+
+static const float s_FullUV[4] = { 0.0f, 0.0f, 1.0f, 1.0f }; 
+
+BatchRenderer::BatchRenderer(unsigned int maxQuads)
+  : m_MaxQuads(maxQuads), m_QuadCount(0), m_TextureSlotCount(1)
+{
+    m_Vertices.resize(m_MaxQuads * 4); 
+
+    m_VertexArray = new VertexArray(); 
+    m_StreamBuffer = new StreamBuffer(GL_ARRAY_BUFFER, StreamBatches * m_MaxQuads * 4 * sizeof(QuadVertex)); 
+    m_VertexArray->AddBuffer<QuadVertex>(*m_StreamBuffer); 
+
+    //every quad uses the same 0,1,2 2,3,0 pattern, so the indices are generated once
+    std::vector<unsigned int> indices(m_MaxQuads * 6); 
+    unsigned int offset = 0; 
+    for (unsigned int i = 0; i < indices.size(); i += 6)
+    { 
+        indices[i + 0] = offset + 0; 
+        indices[i + 1] = offset + 1; 
+        indices[i + 2] = offset + 2; 
+
+        indices[i + 3] = offset + 2; 
+        indices[i + 4] = offset + 3; 
+        indices[i + 5] = offset + 0; 
+
+        offset += 4; 
+    }
+    m_IndexBuffer = new IndexBuffer(indices.data(), (unsigned int)indices.size()); 
+    m_VertexArray->SetIndexBuffer(*m_IndexBuffer); 
+
+    //slot 0 is a 1x1 white texture so solid quads can share a batch with textured ones
+    unsigned int white = 0xffffffff; 
+    GLCall(glGenTextures(1, &m_WhiteTexture));
+    GLState::BindTextureForEdit(0, GL_TEXTURE_2D, m_WhiteTexture);
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &white));
+
+    m_TextureSlots[0] = m_WhiteTexture; 
+    for (unsigned int i = 1; i < MaxTextureSlots; i++)
+        m_TextureSlots[i] = 0; 
+
+    m_VertexArray->Unbind(); 
+}
+
+BatchRenderer::~BatchRenderer()
+{
+    delete m_VertexArray; 
+    delete m_StreamBuffer; 
+    delete m_IndexBuffer; 
+    GLState::DeleteTexture(m_WhiteTexture); 
+}
+
+void BatchRenderer::SetupShader(unsigned int program, const char* samplerName)
+{
+    int samplers[MaxTextureSlots]; 
+    for (unsigned int i = 0; i < MaxTextureSlots; i++)
+        samplers[i] = i; 
+
+    GLState::UseProgram(program);
+    int location = glGetUniformLocation(program, samplerName); 
+    GLCall(glUniform1iv(location, MaxTextureSlots, samplers));
+}
+
+void BatchRenderer::BeginFrame()
+{
+    m_Stats = Stats(); 
+    m_StreamBuffer->ResetStats(); 
+}
+
+void BatchRenderer::Begin()
+{
+    m_QuadCount = 0; 
+    m_TextureSlotCount = 1; 
+}
+
+void BatchRenderer::End()
+{
+    Submit(); 
+    //the GPU is done with these vertices once it passes this point
+    m_StreamBuffer->EndFrame(); 
+}
+
+void BatchRenderer::Submit()
+{
+    if (m_QuadCount == 0)
+        return; 
+    PROFILE_SCOPE("BatchRenderer::Flush"); 
+
+    unsigned int size = m_QuadCount * 4 * sizeof(QuadVertex); 
+    unsigned int offset; 
+    void* vertices = m_StreamBuffer->Map(size, offset, sizeof(QuadVertex)); 
+    memcpy(vertices, m_Vertices.data(), size); 
+    m_StreamBuffer->Unmap(); 
+
+    for (unsigned int i = 0; i < m_TextureSlotCount; i++)
+    { 
+        GLState::BindTexture(i, GL_TEXTURE_2D, m_TextureSlots[i]);
+    }
+
+    //the index buffer is part of the VAO state
+    m_VertexArray->Bind(); 
+    //the batch starts wherever the stream buffer put it
+    GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, m_QuadCount * 6, m_IndexBuffer->GetType(), nullptr, offset / sizeof(QuadVertex)));
+
+    m_Stats.DrawCalls++; 
+    m_Stats.QuadCount += m_QuadCount; 
+    m_Stats.VertexCount += m_QuadCount * 4; 
+    m_Stats.IndexCount += m_QuadCount * 6; 
+    m_Stats.FenceWaitSeconds = m_StreamBuffer->GetStats().WaitSeconds; 
+
+    m_QuadCount = 0; 
+    m_TextureSlotCount = 1; 
+}
+
+float BatchRenderer::FindTextureSlot(unsigned int textureID)
+{
+    for (unsigned int i = 1; i < m_TextureSlotCount; i++)
+    { 
+        if (m_TextureSlots[i] == textureID)
+            return (float)i; 
+    }
+
+    if (m_TextureSlotCount == MaxTextureSlots)
+    { 
+        m_Stats.Flushes++; 
+        Submit(); 
+    }
+
+    m_TextureSlots[m_TextureSlotCount] = textureID; 
+    return (float)m_TextureSlotCount++; 
+}
+
+void BatchRenderer::PushQuad(float x, float y, float w, float h, const float color[4], float texIndex, const float uv[4])
+{
+    static const float corners[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } }; 
+
+    UNorm8x4 packed; 
+    for (int c = 0; c < 4; c++)
+    { 
+        float clamped = color[c] < 0.0f ? 0.0f : (color[c] > 1.0f ? 1.0f : color[c]); 
+        packed[c] = (unsigned char)(clamped * 255.0f + 0.5f); 
+    }
+
+    QuadVertex* v = &m_Vertices[m_QuadCount * 4]; 
+    for (int i = 0; i < 4; i++)
+    { 
+        v[i].Position[0] = x + corners[i][0] * w; 
+        v[i].Position[1] = y + corners[i][1] * h; 
+        v[i].Color = packed; 
+        v[i].TexCoord[0] = uv[0] + corners[i][0] * (uv[2] - uv[0]); 
+        v[i].TexCoord[1] = uv[1] + corners[i][1] * (uv[3] - uv[1]); 
+        v[i].TexIndex = texIndex; 
+    }
+    m_QuadCount++; 
+}
+
+void BatchRenderer::DrawQuad(float x, float y, float w, float h, const float color[4])
+{
+    if (m_QuadCount == m_MaxQuads)
+    { 
+        m_Stats.Flushes++; 
+        Submit(); 
+    }
+    PushQuad(x, y, w, h, color, 0.0f, s_FullUV); 
+}
+
+void BatchRenderer::DrawQuad(float x, float y, float w, float h, unsigned int textureID, const float tint[4])
+{
+    DrawQuad(x, y, w, h, textureID, s_FullUV, tint); 
+}
+
+void BatchRenderer::DrawQuad(float x, float y, float w, float h, unsigned int textureID, const float uv[4], const float tint[4])
+{
+    if (m_QuadCount == m_MaxQuads)
+    { 
+        m_Stats.Flushes++; 
+        Submit(); 
+    }
+    float texIndex = FindTextureSlot(textureID); 
+    PushQuad(x, y, w, h, tint, texIndex, uv); 
+}
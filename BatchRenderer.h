@@ -0,0 +1,80 @@
+#pragma once
+
+#include <vector>
+
+#include "VertexBufferLayout.h"
+
+class VertexArray; 
+class StreamBuffer; 
+class IndexBuffer; 
+
+//one vertex of a batched quad, 24 bytes with the color packed into bytes
+struct QuadVertex
+{ 
+	Float2 Position; 
+	UNorm8x4 Color; 
+	Float2 TexCoord; 
+	float TexIndex; 
+}; 
+
+template<> struct VertexFormat<QuadVertex> : VertexAttributes<Float2, UNorm8x4, Float2, float> {}; 
+
+//Collects quads into one dynamic vertex buffer and draws them with a shared,
+//pre-generated index pattern, so a whole batch costs a single glDrawElements.
+//The batch is flushed early only when it runs out of quads or texture slots.
+class BatchRenderer
+{ 
+public: 
+	static const unsigned int MaxTextureSlots = 8; 
+
+	struct Stats
+	{ 
+		unsigned int DrawCalls = 0; 
+		unsigned int QuadCount = 0; 
+		unsigned int VertexCount = 0; 
+		unsigned int IndexCount = 0; 
+		//batches submitted before End() because they ran out of room
+		unsigned int Flushes = 0; 
+		//time spent waiting for the GPU to release stream buffer space
+		double FenceWaitSeconds = 0.0; 
+	}; 
+
+	//the stream buffer holds this many full batches, enough for a few frames in flight
+	static const unsigned int StreamBatches = 8; 
+private: 
+	unsigned int m_MaxQuads; 
+	VertexArray* m_VertexArray; 
+	StreamBuffer* m_StreamBuffer; 
+	IndexBuffer* m_IndexBuffer; 
+
+	std::vector<QuadVertex> m_Vertices; 
+	unsigned int m_QuadCount; 
+
+	unsigned int m_WhiteTexture; 
+	unsigned int m_TextureSlots[MaxTextureSlots]; 
+	unsigned int m_TextureSlotCount; 
+
+	Stats m_Stats; 
+
+	float FindTextureSlot(unsigned int textureID); 
+	void PushQuad(float x, float y, float w, float h, const float color[4], float texIndex, const float uv[4]); 
+	void Submit(); 
+public: 
+	BatchRenderer(unsigned int maxQuads = 20000); 
+	~BatchRenderer(); 
+
+	//binds the sampler array of a program to the batch texture slots
+	static void SetupShader(unsigned int program, const char* samplerName = "u_Textures"); 
+
+	void BeginFrame(); 
+	void Begin(); 
+	void End(); 
+
+	void DrawQuad(float x, float y, float w, float h, const float color[4]); 
+	void DrawQuad(float x, float y, float w, float h, unsigned int textureID, const float tint[4]); 
+	//part of a texture, uv is u0, v0, u1, v1 as in an AtlasRegion
+	void DrawQuad(float x, float y, float w, float h, unsigned int textureID, const float uv[4], const float tint[4]); 
+
+	inline const Stats& GetStats() const { return m_Stats; }
+	inline unsigned int GetMaxQuads() const { return m_MaxQuads; }
+}; 
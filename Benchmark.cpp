@@ -0,0 +1,154 @@
+
+#include <GL/glew.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+
+#include "Renderer.h"
+#include "Context.h"
+#include "Scenes.h"
+#include "Profiler.h"
+
+using namespace std; 
+
+//Renders each scene for a fixed number of frames without vsync and prints
+//the frame times as JSON, e.g.
+//
+//  ./Benchmark --frames 1000 --scene Shapes > bench.json
+//
+//--trace file.json also records every frame with the Profiler and writes a
+//Chrome trace of it.
+//
+//Every frame ends with glFinish so the GPU (or llvmpipe) work is part of the
+//measured time instead of piling up in the driver queue.
+struct FrameTimes
+{ 
+    double Min, Median, P99, Max, Mean; 
+}; 
+
+static FrameTimes Summarize(vector<double> times)
+{
+    sort(times.begin(), times.end()); 
+    FrameTimes result; 
+    result.Min = times.front(); 
+    result.Max = times.back(); 
+    result.Median = times[times.size() / 2]; 
+    result.P99 = times[min(times.size() - 1, (size_t)(times.size() * 0.99))]; 
+    double sum = 0.0; 
+    for (double t : times)
+        sum += t; 
+    result.Mean = sum / times.size(); 
+    return result; 
+}
+
+int main(int argc, char** argv)
+{
+    int frames = 500; 
+    int warmup = 20; 
+    vector<string> scenes; 
+    const char* tracePath = nullptr; 
+    ContextOptions options; 
+    options.Title = "Benchmark"; 
+    options.SwapInterval = 0; 
+    options.Headless = true; 
+
+    for (int i = 1; i < argc; i++)
+    { 
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+            frames = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--warmup") && i + 1 < argc)
+            warmup = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--scene") && i + 1 < argc)
+            scenes.push_back(argv[++i]); 
+        else if (!strcmp(argv[i], "--trace") && i + 1 < argc)
+            tracePath = argv[++i]; 
+        else if (!strcmp(argv[i], "--windowed"))
+            options.Headless = false; 
+        else
+        { 
+            cerr << "usage: Benchmark [--frames n] [--warmup n] [--scene name]... [--trace file] [--windowed]" << endl; 
+            return -1; 
+        }
+    }
+    if (scenes.empty())
+        scenes = GetSceneNames(); 
+    if (frames < 1)
+        frames = 1; 
+
+    Context context(options); 
+    if (!context.IsValid())
+        return -1; 
+
+    if (tracePath)
+    { 
+        Profiler::SetEnabled(true); 
+        Profiler::StartCapture(); 
+    }
+
+    cout.setf(ios::fixed); 
+    cout.precision(4); 
+    cout << "{\n  \"renderer\": \"" << glGetString(GL_RENDERER) << "\",\n"
+         << "  \"version\": \"" << glGetString(GL_VERSION) << "\",\n"
+         << "  \"headless\": " << (context.IsHeadless() ? "true" : "false") << ",\n"
+         << "  \"frames\": " << frames << ",\n"
+         << "  \"scenes\": [";
+
+    int exitCode = 0; 
+    bool first = true; 
+    for (size_t s = 0; s < scenes.size(); s++)
+    { 
+        Scene* scene = CreateScene(scenes[s]); 
+        if (!scene)
+        { 
+            cerr << "unknown scene " << scenes[s] << endl; 
+            exitCode = -1; 
+            continue; 
+        }
+
+        vector<double> times; 
+        times.reserve(frames); 
+        for (int frame = 0; frame < warmup + frames; frame++)
+        { 
+            auto start = chrono::steady_clock::now(); 
+            Profiler::BeginFrame(); 
+            { 
+                PROFILE_SCOPE(scene->GetName()); 
+                scene->Render(); 
+            }
+            context.SwapBuffers(); 
+            Profiler::EndFrame(); 
+            GLCall(glFinish());
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(); 
+            if (frame >= warmup)
+                times.push_back(ms); 
+            context.PollEvents(); 
+        }
+        delete scene; 
+
+        FrameTimes t = Summarize(times); 
+        cout << (first ? "" : ",") << "\n    { \"name\": \"" << scenes[s] << "\", "
+             << "\"min_ms\": " << t.Min << ", \"median_ms\": " << t.Median << ", "
+             << "\"p99_ms\": " << t.P99 << ", \"max_ms\": " << t.Max << ", "
+             << "\"mean_ms\": " << t.Mean << " }";
+        first = false; 
+    }
+    cout << "\n  ]\n}" << endl; 
+
+    if (tracePath)
+    { 
+        //empty frames push the last real ones through the query pipeline
+        for (unsigned int i = 0; i < Profiler::FramesInFlight; i++)
+        { 
+            Profiler::BeginFrame(); 
+            Profiler::EndFrame(); 
+        }
+        if (!Profiler::WriteChromeTrace(tracePath))
+            cerr << "could not write " << tracePath << endl; 
+    }
+    return exitCode; 
+}
@@ -0,0 +1,259 @@
+#include "CommandList.h"
+#include "Renderer.h"
+#include "Shader.h"
+#include "VertexArray.h"
+#include "IndexBuffer.h"
+#include "Profiler.h"
+
+#include <chrono>
+#include <cstring>
+
+//every command starts with this, followed by its payload
+struct CommandHeader
+{ 
+    CommandList::Type Type; 
+    unsigned short Size; 
+}; 
+
+struct BindShaderCommand { Shader* Target; }; 
+struct BindVertexArrayCommand { const VertexArray* Target; }; 
+struct UniformCommand { Shader* Target; int Handle; float Value[16]; }; 
+struct DrawCommand { unsigned int IndexCount; unsigned int InstanceCount; unsigned int FirstIndex; int BaseVertex; }; 
+
+//keeps payloads aligned for the pointers and floats in them
+static const unsigned int CommandAlignment = alignof(void*); 
+
+static inline unsigned int AlignUp(unsigned int size)
+{
+    return (size + CommandAlignment - 1) / CommandAlignment * CommandAlignment; 
+}
+
+CommandList::CommandList(unsigned int capacity)
+  : m_Data(nullptr), m_Capacity(0), m_Reserve(capacity), m_Used(0), m_Count(0)
+{
+}
+
+void CommandList::Reset()
+{
+    m_Used = 0; 
+    m_Count = 0; 
+    if (m_Heap.size() < m_Reserve)
+        m_Heap.resize(m_Reserve); 
+    m_Data = m_Heap.data(); 
+    m_Capacity = (unsigned int)m_Heap.size(); 
+}
+
+void CommandList::Reset(LinearArena& arena)
+{
+    m_Used = 0; 
+    m_Count = 0; 
+    //only there because an earlier recording outgrew its block
+    if (!m_Heap.empty())
+        std::vector<unsigned char>().swap(m_Heap); 
+    m_Data = (unsigned char*)arena.Allocate(m_Reserve, CommandAlignment); 
+    m_Capacity = m_Reserve; 
+}
+
+void CommandList::Grow(unsigned int required)
+{
+    //only while warming up; lists record on the workers, which cannot take
+    //from the arena, so the heap holds the rest of this recording
+    unsigned int capacity = m_Capacity * 2 > required ? m_Capacity * 2 : required; 
+    if (capacity < m_Reserve)
+        capacity = m_Reserve; 
+    bool inArena = m_Data != m_Heap.data(); 
+    m_Heap.resize(capacity); 
+    if (inArena && m_Used)
+        memcpy(m_Heap.data(), m_Data, m_Used); 
+    m_Data = m_Heap.data(); 
+    m_Capacity = capacity; 
+    m_Reserve = capacity; 
+}
+
+void* CommandList::Allocate(Type type, unsigned int size)
+{
+    unsigned int total = AlignUp(sizeof(CommandHeader)) + AlignUp(size); 
+    if (m_Used + total > m_Capacity)
+        Grow(m_Used + total); 
+
+    CommandHeader* header = (CommandHeader*)&m_Data[m_Used]; 
+    header->Type = type; 
+    header->Size = (unsigned short)total; 
+    void* payload = &m_Data[m_Used + AlignUp(sizeof(CommandHeader))]; 
+    m_Used += total; 
+    m_Count++; 
+    return payload; 
+}
+
+void CommandList::BindShader(Shader* shader)
+{
+    ((BindShaderCommand*)Allocate(Type::BindShader, sizeof(BindShaderCommand)))->Target = shader; 
+}
+
+void CommandList::BindVertexArray(const VertexArray* va)
+{
+    ((BindVertexArrayCommand*)Allocate(Type::BindVertexArray, sizeof(BindVertexArrayCommand)))->Target = va; 
+}
+
+void CommandList::SetUniform1f(Shader* shader, int handle, float value)
+{
+    //uniform payloads only carry the floats they use
+    UniformCommand* command = (UniformCommand*)Allocate(Type::SetUniform1f, offsetof(UniformCommand, Value) + sizeof(float)); 
+    command->Target = shader; 
+    command->Handle = handle; 
+    command->Value[0] = value; 
+}
+
+void CommandList::SetUniform4f(Shader* shader, int handle, float v0, float v1, float v2, float v3)
+{
+    UniformCommand* command = (UniformCommand*)Allocate(Type::SetUniform4f, offsetof(UniformCommand, Value) + 4 * sizeof(float)); 
+    command->Target = shader; 
+    command->Handle = handle; 
+    command->Value[0] = v0; 
+    command->Value[1] = v1; 
+    command->Value[2] = v2; 
+    command->Value[3] = v3; 
+}
+
+void CommandList::SetUniformMat4f(Shader* shader, int handle, const float* matrix)
+{
+    UniformCommand* command = (UniformCommand*)Allocate(Type::SetUniformMat4f, sizeof(UniformCommand)); 
+    command->Target = shader; 
+    command->Handle = handle; 
+    memcpy(command->Value, matrix, 16 * sizeof(float)); 
+}
+
+void CommandList::DrawIndexed(unsigned int indexCount, unsigned int firstIndex, int baseVertex)
+{
+    DrawCommand* command = (DrawCommand*)Allocate(Type::DrawIndexed, sizeof(DrawCommand)); 
+    command->IndexCount = indexCount; 
+    command->InstanceCount = 1; 
+    command->FirstIndex = firstIndex; 
+    command->BaseVertex = baseVertex; 
+}
+
+void CommandList::DrawIndexedInstanced(unsigned int indexCount, unsigned int instanceCount, unsigned int firstIndex, int baseVertex)
+{
+    DrawCommand* command = (DrawCommand*)Allocate(Type::DrawIndexedInstanced, sizeof(DrawCommand)); 
+    command->IndexCount = indexCount; 
+    command->InstanceCount = instanceCount; 
+    command->FirstIndex = firstIndex; 
+    command->BaseVertex = baseVertex; 
+}
+
+void CommandList::Execute() const
+{
+    //draws take their index type from the vertex array bound before them
+    const VertexArray* vertexArray = nullptr; 
+    unsigned int offset = 0; 
+    while (offset < m_Used)
+    { 
+        const CommandHeader* header = (const CommandHeader*)&m_Data[offset]; 
+        const void* payload = &m_Data[offset + AlignUp(sizeof(CommandHeader))]; 
+        offset += header->Size; 
+
+        switch (header->Type)
+        { 
+            case Type::BindShader: 
+                ((const BindShaderCommand*)payload)->Target->Bind(); 
+                break; 
+            case Type::BindVertexArray: 
+                vertexArray = ((const BindVertexArrayCommand*)payload)->Target; 
+                vertexArray->Bind(); 
+                break; 
+            case Type::SetUniform1f: 
+            { 
+                const UniformCommand* command = (const UniformCommand*)payload; 
+                command->Target->SetUniform1f(command->Handle, command->Value[0]); 
+                break; 
+            }
+            case Type::SetUniform4f: 
+            { 
+                const UniformCommand* command = (const UniformCommand*)payload; 
+                command->Target->SetUniform4f(command->Handle, command->Value[0], command->Value[1], command->Value[2], command->Value[3]); 
+                break; 
+            }
+            case Type::SetUniformMat4f: 
+            { 
+                const UniformCommand* command = (const UniformCommand*)payload; 
+                command->Target->SetUniformMat4f(command->Handle, command->Value); 
+                break; 
+            }
+            case Type::DrawIndexed: 
+            case Type::DrawIndexedInstanced: 
+            { 
+                const DrawCommand* command = (const DrawCommand*)payload; 
+                ASSERT(vertexArray);
+                unsigned int type = vertexArray->GetIndexType(); 
+                const void* indices = (const void*)(size_t)(command->FirstIndex * IndexBuffer::SizeOf(type)); 
+                if (header->Type == Type::DrawIndexed)
+                    GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, command->IndexCount, type, indices, command->BaseVertex)); 
+                else
+                    GLCall(glDrawElementsInstancedBaseVertex(GL_TRIANGLES, command->IndexCount, type, indices,
+                        command->InstanceCount, command->BaseVertex)); 
+                break; 
+            }
+        }
+    }
+}
+
+ParallelRecorder::ParallelRecorder(JobSystem& jobs)
+  : m_Jobs(jobs), m_Arena(1, 1024 * 1024)
+{
+    for (FrameData& frame : m_Frames)
+    { 
+        frame.ListCount = 0; 
+        frame.Recording = false; 
+    }
+}
+
+void ParallelRecorder::RecordChunk(void* context, unsigned int begin, unsigned int end, unsigned int)
+{
+    FrameData& frame = *(FrameData*)context; 
+    frame.Function(frame.Context, begin, end, frame.Lists[begin / frame.ChunkSize]); 
+}
+
+void ParallelRecorder::BeginRecording(unsigned long long index, unsigned int count, unsigned int chunkSize, RecordFunction function, void* context)
+{
+    FrameData& frame = m_Frames[index % 2]; 
+    //the slot is reused every other frame, it must have been submitted by now
+    ASSERT(!frame.Recording);
+
+    frame.Function = function; 
+    frame.Context = context; 
+    frame.ChunkSize = chunkSize ? chunkSize : 1; 
+    frame.ListCount = (count + frame.ChunkSize - 1) / frame.ChunkSize; 
+    if (frame.Lists.size() < frame.ListCount)
+        frame.Lists.resize(frame.ListCount); 
+
+    //three frames of memory, the frame before this one is still to be submitted
+    m_Arena.BeginFrame(); 
+    for (unsigned int i = 0; i < frame.ListCount; i++)
+        frame.Lists[i].Reset(m_Arena.Get(0)); 
+    frame.Recording = true; 
+
+    m_Jobs.Dispatch(count, frame.ChunkSize, RecordChunk, &frame, frame.Counter); 
+}
+
+void ParallelRecorder::Submit(unsigned long long index)
+{
+    PROFILE_FUNCTION(); 
+    FrameData& frame = m_Frames[index % 2]; 
+    if (!frame.Recording)
+        return; 
+
+    auto start = std::chrono::steady_clock::now(); 
+    m_Jobs.Wait(frame.Counter); 
+    auto recorded = std::chrono::steady_clock::now(); 
+
+    m_Stats = Stats(); 
+    for (unsigned int i = 0; i < frame.ListCount; i++)
+    { 
+        frame.Lists[i].Execute(); 
+        m_Stats.Commands += frame.Lists[i].GetCommandCount(); 
+    }
+    m_Stats.Lists = frame.ListCount; 
+    m_Stats.WaitMs = std::chrono::duration<double, std::milli>(recorded - start).count(); 
+    m_Stats.ExecuteMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - recorded).count(); 
+    frame.Recording = false; 
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vector>
+
+#include "JobSystem.h"
+#include "FrameAllocator.h"
+
+class Shader; 
+class VertexArray; 
+
+//Plain-data render commands written into one linear buffer. Recording only
+//copies a few words and never touches GL, so any thread can fill a list;
+//Execute() replays it on the GL thread through Shader, VertexArray and the
+//state tracker. Reset() keeps the buffer, so a warmed-up list does not
+//allocate any more; Reset(arena) takes it from a LinearArena instead.
+class CommandList
+{ 
+public: 
+	enum class Type : unsigned char
+	{ 
+		BindShader, BindVertexArray, SetUniform1f, SetUniform4f, SetUniformMat4f, DrawIndexed, DrawIndexedInstanced
+	}; 
+private: 
+	//points into the arena or into m_Heap
+	unsigned char* m_Data; 
+	unsigned int m_Capacity; 
+	//most the list has needed, what the next Reset asks for
+	unsigned int m_Reserve; 
+	//without an arena, and when a recording outgrows its arena block
+	std::vector<unsigned char> m_Heap; 
+	unsigned int m_Used; 
+	unsigned int m_Count; 
+
+	void Grow(unsigned int required); 
+	void* Allocate(Type type, unsigned int size); 
+public: 
+	CommandList(unsigned int capacity = 64 * 1024); 
+
+	void Reset(); 
+	//the buffer comes from arena, as big as the list has ever needed; call it
+	//on the arena's thread, and do not reset the arena before Execute
+	void Reset(LinearArena& arena); 
+
+	void BindShader(Shader* shader); 
+	void BindVertexArray(const VertexArray* va); 
+	//handles come from Shader::GetUniform
+	void SetUniform1f(Shader* shader, int handle, float value); 
+	void SetUniform4f(Shader* shader, int handle, float v0, float v1, float v2, float v3); 
+	void SetUniformMat4f(Shader* shader, int handle, const float* matrix); 
+	//indexed draw from the bound vertex array and its index buffer
+	void DrawIndexed(unsigned int indexCount, unsigned int firstIndex = 0, int baseVertex = 0); 
+	void DrawIndexedInstanced(unsigned int indexCount, unsigned int instanceCount, unsigned int firstIndex = 0, int baseVertex = 0); 
+
+	//GL thread only
+	void Execute() const; 
+
+	inline unsigned int GetCommandCount() const { return m_Count; }
+	inline unsigned int GetSize() const { return m_Used; }
+}; 
+
+//Records a frame with the JobSystem while the GL thread replays the frame
+//before it. Objects [0, count) are split into chunks, each chunk records
+//into its own CommandList and the lists are replayed in chunk order, so the
+//result does not depend on which thread did what. Two frames of lists are
+//kept, which is what lets recording of frame N+1 overlap with submission of
+//frame N; the record function must therefore not read state that the
+//submission of the previous frame changes. The lists' buffers come from a
+//FrameArena, handed out on the dispatching thread before the workers start.
+class ParallelRecorder
+{ 
+public: 
+	typedef void (*RecordFunction)(void* context, unsigned int begin, unsigned int end, CommandList& list); 
+
+	struct Stats
+	{ 
+		unsigned int Commands = 0; 
+		unsigned int Lists = 0; 
+		//time the GL thread waited for recording to finish
+		double WaitMs = 0.0; 
+		double ExecuteMs = 0.0; 
+	}; 
+private: 
+	struct FrameData
+	{ 
+		std::vector<CommandList> Lists; 
+		JobCounter Counter; 
+		RecordFunction Function; 
+		void* Context; 
+		unsigned int ChunkSize; 
+		unsigned int ListCount; 
+		bool Recording; 
+	}; 
+
+	JobSystem& m_Jobs; 
+	FrameData m_Frames[2]; 
+	//one thread, only the dispatching thread takes from it
+	FrameArena m_Arena; 
+	Stats m_Stats; 
+
+	static void RecordChunk(void* context, unsigned int begin, unsigned int end, unsigned int worker); 
+public: 
+	ParallelRecorder(JobSystem& jobs); 
+
+	//starts recording in the background and returns right away
+	void BeginRecording(unsigned long long frame, unsigned int count, unsigned int chunkSize, RecordFunction function, void* context); 
+	//waits for the frame's recording and replays it, GL thread only
+	void Submit(unsigned long long frame); 
+
+	inline const Stats& GetStats() const { return m_Stats; }
+}; 
@@ -0,0 +1,210 @@
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "Renderer.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "ShaderCache.h"
+#include "VertexArray.h"
+#include "CommandList.h"
+#include "JobSystem.h"
+#include "Shader.h"
+#include "AllocationCounter.h"
+#include "Context.h"
+
+using namespace std; 
+
+struct Object
+{ 
+    float X, Y, Speed, Phase; 
+    float Color[4]; 
+}; 
+
+struct SceneData
+{ 
+    vector<Object>* Objects; 
+    Shader* ObjectShader; 
+    VertexArray* Quad; 
+    int Transform; 
+    int Color; 
+    float Time; 
+}; 
+
+//runs on the workers, only reads the objects and writes commands
+static void RecordObjects(void* context, unsigned int begin, unsigned int end, CommandList& list)
+{ 
+    //the recording threads count toward the frame's allocations like this one
+    AllocationCounter::TrackThread(); 
+    SceneData& scene = *(SceneData*)context; 
+    list.BindShader(scene.ObjectShader); 
+    list.BindVertexArray(scene.Quad); 
+    for (unsigned int i = begin; i < end; i++)
+    { 
+        const Object& object = (*scene.Objects)[i]; 
+        float t = scene.Time * object.Speed + object.Phase; 
+        float x = object.X + 0.02f * cos(t); 
+        float y = object.Y + 0.02f * sin(t); 
+        list.SetUniform4f(scene.ObjectShader, scene.Transform, x, y, 0.01f, t); 
+        list.SetUniform4f(scene.ObjectShader, scene.Color, object.Color[0], object.Color[1], object.Color[2], object.Color[3]); 
+        list.DrawIndexed(6); 
+    }
+}
+
+int main(int argc, char** argv)
+{
+    GLFWwindow* window;
+
+    /* Initialize the library */
+    if (!glfwInit()){
+        cout << "FAILED TO INITIALIZE GLFW!" << endl; 
+        return -1;
+    }
+
+    //COMMANDS TO GET EVERYTHING RUNNING WITH MAC
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#if GL_CHECK_LEVEL != GL_CHECK_OFF
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+#endif
+    
+    /* Create a windowed mode window and its OpenGL context */
+    window = glfwCreateWindow(640, 480, "Commands", NULL, NULL);
+    if (!window)    
+    {
+        cout << "FAILED TO CREATE WINDOW!" << endl; 
+        glfwTerminate();
+        return -1;
+    }
+
+    /* Make the window's context current */
+    glfwMakeContextCurrent(window);
+
+    //no vsync, we want to see what the recorder can push
+    glfwSwapInterval(0);
+
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK)
+        cout << "FAILED TO INITIALIZE GLEW!" <<  endl; 
+    
+    //errors are reported by the driver callback when KHR_debug is there
+    GLInitDebugOutput(); 
+
+    //print open gl versions
+    cout << glGetString(GL_VERSION) << endl; 
+
+    {
+    //./Commands [threads], 0 uses every core
+    JobSystem jobs(argc > 1 ? atoi(argv[1]) : 0); 
+    ParallelRecorder recorder(jobs); 
+
+    ShaderCache shaderCache; 
+    Shader shader(shaderCache.Load("res/shaders/Object.shader"));
+    shaderCache.PrintStats(); 
+
+    Float2 positions[] = { 
+       { -0.5f, -0.5f }, 
+       {  0.5f, -0.5f }, 
+       {  0.5f,  0.5f }, 
+       { -0.5f,  0.5f }, 
+    }; 
+    unsigned int indices[] = { 0, 1, 2, 2, 3, 0 };
+
+    VertexArray va; 
+    VertexBuffer vb(positions, sizeof(positions));
+    va.AddBuffer<Float2>(vb); 
+    IndexBuffer ib(indices, 6); 
+    va.SetIndexBuffer(ib); 
+
+    const unsigned int count = 20000; 
+    vector<Object> objects(count); 
+    for (unsigned int i = 0; i < count; i++)
+    { 
+        Object& object = objects[i]; 
+        object.X = rand() / (float)RAND_MAX * 2.0f - 1.0f; 
+        object.Y = rand() / (float)RAND_MAX * 2.0f - 1.0f; 
+        object.Speed = 0.5f + rand() / (float)RAND_MAX; 
+        object.Phase = rand() / (float)RAND_MAX * 6.28f; 
+        object.Color[0] = rand() / (float)RAND_MAX; 
+        object.Color[1] = rand() / (float)RAND_MAX; 
+        object.Color[2] = rand() / (float)RAND_MAX; 
+        object.Color[3] = 1.0f; 
+    }
+
+    //one per frame in flight, the recording of one frame must not see the next one's time
+    SceneData scenes[2]; 
+    for (SceneData& scene : scenes)
+    { 
+        scene.Objects = &objects; 
+        scene.ObjectShader = &shader; 
+        scene.Quad = &va; 
+        scene.Transform = shader.GetUniform("u_Transform"); 
+        scene.Color = shader.GetUniform("u_Color"); 
+        scene.Time = 0.0f; 
+    }
+
+    cout << jobs.GetThreadCount() << " recording threads" << endl; 
+
+    unsigned long long frame = 0; 
+    recorder.BeginRecording(frame, count, 256, RecordObjects, &scenes[0]); 
+
+    double lastReport = glfwGetTime(); 
+    unsigned int frames = 0; 
+    //command lists and the recorder's arena grow to their working set while
+    //every frame of the arena is used a few times, after that recording and
+    //submitting must not touch the heap
+    const unsigned long long warmupFrames = 4 * FrameArena::FramesInFlight; 
+    unsigned long long allocations = 0; 
+    //only this thread and the recording ones, the logger's writer allocates as it likes
+    AllocationCounter::TrackThread(); 
+    /* Loop until the user closes the window */
+    while (!glfwWindowShouldClose(window))
+    {
+        //workers record the next frame while this thread submits the current one
+        AllocationScope frameAllocations; 
+        SceneData& next = scenes[(frame + 1) % 2]; 
+        next.Time = (float)glfwGetTime(); 
+        recorder.BeginRecording(frame + 1, count, 256, RecordObjects, &next); 
+
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+        recorder.Submit(frame); 
+        if (frame >= warmupFrames)
+            ASSERT_NO_ALLOCATIONS(frameAllocations);
+        frame++; 
+        frames++; 
+        allocations += frameAllocations.GetCount(); 
+
+        double now = glfwGetTime(); 
+        if (now - lastReport >= 1.0)
+        { 
+            const ParallelRecorder::Stats& stats = recorder.GetStats(); 
+            cout << frames / (now - lastReport) << " fps, " << stats.Commands << " commands in " << stats.Lists
+                 << " lists, waited " << stats.WaitMs << " ms for recording, replay took " << stats.ExecuteMs << " ms"; 
+            if (AllocationCounter::IsEnabled())
+                cout << ", " << allocations << " heap allocations"; 
+            cout << endl; 
+            lastReport = now; 
+            frames = 0; 
+            allocations = 0; 
+        }
+
+        /* Swap front and back buffers */
+        Context::SwapWindow(window); 
+
+        /* Poll for and process events */
+        glfwPollEvents();
+    }
+    //the last frame is still being recorded and points at objects on this stack
+    recorder.Submit(frame); 
+    }
+    Context::Terminate(); 
+    return 0;
+}
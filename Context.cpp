@@ -0,0 +1,297 @@
+#include "Context.h"
+#include "Framebuffer.h"
+#include "Renderer.h"
+#include "ResourceManager.h"
+
+#include <GLFW/glfw3.h>
+#include <iostream>
+
+#ifdef HEADLESS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+Context::Context()
+  : m_Window(nullptr), m_EGLDisplay(nullptr), m_EGLContext(nullptr), m_EGLConfig(nullptr), m_Framebuffer(nullptr),
+    m_Headless(true), m_Valid(false), m_Shared(true), m_MinorVersion(1)
+{
+}
+
+Context::Context(const ContextOptions& options)
+  : m_Window(nullptr), m_EGLDisplay(nullptr), m_EGLContext(nullptr), m_EGLConfig(nullptr), m_Framebuffer(nullptr),
+    m_Headless(options.Headless), m_Valid(false), m_Shared(false), m_MinorVersion(options.MinorVersion)
+{
+    bool created = false; 
+    if (m_Headless)
+        created = CreateEGL(options); 
+    if (!created)
+        created = CreateGLFW(options); 
+    if (!created)
+        return; 
+
+    if (m_Headless)
+    { 
+        m_Framebuffer = new Framebuffer(options.Width, options.Height); 
+        if (!m_Framebuffer->IsComplete())
+            return; 
+        m_Framebuffer->Bind(); 
+    }
+
+    //errors are reported by the driver callback when KHR_debug is there
+    GLInitDebugOutput(); 
+    m_Valid = true; 
+}
+
+Context::~Context()
+{
+    //buffers and textures still alive are deleted with the context, not after it
+    if (!m_Shared)
+        ResourceManager::Shutdown(); 
+    delete m_Framebuffer; 
+
+#ifdef HEADLESS_EGL
+    if (m_EGLContext)
+    { 
+        if (eglGetCurrentContext() == (EGLContext)m_EGLContext)
+            eglMakeCurrent((EGLDisplay)m_EGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT); 
+        eglDestroyContext((EGLDisplay)m_EGLDisplay, (EGLContext)m_EGLContext); 
+        if (!m_Shared)
+            eglTerminate((EGLDisplay)m_EGLDisplay); 
+        return; 
+    }
+#endif
+    if (m_Shared)
+    { 
+        if (m_Window)
+            glfwDestroyWindow(m_Window); 
+        return; 
+    }
+    glfwTerminate(); 
+}
+
+Context* Context::CreateShared() const
+{
+    Context* shared = new Context(); 
+    shared->m_MinorVersion = m_MinorVersion; 
+
+#ifdef HEADLESS_EGL
+    if (m_EGLContext)
+    { 
+        const EGLint contextAttribs[] = { 
+            EGL_CONTEXT_MAJOR_VERSION, 4, 
+            EGL_CONTEXT_MINOR_VERSION, m_MinorVersion, 
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, 
+            EGL_NONE 
+        }; 
+        EGLContext context = eglCreateContext((EGLDisplay)m_EGLDisplay, (EGLConfig)m_EGLConfig, (EGLContext)m_EGLContext, contextAttribs); 
+        if (context != EGL_NO_CONTEXT)
+        { 
+            shared->m_EGLDisplay = m_EGLDisplay; 
+            shared->m_EGLConfig = m_EGLConfig; 
+            shared->m_EGLContext = context; 
+            shared->m_Valid = true; 
+        }
+        return shared; 
+    }
+#endif
+
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, m_MinorVersion);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    //glfwCreateWindow leaves our context current, the new one only shares objects with it
+    shared->m_Window = glfwCreateWindow(1, 1, "", NULL, m_Window); 
+    shared->m_Valid = shared->m_Window != nullptr; 
+    return shared; 
+}
+
+void Context::MakeCurrent() const
+{
+#ifdef HEADLESS_EGL
+    if (m_EGLContext)
+    { 
+        eglMakeCurrent((EGLDisplay)m_EGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, (EGLContext)m_EGLContext); 
+        GLSyncDebugOutput(); 
+        return; 
+    }
+#endif
+    glfwMakeContextCurrent(m_Window); 
+    GLSyncDebugOutput(); 
+}
+
+void Context::ReleaseCurrent() const
+{
+#ifdef HEADLESS_EGL
+    if (m_EGLContext)
+    { 
+        eglMakeCurrent((EGLDisplay)m_EGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT); 
+        return; 
+    }
+#endif
+    glfwMakeContextCurrent(NULL); 
+}
+
+bool Context::CreateEGL(const ContextOptions& options)
+{
+#ifdef HEADLESS_EGL
+    //surfaceless needs no window system at all, the default display is the fallback
+    EGLDisplay display = EGL_NO_DISPLAY; 
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT"); 
+    if (getPlatformDisplay)
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr); 
+    if (display == EGL_NO_DISPLAY)
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY); 
+
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr))
+    { 
+        cout << "FAILED TO INITIALIZE EGL!" << endl; 
+        return false; 
+    }
+
+    const EGLint configAttribs[] = { 
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, 
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, 
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8, 
+        EGL_NONE 
+    }; 
+    EGLConfig config; 
+    EGLint configCount = 0; 
+    eglBindAPI(EGL_OPENGL_API); 
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || configCount == 0)
+    { 
+        eglTerminate(display); 
+        return false; 
+    }
+
+    EGLint contextAttribs[] = { 
+        EGL_CONTEXT_MAJOR_VERSION, 4, 
+        EGL_CONTEXT_MINOR_VERSION, m_MinorVersion, 
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, 
+        EGL_NONE 
+    }; 
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs); 
+    if (context == EGL_NO_CONTEXT && m_MinorVersion > 1)
+    { 
+        m_MinorVersion = 1; 
+        contextAttribs[3] = 1; 
+        context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs); 
+    }
+    //rendering goes to our own framebuffer, so no surface is needed
+    if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+    { 
+        cout << "FAILED TO CREATE EGL CONTEXT!" << endl; 
+        if (context != EGL_NO_CONTEXT)
+            eglDestroyContext(display, context); 
+        eglTerminate(display); 
+        return false; 
+    }
+    m_EGLDisplay = display; 
+    m_EGLContext = context; 
+    m_EGLConfig = config; 
+
+    //glewInit insists on a GLX display, glewContextInit only loads the entry points
+    glewExperimental = GL_TRUE; 
+    if (glewContextInit() != GLEW_OK)
+        cout << "FAILED TO INITIALIZE GLEW!" <<  endl; 
+    return true; 
+#else
+    (void)options; 
+    return false; 
+#endif
+}
+
+bool Context::CreateGLFW(const ContextOptions& options)
+{
+    /* Initialize the library */
+    if (!glfwInit()){
+        cout << "FAILED TO INITIALIZE GLFW!" << endl; 
+        return false;
+    }
+
+    //COMMANDS TO GET EVERYTHING RUNNING WITH MAC
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, m_MinorVersion);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#if GL_CHECK_LEVEL != GL_CHECK_OFF
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+#endif
+    if (m_Headless)
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    m_Window = glfwCreateWindow(options.Width, options.Height, options.Title, NULL, NULL);
+    if (!m_Window && m_MinorVersion > 1)
+    { 
+        m_MinorVersion = 1; 
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+        m_Window = glfwCreateWindow(options.Width, options.Height, options.Title, NULL, NULL);
+    }
+    if (!m_Window)    
+    {
+        cout << "FAILED TO CREATE WINDOW!" << endl; 
+        glfwTerminate();
+        return false;
+    }
+
+    glfwMakeContextCurrent(m_Window);
+    SetSwapInterval(options.SwapInterval); 
+
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK)
+        cout << "FAILED TO INITIALIZE GLEW!" <<  endl; 
+    return true; 
+}
+
+bool Context::SetSwapInterval(int interval)
+{
+    if (!m_Window || m_Headless)
+        return false; 
+    if (interval < 0 && !glfwExtensionSupported("GLX_EXT_swap_control_tear") && !glfwExtensionSupported("WGL_EXT_swap_control_tear"))
+    { 
+        glfwSwapInterval(-interval); 
+        return false; 
+    }
+    glfwSwapInterval(interval); 
+    return true; 
+}
+
+bool Context::ShouldClose() const
+{
+    return m_Window && !m_Headless && !m_Shared && glfwWindowShouldClose(m_Window); 
+}
+
+void Context::SwapBuffers()
+{
+    if (m_Headless)
+        GLCall(glFlush());
+    else
+        glfwSwapBuffers(m_Window);
+    if (!m_Shared)
+        EndFrame(); 
+}
+
+void Context::EndFrame()
+{
+    ResourceManager::EndFrame(); 
+}
+
+void Context::SwapWindow(GLFWwindow* window)
+{
+    glfwSwapBuffers(window);
+    EndFrame(); 
+}
+
+void Context::Terminate()
+{
+    //the buffers and textures still alive go before the context does
+    ResourceManager::Shutdown(); 
+    glfwTerminate(); 
+}
+
+void Context::PollEvents()
+{
+    if (m_Window)
+        glfwPollEvents();
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+struct GLFWwindow; 
+class Framebuffer; 
+
+struct ContextOptions
+{ 
+	const char* Title = "OpenGL"; 
+	int Width = 640; 
+	int Height = 480; 
+	//0 renders unthrottled, 1 waits for vsync, -1 is adaptive vsync
+	int SwapInterval = 1; 
+	//no visible window, everything is drawn into an offscreen Framebuffer
+	bool Headless = false; 
+	//of 4.x, e.g. 3 for compute shaders and multi-draw indirect; drivers that
+	//stop below it (macOS stays at 4.1) get a 4.1 context instead
+	int MinorVersion = 1; 
+}; 
+
+//Creates the 4.x core context every program sets up by hand. Headless
+//contexts come from EGL on Mesa's surfaceless platform when built with
+//-DHEADLESS_EGL (works with llvmpipe and no display at all), otherwise from
+//an invisible GLFW window, which still needs a display server such as Xvfb.
+class Context
+{ 
+private: 
+	GLFWwindow* m_Window; 
+	void* m_EGLDisplay; 
+	void* m_EGLContext; 
+	void* m_EGLConfig; 
+	Framebuffer* m_Framebuffer; 
+	bool m_Headless; 
+	bool m_Valid; 
+	//created by CreateShared, owns neither GLFW nor the EGL display
+	bool m_Shared; 
+	//what was actually created, shared contexts ask for the same
+	int m_MinorVersion; 
+
+	Context(); 
+
+	bool CreateEGL(const ContextOptions& options); 
+	bool CreateGLFW(const ContextOptions& options); 
+	//what every frame ends with after the swap, whoever swaps
+	static void EndFrame(); 
+public: 
+	Context(const ContextOptions& options); 
+	~Context(); 
+
+	Context(const Context&) = delete; 
+	Context& operator=(const Context&) = delete; 
+
+	//a context sharing buffers, textures, programs and syncs with this one,
+	//for a loader thread; must be called on the thread that created this one
+	Context* CreateShared() const; 
+
+	//binds the context to the calling thread, a context is current on one thread at a time
+	void MakeCurrent() const; 
+	void ReleaseCurrent() const; 
+
+	//1 waits for vsync, -1 too unless the frame is already late, then it
+	//swaps at once and tears instead of waiting a whole refresh; false when
+	//that needs swap_control_tear and plain vsync is used, or when headless
+	bool SetSwapInterval(int interval); 
+
+	bool ShouldClose() const; 
+	//headless contexts have nothing to present, this only flushes; ends the
+	//ResourceManager's frame either way
+	void SwapBuffers(); 
+	void PollEvents(); 
+
+	//for loops that open their window with GLFW themselves instead of through
+	//a Context: swaps and ends the frame like SwapBuffers
+	static void SwapWindow(GLFWwindow* window); 
+	//what the destructor does for them, in place of glfwTerminate
+	static void Terminate(); 
+
+	inline bool IsValid() const { return m_Valid; }
+	inline bool IsHeadless() const { return m_Headless; }
+	inline int GetMinorVersion() const { return m_MinorVersion; }
+	//null unless the context came from GLFW
+	inline GLFWwindow* GetWindow() const { return m_Window; }
+	//null unless headless
+	inline Framebuffer* GetFramebuffer() const { return m_Framebuffer; }
+}; 
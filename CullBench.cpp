@@ -0,0 +1,109 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "Culling.h"
+#include "JobSystem.h"
+
+using namespace std; 
+
+//Measures cull throughput over 1M objects for every kernel the CPU has,
+//single threaded and on the JobSystem, and prints it as JSON, e.g.
+//
+//  ./CullBench --objects 1000000 --iterations 50 > cull.json
+//
+//The objects are small boxes scattered over a 2D map (and a 3D volume for
+//the frustum test) with the view covering a few percent of it, like a
+//camera over a large level. No GL context is needed.
+
+//time of one call in milliseconds, the best of the iterations
+template<typename F>
+static double Measure(int iterations, F function)
+{ 
+    double best = 1e30; 
+    for (int i = 0; i < iterations; i++)
+    { 
+        auto start = chrono::steady_clock::now(); 
+        function(); 
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(); 
+        if (ms < best)
+            best = ms; 
+    }
+    return best; 
+}
+
+static float Random(float range)
+{ 
+    return rand() / (float)RAND_MAX * range; 
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int objects = 1000000; 
+    int iterations = 50; 
+    unsigned int threads = 0; 
+    for (int i = 1; i < argc; i++)
+    { 
+        if (!strcmp(argv[i], "--objects") && i + 1 < argc)
+            objects = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--iterations") && i + 1 < argc)
+            iterations = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+            threads = atoi(argv[++i]); 
+    }
+
+    const float world = 1000.0f; 
+    srand(1); 
+    Culler culler; 
+    culler.Reserve(objects); 
+    for (unsigned int i = 0; i < objects; i++)
+    { 
+        float x = Random(world), y = Random(world), z = Random(world); 
+        float size = 0.5f + Random(2.0f); 
+        culler.Add(x, y, z, x + size, y + size, z + size); 
+    }
+    vector<unsigned int> visible(culler.GetPaddedCount()); 
+
+    //a 200 x 200 window on the map, about 4%
+    ViewRect view = { 400.0f, 400.0f, 600.0f, 600.0f }; 
+    //a box shaped frustum of about the same share, an orthographic projection
+    //of 400 < x,y < 600 and 0 < z < 1000 written as a column major matrix
+    float s = 2.0f / 200.0f, d = 2.0f / 1000.0f; 
+    const float ortho[16] = { 
+        s, 0.0f, 0.0f, 0.0f, 
+        0.0f, s, 0.0f, 0.0f, 
+        0.0f, 0.0f, d, 0.0f, 
+        -500.0f * s, -500.0f * s, -1.0f, 1.0f 
+    }; 
+    Frustum frustum = Frustum::FromMatrix(ortho); 
+
+    JobSystem jobs(threads); 
+    cout << "{\n  \"objects\": " << objects << ", \"threads\": " << jobs.GetThreadCount() << ",\n  \"results\": ["; 
+
+    bool first = true; 
+    Culler::Kernel best = Culler::DetectKernel(); 
+    for (int k = 0; k <= (int)best; k++)
+    { 
+        Culler::Kernel kernel = (Culler::Kernel)k; 
+        culler.SetKernel(kernel); 
+
+        unsigned int rectCount = 0, frustumCount = 0; 
+        double rect = Measure(iterations, [&] { rectCount = culler.Cull(view, visible.data()); }); 
+        double rectParallel = Measure(iterations, [&] { culler.Cull(view, visible.data(), jobs); }); 
+        double planes = Measure(iterations, [&] { frustumCount = culler.Cull(frustum, visible.data()); }); 
+        double planesParallel = Measure(iterations, [&] { culler.Cull(frustum, visible.data(), jobs); }); 
+
+        cout << (first ? "" : ",") << "\n    { \"kernel\": \"" << Culler::GetKernelName(kernel) << "\", "
+             << "\"rect_visible\": " << rectCount << ", "
+             << "\"rect_objects_per_ms\": " << objects / rect << ", "
+             << "\"rect_parallel_objects_per_ms\": " << objects / rectParallel << ", "
+             << "\"frustum_visible\": " << frustumCount << ", "
+             << "\"frustum_objects_per_ms\": " << objects / planes << ", "
+             << "\"frustum_parallel_objects_per_ms\": " << objects / planesParallel << " }"; 
+        first = false; 
+    }
+    cout << "\n  ]\n}" << endl; 
+    return 0;
+}
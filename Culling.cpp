@@ -0,0 +1,338 @@
+#include "Culling.h"
+#include "JobSystem.h"
+
+#include <cfloat>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CULLING_X86 1
+#include <immintrin.h>
+#else
+#define CULLING_X86 0
+#endif
+
+Frustum Frustum::FromMatrix(const float matrix[16])
+{
+    //each plane is the last row plus or minus one of the others
+    Frustum frustum; 
+    for (int i = 0; i < 3; i++)
+    { 
+        for (int j = 0; j < 4; j++)
+        { 
+            float row = matrix[j * 4 + i]; 
+            float last = matrix[j * 4 + 3]; 
+            frustum.Planes[i * 2 + 0][j] = last + row; 
+            frustum.Planes[i * 2 + 1][j] = last - row; 
+        }
+    }
+    return frustum; 
+}
+
+//per plane, the box corner furthest along its normal; if that one is
+//outside the whole box is
+struct PlaneTest
+{ 
+    float A, B, C, D; 
+    const float* X; 
+    const float* Y; 
+    const float* Z; 
+}; 
+
+static void PreparePlanes(const Frustum& frustum, const float* const minimum[3], const float* const maximum[3], PlaneTest planes[6])
+{ 
+    for (int p = 0; p < 6; p++)
+    { 
+        const float* plane = frustum.Planes[p]; 
+        planes[p].A = plane[0]; 
+        planes[p].B = plane[1]; 
+        planes[p].C = plane[2]; 
+        planes[p].D = plane[3]; 
+        planes[p].X = plane[0] >= 0.0f ? maximum[0] : minimum[0]; 
+        planes[p].Y = plane[1] >= 0.0f ? maximum[1] : minimum[1]; 
+        planes[p].Z = plane[2] >= 0.0f ? maximum[2] : minimum[2]; 
+    }
+}
+
+static unsigned int CullRectScalar(const float* minX, const float* minY, const float* maxX, const float* maxY,
+                                   const ViewRect& view, unsigned int begin, unsigned int end, unsigned int* visible)
+{ 
+    unsigned int count = 0; 
+    for (unsigned int i = begin; i < end; i++)
+    { 
+        //no branch on the test, the index is written either way and kept or not
+        visible[count] = i; 
+        count += (minX[i] <= view.MaxX) & (maxX[i] >= view.MinX) & (minY[i] <= view.MaxY) & (maxY[i] >= view.MinY); 
+    }
+    return count; 
+}
+
+static unsigned int CullFrustumScalar(const PlaneTest planes[6], unsigned int begin, unsigned int end, unsigned int* visible)
+{ 
+    unsigned int count = 0; 
+    for (unsigned int i = begin; i < end; i++)
+    { 
+        bool inside = true; 
+        for (int p = 0; p < 6; p++)
+        { 
+            const PlaneTest& plane = planes[p]; 
+            inside &= plane.A * plane.X[i] + plane.B * plane.Y[i] + plane.C * plane.Z[i] + plane.D >= 0.0f; 
+        }
+        visible[count] = i; 
+        count += inside; 
+    }
+    return count; 
+}
+
+#if CULLING_X86
+//turns a lane mask into indices, lowest lane first
+static inline unsigned int EmitMask(unsigned int mask, unsigned int base, unsigned int* visible)
+{ 
+    unsigned int count = 0; 
+    while (mask)
+    { 
+        visible[count++] = base + __builtin_ctz(mask); 
+        mask &= mask - 1; 
+    }
+    return count; 
+}
+
+static unsigned int CullRectSSE(const float* minX, const float* minY, const float* maxX, const float* maxY,
+                                const ViewRect& view, unsigned int begin, unsigned int end, unsigned int* visible)
+{ 
+    __m128 viewMinX = _mm_set1_ps(view.MinX); 
+    __m128 viewMinY = _mm_set1_ps(view.MinY); 
+    __m128 viewMaxX = _mm_set1_ps(view.MaxX); 
+    __m128 viewMaxY = _mm_set1_ps(view.MaxY); 
+
+    unsigned int count = 0; 
+    for (unsigned int i = begin; i < end; i += 4)
+    { 
+        __m128 inside = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minX + i), viewMaxX), _mm_cmpge_ps(_mm_loadu_ps(maxX + i), viewMinX)); 
+        inside = _mm_and_ps(inside, _mm_cmple_ps(_mm_loadu_ps(minY + i), viewMaxY)); 
+        inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_loadu_ps(maxY + i), viewMinY)); 
+        count += EmitMask(_mm_movemask_ps(inside), i, visible + count); 
+    }
+    return count; 
+}
+
+static unsigned int CullFrustumSSE(const PlaneTest planes[6], unsigned int begin, unsigned int end, unsigned int* visible)
+{ 
+    unsigned int count = 0; 
+    for (unsigned int i = begin; i < end; i += 4)
+    { 
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1)); 
+        for (int p = 0; p < 6; p++)
+        { 
+            const PlaneTest& plane = planes[p]; 
+            __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.A), _mm_loadu_ps(plane.X + i)), _mm_set1_ps(plane.D)); 
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.B), _mm_loadu_ps(plane.Y + i))); 
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.C), _mm_loadu_ps(plane.Z + i))); 
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps())); 
+        }
+        count += EmitMask(_mm_movemask_ps(inside), i, visible + count); 
+    }
+    return count; 
+}
+
+//compiled for AVX2 whatever the rest of the build targets, only called when the CPU has it
+__attribute__((target("avx2")))
+static unsigned int CullRectAVX2(const float* minX, const float* minY, const float* maxX, const float* maxY,
+                                 const ViewRect& view, unsigned int begin, unsigned int end, unsigned int* visible)
+{ 
+    __m256 viewMinX = _mm256_set1_ps(view.MinX); 
+    __m256 viewMinY = _mm256_set1_ps(view.MinY); 
+    __m256 viewMaxX = _mm256_set1_ps(view.MaxX); 
+    __m256 viewMaxY = _mm256_set1_ps(view.MaxY); 
+
+    unsigned int count = 0; 
+    for (unsigned int i = begin; i < end; i += 8)
+    { 
+        __m256 inside = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(minX + i), viewMaxX, _CMP_LE_OQ), 
+                                      _mm256_cmp_ps(_mm256_loadu_ps(maxX + i), viewMinX, _CMP_GE_OQ)); 
+        inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_loadu_ps(minY + i), viewMaxY, _CMP_LE_OQ)); 
+        inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_loadu_ps(maxY + i), viewMinY, _CMP_GE_OQ)); 
+        count += EmitMask(_mm256_movemask_ps(inside), i, visible + count); 
+    }
+    return count; 
+}
+
+__attribute__((target("avx2")))
+static unsigned int CullFrustumAVX2(const PlaneTest planes[6], unsigned int begin, unsigned int end, unsigned int* visible)
+{ 
+    unsigned int count = 0; 
+    for (unsigned int i = begin; i < end; i += 8)
+    { 
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1)); 
+        for (int p = 0; p < 6; p++)
+        { 
+            const PlaneTest& plane = planes[p]; 
+            //no FMA, so boxes right on a plane come out the same as with the other kernels
+            __m256 distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.A), _mm256_loadu_ps(plane.X + i)), _mm256_set1_ps(plane.D)); 
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.B), _mm256_loadu_ps(plane.Y + i))); 
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.C), _mm256_loadu_ps(plane.Z + i))); 
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ)); 
+        }
+        count += EmitMask(_mm256_movemask_ps(inside), i, visible + count); 
+    }
+    return count; 
+}
+#endif
+
+Culler::Culler()
+  : m_Count(0), m_Kernel(DetectKernel())
+{
+}
+
+Culler::Kernel Culler::DetectKernel()
+{
+#if CULLING_X86
+    if (__builtin_cpu_supports("avx2"))
+        return Kernel::AVX2; 
+    if (__builtin_cpu_supports("sse2"))
+        return Kernel::SSE; 
+#endif
+    return Kernel::Scalar; 
+}
+
+const char* Culler::GetKernelName(Kernel kernel)
+{
+    switch (kernel)
+    { 
+        case Kernel::AVX2:  return "AVX2"; 
+        case Kernel::SSE:   return "SSE"; 
+        default:            return "Scalar"; 
+    }
+}
+
+void Culler::SetKernel(Kernel kernel)
+{
+    Kernel best = DetectKernel(); 
+    m_Kernel = kernel > best ? best : kernel; 
+}
+
+void Culler::Reserve(unsigned int count)
+{
+    unsigned int padded = (count + Width - 1) / Width * Width; 
+    for (std::vector<float>* array : { &m_MinX, &m_MinY, &m_MinZ, &m_MaxX, &m_MaxY, &m_MaxZ })
+        array->reserve(padded); 
+}
+
+void Culler::Clear()
+{
+    for (std::vector<float>* array : { &m_MinX, &m_MinY, &m_MinZ, &m_MaxX, &m_MaxY, &m_MaxZ })
+        array->clear(); 
+    m_Count = 0; 
+}
+
+unsigned int Culler::Add(float minX, float minY, float maxX, float maxY)
+{
+    return Add(minX, minY, 0.0f, maxX, maxY, 0.0f); 
+}
+
+unsigned int Culler::Add(float minX, float minY, float minZ, float maxX, float maxY, float maxZ)
+{
+    if (m_Count == m_MinX.size())
+    { 
+        //inside out boxes at the far end of every axis, no view or plane ever keeps them
+        for (std::vector<float>* array : { &m_MinX, &m_MinY, &m_MinZ })
+            array->resize(m_Count + Width, FLT_MAX); 
+        for (std::vector<float>* array : { &m_MaxX, &m_MaxY, &m_MaxZ })
+            array->resize(m_Count + Width, -FLT_MAX); 
+    }
+    Set(m_Count, minX, minY, minZ, maxX, maxY, maxZ); 
+    return m_Count++; 
+}
+
+void Culler::Set(unsigned int index, float minX, float minY, float maxX, float maxY)
+{
+    Set(index, minX, minY, 0.0f, maxX, maxY, 0.0f); 
+}
+
+void Culler::Set(unsigned int index, float minX, float minY, float minZ, float maxX, float maxY, float maxZ)
+{
+    m_MinX[index] = minX; 
+    m_MinY[index] = minY; 
+    m_MinZ[index] = minZ; 
+    m_MaxX[index] = maxX; 
+    m_MaxY[index] = maxY; 
+    m_MaxZ[index] = maxZ; 
+}
+
+unsigned int Culler::CullRange(const ViewRect& view, unsigned int begin, unsigned int end, unsigned int* visible) const
+{
+    const float* minX = m_MinX.data(); 
+    const float* minY = m_MinY.data(); 
+    const float* maxX = m_MaxX.data(); 
+    const float* maxY = m_MaxY.data(); 
+    switch (m_Kernel)
+    { 
+#if CULLING_X86
+        case Kernel::AVX2:  return CullRectAVX2(minX, minY, maxX, maxY, view, begin, end, visible); 
+        case Kernel::SSE:   return CullRectSSE(minX, minY, maxX, maxY, view, begin, end, visible); 
+#endif
+        default:            return CullRectScalar(minX, minY, maxX, maxY, view, begin, end, visible); 
+    }
+}
+
+unsigned int Culler::CullRange(const Frustum& frustum, unsigned int begin, unsigned int end, unsigned int* visible) const
+{
+    const float* const minimum[3] = { m_MinX.data(), m_MinY.data(), m_MinZ.data() }; 
+    const float* const maximum[3] = { m_MaxX.data(), m_MaxY.data(), m_MaxZ.data() }; 
+    PlaneTest planes[6]; 
+    PreparePlanes(frustum, minimum, maximum, planes); 
+    switch (m_Kernel)
+    { 
+#if CULLING_X86
+        case Kernel::AVX2:  return CullFrustumAVX2(planes, begin, end, visible); 
+        case Kernel::SSE:   return CullFrustumSSE(planes, begin, end, visible); 
+#endif
+        default:            return CullFrustumScalar(planes, begin, end, visible); 
+    }
+}
+
+unsigned int Culler::Cull(const ViewRect& view, unsigned int* visible) const
+{
+    //the padding fails the test, so the kernels can run over it
+    return CullRange(view, 0, (unsigned int)m_MinX.size(), visible); 
+}
+
+unsigned int Culler::Cull(const Frustum& frustum, unsigned int* visible) const
+{
+    return CullRange(frustum, 0, (unsigned int)m_MinX.size(), visible); 
+}
+
+template<typename Volume>
+unsigned int Culler::CullParallel(const Volume& volume, unsigned int* visible, JobSystem& jobs) const
+{
+    unsigned int size = (unsigned int)m_MinX.size(); 
+    unsigned int chunks = (size + ChunkSize - 1) / ChunkSize; 
+    m_ChunkCounts.resize(chunks); 
+
+    //each chunk writes its indices where its own objects start, so they never collide
+    auto cull = [&](unsigned int begin, unsigned int end, unsigned int)
+    { 
+        m_ChunkCounts[begin / ChunkSize] = CullRange(volume, begin, end, visible + begin); 
+    }; 
+    JobCounter counter; 
+    jobs.ParallelFor(size, ChunkSize, cull, counter); 
+    jobs.Wait(counter); 
+
+    //then they are slid down into one list, which only ever moves them toward the front
+    unsigned int count = m_ChunkCounts.empty() ? 0 : m_ChunkCounts[0]; 
+    for (unsigned int chunk = 1; chunk < chunks; chunk++)
+    { 
+        memmove(visible + count, visible + chunk * ChunkSize, m_ChunkCounts[chunk] * sizeof(unsigned int)); 
+        count += m_ChunkCounts[chunk]; 
+    }
+    return count; 
+}
+
+unsigned int Culler::Cull(const ViewRect& view, unsigned int* visible, JobSystem& jobs) const
+{
+    return CullParallel(view, visible, jobs); 
+}
+
+unsigned int Culler::Cull(const Frustum& frustum, unsigned int* visible, JobSystem& jobs) const
+{
+    return CullParallel(frustum, visible, jobs); 
+}
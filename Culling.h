@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+
+class JobSystem; 
+
+//visible area of a 2D scene in world units
+struct ViewRect
+{ 
+	float MinX, MinY; 
+	float MaxX, MaxY; 
+}; 
+
+//planes as a, b, c, d with the inside where ax + by + cz + d >= 0
+struct Frustum
+{ 
+	float Planes[6][4]; 
+
+	//from a column major view projection matrix, as uploaded with glUniformMatrix4fv
+	static Frustum FromMatrix(const float matrix[16]); 
+}; 
+
+//Bounding boxes of every object in SoA layout, one array per coordinate, so
+//the tests run over 4 (SSE) or 8 (AVX2) objects per instruction and emit the
+//indices of the visible ones as a compact list for the renderer to walk.
+//The kernel is picked from what the CPU supports at startup; other
+//architectures and old CPUs use the scalar one. Arrays are padded to a
+//multiple of Width with boxes that fail every test, so there are no tails.
+class Culler
+{ 
+public: 
+	enum class Kernel { Scalar, SSE, AVX2 }; 
+
+	static const unsigned int Width = 8; 
+	//objects per job when culling in parallel, a multiple of Width
+	static const unsigned int ChunkSize = 16384; 
+private: 
+	std::vector<float> m_MinX, m_MinY, m_MinZ; 
+	std::vector<float> m_MaxX, m_MaxY, m_MaxZ; 
+	unsigned int m_Count; 
+	Kernel m_Kernel; 
+	mutable std::vector<unsigned int> m_ChunkCounts; 
+
+	unsigned int CullRange(const ViewRect& view, unsigned int begin, unsigned int end, unsigned int* visible) const; 
+	unsigned int CullRange(const Frustum& frustum, unsigned int begin, unsigned int end, unsigned int* visible) const; 
+	template<typename Volume>
+	unsigned int CullParallel(const Volume& volume, unsigned int* visible, JobSystem& jobs) const; 
+public: 
+	Culler(); 
+
+	static Kernel DetectKernel(); 
+	static const char* GetKernelName(Kernel kernel); 
+	//falls back to what the CPU has when asked for more
+	void SetKernel(Kernel kernel); 
+	inline Kernel GetKernel() const { return m_Kernel; }
+
+	void Reserve(unsigned int count); 
+	void Clear(); 
+	//2D boxes are flat at z = 0, returns the object's index
+	unsigned int Add(float minX, float minY, float maxX, float maxY); 
+	unsigned int Add(float minX, float minY, float minZ, float maxX, float maxY, float maxZ); 
+	void Set(unsigned int index, float minX, float minY, float maxX, float maxY); 
+	void Set(unsigned int index, float minX, float minY, float minZ, float maxX, float maxY, float maxZ); 
+
+	//writes the indices of the objects touching the view in increasing order
+	//and returns how many; visible needs room for GetPaddedCount() indices
+	unsigned int Cull(const ViewRect& view, unsigned int* visible) const; 
+	unsigned int Cull(const Frustum& frustum, unsigned int* visible) const; 
+	//the same, in chunks on the job system; the order stays the same
+	unsigned int Cull(const ViewRect& view, unsigned int* visible, JobSystem& jobs) const; 
+	unsigned int Cull(const Frustum& frustum, unsigned int* visible, JobSystem& jobs) const; 
+
+	inline unsigned int GetCount() const { return m_Count; }
+	inline unsigned int GetPaddedCount() const { return (unsigned int)m_MinX.size(); }
+}; 
@@ -0,0 +1,154 @@
+#include "FrameAllocator.h"
+
+#include <cstdint>
+#include <new>
+
+//growth goes through the global operator new rather than malloc, so an
+//AllocationCounter sees arenas and pools that are still warming up
+static inline char* HeapAllocate(size_t size, size_t alignment = alignof(std::max_align_t))
+{
+    if (alignment <= alignof(std::max_align_t))
+        return (char*)::operator new(size); 
+    return (char*)::operator new(size, std::align_val_t(alignment)); 
+}
+
+static inline void HeapFree(char* memory, size_t alignment = alignof(std::max_align_t))
+{
+    if (alignment <= alignof(std::max_align_t))
+        ::operator delete(memory); 
+    else
+        ::operator delete(memory, std::align_val_t(alignment)); 
+}
+
+static inline size_t AlignUp(size_t value, size_t alignment)
+{ 
+    return (value + alignment - 1) & ~(alignment - 1); 
+}
+
+LinearArena::LinearArena(size_t capacity)
+  : m_Capacity(capacity), m_Offset(0), m_OverflowSize(0), m_Peak(0)
+{
+    m_Memory = HeapAllocate(m_Capacity); 
+    m_Overflow.reserve(16); 
+}
+
+LinearArena::~LinearArena()
+{
+    for (char* block : m_Overflow)
+        HeapFree(block); 
+    HeapFree(m_Memory); 
+}
+
+void* LinearArena::Allocate(size_t size, size_t alignment)
+{
+    size_t offset = AlignUp((uintptr_t)m_Memory + m_Offset, alignment) - (uintptr_t)m_Memory; 
+    if (offset + size <= m_Capacity)
+    { 
+        m_Offset = offset + size; 
+        return m_Memory + offset; 
+    }
+
+    //a block of its own, given back at Reset
+    char* block = HeapAllocate(size + alignment); 
+    m_Overflow.push_back(block); 
+    m_OverflowSize += size + alignment; 
+    return (void*)AlignUp((uintptr_t)block, alignment); 
+}
+
+void LinearArena::Reset()
+{
+    size_t used = GetUsed(); 
+    if (used > m_Peak)
+        m_Peak = used; 
+
+    if (!m_Overflow.empty())
+    { 
+        for (char* block : m_Overflow)
+            HeapFree(block); 
+        m_Overflow.clear(); 
+
+        //room for the peak and a little more, the next frames fit in one block
+        HeapFree(m_Memory); 
+        m_Capacity = AlignUp(m_Peak + m_Peak / 4, 4096); 
+        m_Memory = HeapAllocate(m_Capacity); 
+    }
+    m_Offset = 0; 
+    m_OverflowSize = 0; 
+}
+
+FrameArena::FrameArena(unsigned int threads, size_t bytesPerThread)
+  : m_Threads(threads), m_Frame(0)
+{
+    for (unsigned int i = 0; i < FramesInFlight * m_Threads; i++)
+        m_Arenas.push_back(new LinearArena(bytesPerThread)); 
+}
+
+FrameArena::~FrameArena()
+{
+    for (LinearArena* arena : m_Arenas)
+        delete arena; 
+}
+
+void FrameArena::BeginFrame()
+{
+    m_Frame = (m_Frame + 1) % FramesInFlight; 
+    for (unsigned int thread = 0; thread < m_Threads; thread++)
+        Get(thread).Reset(); 
+}
+
+size_t FrameArena::GetUsed() const
+{
+    size_t used = 0; 
+    for (unsigned int thread = 0; thread < m_Threads; thread++)
+        used += m_Arenas[m_Frame * m_Threads + thread]->GetUsed(); 
+    return used; 
+}
+
+PoolAllocator::PoolAllocator(size_t blockSize, size_t alignment, unsigned int blocksPerChunk)
+  : m_BlocksPerChunk(blocksPerChunk), m_FreeList(nullptr), m_Live(0)
+{
+    //a free block holds the free list link
+    if (blockSize < sizeof(void*))
+        blockSize = sizeof(void*); 
+    if (alignment < alignof(void*))
+        alignment = alignof(void*); 
+    m_Alignment = alignment; 
+    m_BlockSize = AlignUp(blockSize, alignment); 
+}
+
+PoolAllocator::~PoolAllocator()
+{
+    for (char* chunk : m_Chunks)
+        HeapFree(chunk, m_Alignment); 
+}
+
+void PoolAllocator::Grow()
+{
+    //block sizes are multiples of the alignment, so an aligned chunk aligns every block
+    char* chunk = HeapAllocate(m_BlockSize * m_BlocksPerChunk, m_Alignment); 
+    m_Chunks.push_back(chunk); 
+    //linked back to front so blocks are handed out in address order
+    for (unsigned int i = m_BlocksPerChunk; i-- > 0; )
+    { 
+        void* block = chunk + i * m_BlockSize; 
+        *(void**)block = m_FreeList; 
+        m_FreeList = block; 
+    }
+}
+
+void* PoolAllocator::Allocate()
+{
+    if (!m_FreeList)
+        Grow(); 
+    void* block = m_FreeList; 
+    m_FreeList = *(void**)block; 
+    m_Live++; 
+    return block; 
+}
+
+void PoolAllocator::Free(void* block)
+{
+    *(void**)block = m_FreeList; 
+    m_FreeList = block; 
+    m_Live--; 
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+//Bump allocator over one block. Allocating moves an offset, freeing happens
+//all at once in Reset(). When a frame needs more than the block holds the
+//rest comes from extra heap blocks, and the next Reset() grows the block to
+//the peak, so after a few frames of warm up it never touches the heap again.
+class LinearArena
+{ 
+private: 
+	char* m_Memory; 
+	size_t m_Capacity; 
+	size_t m_Offset; 
+	//what did not fit since the last Reset
+	std::vector<char*> m_Overflow; 
+	size_t m_OverflowSize; 
+	size_t m_Peak; 
+public: 
+	LinearArena(size_t capacity); 
+	~LinearArena(); 
+
+	LinearArena(const LinearArena&) = delete; 
+	LinearArena& operator=(const LinearArena&) = delete; 
+
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)); 
+	//frees everything, whatever was built in the arena is not destroyed
+	void Reset(); 
+
+	template<typename T>
+	T* AllocateArray(size_t count) { return (T*)Allocate(count * sizeof(T), alignof(T)); }
+
+	inline size_t GetUsed() const { return m_Offset + m_OverflowSize; }
+	inline size_t GetCapacity() const { return m_Capacity; }
+	//most used in one frame so far
+	inline size_t GetPeak() const { return m_Peak; }
+}; 
+
+//Linear arenas for data that lives for one frame: one per thread, so
+//threads never contend, and one set per frame in flight, so what frame N
+//allocated stays valid while its command lists are replayed and frame N+1
+//is recorded. Thread indices are JobSystem worker indices, the dispatching
+//thread being GetThreadCount() - 1.
+class FrameArena
+{ 
+public: 
+	static const unsigned int FramesInFlight = 3; 
+private: 
+	std::vector<LinearArena*> m_Arenas; 
+	unsigned int m_Threads; 
+	unsigned int m_Frame; 
+public: 
+	FrameArena(unsigned int threads, size_t bytesPerThread = 256 * 1024); 
+	~FrameArena(); 
+
+	FrameArena(const FrameArena&) = delete; 
+	FrameArena& operator=(const FrameArena&) = delete; 
+
+	//moves on to the memory of the oldest frame and resets it, call once a
+	//frame before anything allocates
+	void BeginFrame(); 
+
+	inline LinearArena& Get(unsigned int thread) { return *m_Arenas[m_Frame * m_Threads + thread]; }
+	inline void* Allocate(size_t size, size_t alignment, unsigned int thread) { return Get(thread).Allocate(size, alignment); }
+
+	inline unsigned int GetThreadCount() const { return m_Threads; }
+	//over every thread of the current frame
+	size_t GetUsed() const; 
+}; 
+
+//Lets STL containers allocate from a LinearArena, e.g.
+//
+//  std::vector<int, ArenaAllocator<int>> visible(ArenaAllocator<int>(arena.Get(thread)));
+//
+//deallocate does nothing, so memory a growing container leaves behind is
+//only reclaimed at Reset; reserve up front where the size is known.
+template<typename T>
+class ArenaAllocator
+{ 
+public: 
+	typedef T value_type; 
+
+	LinearArena* Arena; 
+
+	ArenaAllocator(LinearArena& arena) : Arena(&arena) {}
+	template<typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other) : Arena(other.Arena) {}
+
+	T* allocate(size_t count) { return Arena->AllocateArray<T>(count); }
+	void deallocate(T*, size_t) {}
+
+	template<typename U>
+	bool operator==(const ArenaAllocator<U>& other) const { return Arena == other.Arena; }
+	template<typename U>
+	bool operator!=(const ArenaAllocator<U>& other) const { return Arena != other.Arena; }
+}; 
+
+//Fixed size blocks carved out of chunks, with a free list threaded through
+//the free blocks. Allocate and Free are a few instructions and never touch
+//the heap once the pool has grown to its working set. Not thread safe, give
+//each thread its own pool.
+class PoolAllocator
+{ 
+private: 
+	size_t m_BlockSize; 
+	size_t m_Alignment; 
+	unsigned int m_BlocksPerChunk; 
+	std::vector<char*> m_Chunks; 
+	void* m_FreeList; 
+	unsigned int m_Live; 
+
+	void Grow(); 
+public: 
+	//alignment is a power of two, above alignof(std::max_align_t) works too
+	PoolAllocator(size_t blockSize, size_t alignment = alignof(std::max_align_t), unsigned int blocksPerChunk = 256); 
+	~PoolAllocator(); 
+
+	PoolAllocator(const PoolAllocator&) = delete; 
+	PoolAllocator& operator=(const PoolAllocator&) = delete; 
+
+	void* Allocate(); 
+	void Free(void* block); 
+
+	inline unsigned int GetLiveCount() const { return m_Live; }
+	inline unsigned int GetCapacity() const { return (unsigned int)m_Chunks.size() * m_BlocksPerChunk; }
+}; 
+
+//typed front end of a PoolAllocator for render objects
+template<typename T>
+class ObjectPool
+{ 
+private: 
+	PoolAllocator m_Pool; 
+public: 
+	ObjectPool(unsigned int objectsPerChunk = 256) : m_Pool(sizeof(T), alignof(T), objectsPerChunk) {}
+
+	template<typename... Args>
+	T* New(Args&&... args) { return new (m_Pool.Allocate()) T(std::forward<Args>(args)...); }
+	void Delete(T* object)
+	{ 
+		object->~T(); 
+		m_Pool.Free(object); 
+	}
+
+	inline unsigned int GetLiveCount() const { return m_Pool.GetLiveCount(); }
+}; 
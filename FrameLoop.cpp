@@ -0,0 +1,151 @@
+#include "FrameLoop.h"
+#include "Context.h"
+#include "Renderer.h"
+
+#include <cmath>
+
+using namespace std; 
+
+FrameLoop::FrameLoop(Context& context, const FrameLoopOptions& options)
+  : m_Context(context), m_Options(options), m_Step(1.0 / options.UpdateRate), m_Start(chrono::steady_clock::now()),
+    m_FrameStart(0.0), m_InputTime(0.0), m_Accumulator(0.0), m_Time(0.0), m_Throttle(0.0),
+    m_FrameCount(0), m_GpuCount(0)
+{
+    if (m_Options.MaxFramesAhead < 1)
+        m_Options.MaxFramesAhead = 1; 
+    if (m_Options.MaxUpdatesPerFrame < 1)
+        m_Options.MaxUpdatesPerFrame = 1; 
+    m_Context.SetSwapInterval(m_Options.SwapInterval); 
+}
+
+FrameLoop::~FrameLoop()
+{
+    for (const Frame& frame : m_InFlight)
+        GLCall(glDeleteSync((GLsync)frame.Fence));
+}
+
+double FrameLoop::Now() const
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - m_Start).count(); 
+}
+
+void FrameLoop::Retire(unsigned int keep)
+{
+    while (!m_InFlight.empty())
+    {
+        GLsync sync = (GLsync)m_InFlight.front().Fence; 
+        GLenum result; 
+        GLCall(result = glClientWaitSync(sync, 0, 0));
+        if (result == GL_TIMEOUT_EXPIRED)
+        {
+            if (m_InFlight.size() <= keep)
+                return; 
+            //the CPU is too far ahead, this is the time we give back
+            double start = Now(); 
+            do
+            {
+                GLCall(result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000));
+            } while (result == GL_TIMEOUT_EXPIRED); 
+            m_Throttle += Now() - start; 
+        }
+        m_GpuLatencies[m_GpuCount++ % HistorySize] = (Now() - m_InFlight.front().InputTime) * 1000.0; 
+        GLCall(glDeleteSync(sync));
+        m_InFlight.pop_front(); 
+    }
+}
+
+bool FrameLoop::BeginFrame()
+{
+    m_Throttle = 0.0; 
+    Retire(m_Options.MaxFramesAhead - 1); 
+
+    //input is polled after the wait so the frame starts from the newest
+    m_Context.PollEvents(); 
+    m_InputTime = Now(); 
+    if (m_Context.ShouldClose())
+        return false; 
+
+    double delta = m_Stats.Frames ? m_InputTime - m_FrameStart : 0.0; 
+    m_FrameStart = m_InputTime; 
+    if (m_Stats.Frames)
+        m_FrameTimes[m_FrameCount++ % HistorySize] = delta * 1000.0; 
+
+    m_Accumulator += delta; 
+    double limit = m_Step * m_Options.MaxUpdatesPerFrame; 
+    if (m_Accumulator > limit)
+    {
+        m_Stats.DroppedUpdates += (unsigned long long)((m_Accumulator - limit) / m_Step); 
+        m_Accumulator = limit; 
+    }
+    return true; 
+}
+
+bool FrameLoop::Update()
+{
+    if (m_Accumulator < m_Step)
+        return false; 
+    m_Accumulator -= m_Step; 
+    m_Time += m_Step; 
+    m_Stats.Updates++; 
+    return true; 
+}
+
+void FrameLoop::EndFrame()
+{
+    m_Context.SwapBuffers(); 
+    double swapped = Now(); 
+
+    Frame frame; 
+    GLCall(frame.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    frame.InputTime = m_InputTime; 
+    m_InFlight.push_back(frame); 
+
+    unsigned int index = m_Stats.Frames % HistorySize; 
+    m_Latencies[index] = (swapped - m_InputTime) * 1000.0; 
+    m_Throttles[index] = m_Throttle * 1000.0; 
+    m_Stats.Frames++; 
+}
+
+bool FrameLoop::SetSwapInterval(int interval)
+{
+    m_Options.SwapInterval = interval; 
+    return m_Context.SetSwapInterval(interval); 
+}
+
+void FrameLoop::SetMaxFramesAhead(unsigned int frames)
+{
+    m_Options.MaxFramesAhead = frames ? frames : 1; 
+}
+
+static double Mean(const double* values, unsigned long long count)
+{
+    unsigned int n = (unsigned int)(count < FrameLoop::HistorySize ? count : FrameLoop::HistorySize); 
+    if (!n)
+        return 0.0; 
+    double sum = 0.0; 
+    for (unsigned int i = 0; i < n; i++)
+        sum += values[i]; 
+    return sum / n; 
+}
+
+FrameStats FrameLoop::GetStats() const
+{
+    FrameStats stats = m_Stats; 
+    stats.FrameMs = Mean(m_FrameTimes, m_FrameCount); 
+    stats.LatencyMs = Mean(m_Latencies, m_Stats.Frames); 
+    stats.GpuLatencyMs = Mean(m_GpuLatencies, m_GpuCount); 
+    stats.ThrottleMs = Mean(m_Throttles, m_Stats.Frames); 
+
+    //the spread matters more than the mean, a steady 20 ms looks smoother than 10 ms with hitches
+    unsigned int n = m_FrameCount < HistorySize ? m_FrameCount : HistorySize; 
+    double variance = 0.0; 
+    for (unsigned int i = 0; i < n; i++)
+    {
+        double d = m_FrameTimes[i] - stats.FrameMs; 
+        variance += d * d; 
+        if (m_FrameTimes[i] > stats.FrameMaxMs)
+            stats.FrameMaxMs = m_FrameTimes[i]; 
+    }
+    stats.FrameStdDevMs = n ? sqrt(variance / n) : 0.0; 
+    return stats; 
+}
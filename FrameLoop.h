@@ -0,0 +1,121 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+
+class Context; 
+
+struct FrameLoopOptions
+{
+	//simulation steps per second, independent of the display
+	double UpdateRate = 60.0; 
+	//after a long stall the steps past this are dropped, so a slow frame
+	//never leads to even more steps in the next one
+	unsigned int MaxUpdatesPerFrame = 8; 
+	//frames the CPU may queue before it waits for the GPU, 1 gives the lowest
+	//latency and 2 keeps both busy
+	unsigned int MaxFramesAhead = 2; 
+	//see Context::SetSwapInterval, -1 is adaptive vsync
+	int SwapInterval = 1; 
+}; 
+
+struct FrameStats
+{
+	unsigned long long Frames = 0; 
+	unsigned long long Updates = 0; 
+	unsigned long long DroppedUpdates = 0; 
+	//the rest are over the last HistorySize frames
+	double FrameMs = 0.0; 
+	double FrameStdDevMs = 0.0; 
+	double FrameMaxMs = 0.0; 
+	//from sampling input to SwapBuffers returning
+	double LatencyMs = 0.0; 
+	//from sampling input to finding the GPU done with the frame; fences are
+	//polled once a frame, so this is late by up to a frame unless throttled
+	double GpuLatencyMs = 0.0; 
+	//waiting for the GPU to catch up
+	double ThrottleMs = 0.0; 
+}; 
+
+//Runs the simulation at a fixed rate and draws as often as the display
+//allows, in between two steps:
+//
+//  while (loop.BeginFrame())
+//  {
+//      while (loop.Update())
+//          Step(loop.GetStep());
+//      Draw(loop.GetAlpha());
+//      loop.EndFrame();
+//  }
+//
+//Every frame is fenced. BeginFrame waits until at most MaxFramesAhead - 1
+//frames are still queued on the GPU and only then polls input, so the input
+//a frame sees is as recent as it can be.
+class FrameLoop
+{
+public:
+	static const unsigned int HistorySize = 120; 
+private:
+	struct Frame
+	{
+		void* Fence; 
+		double InputTime; 
+	}; 
+
+	Context& m_Context; 
+	FrameLoopOptions m_Options; 
+	double m_Step; 
+	std::chrono::steady_clock::time_point m_Start; 
+
+	double m_FrameStart; 
+	double m_InputTime; 
+	double m_Accumulator; 
+	double m_Time; 
+	double m_Throttle; 
+	std::deque<Frame> m_InFlight; 
+
+	//rings of the last HistorySize values
+	double m_FrameTimes[HistorySize]; 
+	double m_Latencies[HistorySize]; 
+	double m_GpuLatencies[HistorySize]; 
+	double m_Throttles[HistorySize]; 
+	unsigned int m_FrameCount; 
+	unsigned int m_GpuCount; 
+	FrameStats m_Stats; 
+
+	double Now() const; 
+	//retires the frames the GPU is done with, waiting for the oldest while more than keep are left
+	void Retire(unsigned int keep); 
+public:
+	FrameLoop(Context& context, const FrameLoopOptions& options = FrameLoopOptions()); 
+	~FrameLoop(); 
+
+	FrameLoop(const FrameLoop&) = delete; 
+	FrameLoop& operator=(const FrameLoop&) = delete; 
+
+	//false once the window should close
+	bool BeginFrame(); 
+	//true while there is a step left to run this frame
+	bool Update(); 
+	//swaps and fences the frame
+	void EndFrame(); 
+
+	bool SetSwapInterval(int interval); 
+	void SetMaxFramesAhead(unsigned int frames); 
+
+	//seconds of one step
+	inline double GetStep() const { return m_Step; }
+	//simulated seconds so far
+	inline double GetTime() const { return m_Time; }
+	//how far the frame is between the last step and the next, 0 to 1
+	inline float GetAlpha() const { return (float)(m_Accumulator / m_Step); }
+
+	FrameStats GetStats() const; 
+}; 
+
+//what to draw between the state before the last step and after it
+template<typename T>
+inline T Interpolate(const T& previous, const T& current, float alpha)
+{
+	return previous + (current - previous) * alpha; 
+}
@@ -0,0 +1,43 @@
+#include "Framebuffer.h"
+#include "Renderer.h"
+
+#include <iostream>
+
+Framebuffer::Framebuffer(int width, int height)
+  : m_Width(width), m_Height(height)
+{
+    GLCall(glGenFramebuffers(1, &m_RendererID));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+
+    GLCall(glGenRenderbuffers(1, &m_ColorBuffer));
+    GLCall(glBindRenderbuffer(GL_RENDERBUFFER, m_ColorBuffer));
+    GLCall(glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height));
+    GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_ColorBuffer));
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER); 
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    { 
+        LOG_ERROR("FRAMEBUFFER INCOMPLETE! ({})", status); 
+        GLCall(glDeleteFramebuffers(1, &m_RendererID));
+        m_RendererID = 0; 
+    }
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+Framebuffer::~Framebuffer()
+{
+    if (m_RendererID)
+        GLCall(glDeleteFramebuffers(1, &m_RendererID));
+    GLCall(glDeleteRenderbuffers(1, &m_ColorBuffer));
+}
+
+void Framebuffer::Bind() const
+{
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+    GLCall(glViewport(0, 0, m_Width, m_Height));
+}
+
+void Framebuffer::Unbind() const
+{
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
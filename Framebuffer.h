@@ -0,0 +1,25 @@
+#pragma once
+
+//Offscreen render target with a single RGBA8 color renderbuffer.
+class Framebuffer
+{ 
+private: 
+	unsigned int m_RendererID; 
+	unsigned int m_ColorBuffer; 
+	int m_Width; 
+	int m_Height; 
+public: 
+	Framebuffer(int width, int height); 
+	~Framebuffer(); 
+
+	Framebuffer(const Framebuffer&) = delete; 
+	Framebuffer& operator=(const Framebuffer&) = delete; 
+
+	//binds it for drawing and sets the viewport to its size
+	void Bind() const; 
+	void Unbind() const; 
+
+	inline bool IsComplete() const { return m_RendererID != 0; }
+	inline int GetWidth() const { return m_Width; }
+	inline int GetHeight() const { return m_Height; }
+}; 
@@ -2,25 +2,118 @@
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
-#include <iostream>
+#include "Log.h"
  
 using namespace std;
+
+std::atomic<const GLCallSite*> g_GLLastCallSite(nullptr);
+
+//per thread like the current context, the callback belongs to one context
+//and a shared upload context without it still needs glGetError
+static thread_local bool s_DebugOutputActive = false;
+//per thread, so loader threads can go through GLCall too
+static thread_local unsigned int s_SampleCounter = 0;
+
+const char* GLErrorString(unsigned int error)
+{
+        switch(error) {
+                case GL_INVALID_OPERATION:      return "INVALID_OPERATION";
+                case GL_INVALID_ENUM:           return "INVALID_ENUM";
+                case GL_INVALID_VALUE:          return "INVALID_VALUE";
+                case GL_OUT_OF_MEMORY:          return "OUT_OF_MEMORY";
+                case GL_INVALID_FRAMEBUFFER_OPERATION:  return "INVALID_FRAMEBUFFER_OPERATION";
+        }
+        return "UNKNOWN";
+}
+
+void GLReportError(unsigned int error, const char* function, const char* file, int line)
+{
+        LOG_ERROR("[OpenGL Error] GL_{} ({}): {} {}:{}", GLErrorString(error), error, function ? function : "", file, line);
+}
+
+#if GL_CHECK_LEVEL != GL_CHECK_OFF
+static void APIENTRY GLDebugCallback(GLenum, GLenum type, GLuint, GLenum severity,
+        GLsizei, const GLchar* message, const void*)
+{
+        //performance and portability chatter is not an error
+        if (type != GL_DEBUG_TYPE_ERROR && severity != GL_DEBUG_SEVERITY_HIGH)
+                return;
+
+        const GLCallSite* site = g_GLLastCallSite.load(memory_order_relaxed);
+        if (!site)
+        {
+                LOG_ERROR("[OpenGL Debug] {}", message);
+                return;
+        }
+#if GL_CHECK_LEVEL == GL_CHECK_FULL
+        LOG_ERROR("[OpenGL Debug] {} at {} {}:{}", message, site->Function, site->File, site->Line);
+#else
+        //the callback runs asynchronously, so this is only the last recorded call
+        LOG_ERROR("[OpenGL Debug] {} near {} {}:{}", message, site->Function, site->File, site->Line);
+#endif
+}
+#endif
+
+bool GLInitDebugOutput()
+{
+#if GL_CHECK_LEVEL == GL_CHECK_OFF
+        return false;
+#else
+        if (!GLEW_KHR_debug)
+                return false;
+
+        glEnable(GL_DEBUG_OUTPUT);
+#if GL_CHECK_LEVEL == GL_CHECK_FULL
+        //full checking wants exact call sites, so let the driver call back inline
+        glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+#else
+        glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+#endif
+        glDebugMessageCallback(GLDebugCallback, nullptr);
+        glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+
+        s_DebugOutputActive = true;
+        return true;
+#endif
+}
+
+void GLSyncDebugOutput()
+{
+#if GL_CHECK_LEVEL != GL_CHECK_OFF
+        void* callback = nullptr;
+        if (GLEW_KHR_debug)
+                glGetPointerv(GL_DEBUG_CALLBACK_FUNCTION, &callback);
+        s_DebugOutputActive = callback == (void*)GLDebugCallback && glIsEnabled(GL_DEBUG_OUTPUT);
+#endif
+}
+
+bool GLDebugOutputActive()
+{
+        return s_DebugOutputActive;
+}
+
+void GLSampleCheck(const GLCallSite* site)
+{
+        //the debug callback already reports everything without stalling
+        if (s_DebugOutputActive)
+                return;
+        if (++s_SampleCounter < GL_CHECK_SAMPLE_RATE)
+                return;
+        s_SampleCounter = 0;
+
+        //the error may come from any call since the last sample
+        while (GLenum err = glGetError())
+                GLReportError(err, site->Function, site->File, site->Line);
+}
  
 void _check_gl_error(const char *file, int line) {
+        if (s_DebugOutputActive)
+                return;
+
         GLenum err (glGetError());
  
         while(err!=GL_NO_ERROR) {
-                string error;
- 
-                switch(err) {
-                        case GL_INVALID_OPERATION:      error="INVALID_OPERATION";      break;
-                        case GL_INVALID_ENUM:           error="INVALID_ENUM";           break;
-                        case GL_INVALID_VALUE:          error="INVALID_VALUE";          break;
-                        case GL_OUT_OF_MEMORY:          error="OUT_OF_MEMORY";          break;
-                        case GL_INVALID_FRAMEBUFFER_OPERATION:  error="INVALID_FRAMEBUFFER_OPERATION";  break;
-                }
- 
-                cerr << "GL_" << error.c_str() <<" - "<<file<<":"<<line<<endl;
+                GLReportError(err, nullptr, file, line);
                 err=glGetError();
         }
-}
\ No newline at end of file
+}
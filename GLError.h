@@ -1,6 +1,60 @@
 #ifndef GLERROR_H
 #define GLERROR_H
- 
+
+#include <atomic>
+
+///
+/// Error checking levels, pick one at build time with -DGL_CHECK_LEVEL=n
+///
+/// GL_CHECK_OFF      GLCall(x) is just x, nothing is checked (default with NDEBUG)
+/// GL_CHECK_SAMPLED  call sites are recorded and errors come from the KHR_debug
+///                   callback asynchronously, or from glGetError every
+///                   GL_CHECK_SAMPLE_RATE calls when the extension is missing
+///                   (default in development builds)
+/// GL_CHECK_FULL     glGetError around every call, exact but stalls the pipeline
+///
+#define GL_CHECK_OFF     0
+#define GL_CHECK_SAMPLED 1
+#define GL_CHECK_FULL    2
+
+#ifndef GL_CHECK_LEVEL
+    #ifdef NDEBUG
+        #define GL_CHECK_LEVEL GL_CHECK_OFF
+    #else
+        #define GL_CHECK_LEVEL GL_CHECK_SAMPLED
+    #endif
+#endif
+
+#ifndef GL_CHECK_SAMPLE_RATE
+    #define GL_CHECK_SAMPLE_RATE 64
+#endif
+
+struct GLCallSite
+{
+    const char* Function;
+    const char* File;
+    int Line;
+};
+
+//last call site that went through GLCall, used to place asynchronous errors
+extern std::atomic<const GLCallSite*> g_GLLastCallSite;
+
+inline void GLRecordCall(const GLCallSite* site)
+{
+    g_GLLastCallSite.store(site, std::memory_order_relaxed);
+}
+
+const char* GLErrorString(unsigned int error);
+void GLReportError(unsigned int error, const char* function, const char* file, int line);
+
+//installs the KHR_debug callback if the context supports it, call after glewInit
+bool GLInitDebugOutput();
+//after making a context current: the callback belongs to one context, this
+//tells the calling thread whether its context has it or needs glGetError
+void GLSyncDebugOutput();
+bool GLDebugOutputActive();
+
+void GLSampleCheck(const GLCallSite* site);
 void _check_gl_error(const char *file, int line);
  
 ///
@@ -8,6 +62,10 @@ void _check_gl_error(const char *file, int line);
 /// [... some opengl calls]
 /// glCheckError();
 ///
-#define check_gl_error() _check_gl_error(__FILE__,__LINE__)
+#if GL_CHECK_LEVEL == GL_CHECK_OFF
+    #define check_gl_error() ((void)0)
+#else
+    #define check_gl_error() _check_gl_error(__FILE__,__LINE__)
+#endif
  
-#endif // GLERROR_H
\ No newline at end of file
+#endif // GLERROR_H
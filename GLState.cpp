@@ -0,0 +1,320 @@
+#include "GLState.h"
+#include "Renderer.h"
+
+#include <unordered_map>
+
+//marks a cached value as unknown, never a valid GL name or enum
+static const unsigned int Unknown = 0xffffffff; 
+
+enum BufferSlot
+{ 
+    ArrayBufferSlot, UniformBufferSlot, CopyReadSlot, CopyWriteSlot, PixelPackSlot,
+    PixelUnpackSlot, DrawIndirectSlot, ShaderStorageSlot, TextureBufferSlot, ParameterBufferSlot, BufferSlotCount
+}; 
+
+enum TextureSlot { Texture2DSlot, Texture2DArraySlot, TextureCubeSlot, TextureSlotCount }; 
+
+enum CapabilitySlot { BlendSlot, DepthTestSlot, CullFaceSlot, ScissorTestSlot, CapabilitySlotCount }; 
+
+struct TrackedState
+{ 
+    unsigned int Buffers[BufferSlotCount]; 
+    //element array binding of every VAO we have seen
+    std::unordered_map<unsigned int, unsigned int> ElementBuffers; 
+    unsigned int VertexArray; 
+    unsigned int Program; 
+    unsigned int ActiveTexture; 
+    unsigned int Textures[GLState::MaxTextureUnits][TextureSlotCount]; 
+    unsigned int Capabilities[CapabilitySlotCount]; 
+    unsigned int BlendSource, BlendDestination; 
+    unsigned int DepthFunc; 
+    unsigned int DepthMask; 
+}; 
+
+static TrackedState s_State; 
+static GLState::Stats s_Stats; 
+static bool s_Initialized = false; 
+
+static void Forget()
+{
+    for (unsigned int& buffer : s_State.Buffers)
+        buffer = Unknown; 
+    s_State.ElementBuffers.clear(); 
+    s_State.VertexArray = Unknown; 
+    s_State.Program = Unknown; 
+    s_State.ActiveTexture = Unknown; 
+    for (auto& unit : s_State.Textures)
+        for (unsigned int& texture : unit)
+            texture = Unknown; 
+    for (unsigned int& capability : s_State.Capabilities)
+        capability = Unknown; 
+    s_State.BlendSource = s_State.BlendDestination = Unknown; 
+    s_State.DepthFunc = Unknown; 
+    s_State.DepthMask = Unknown; 
+    s_Initialized = true; 
+}
+
+static inline TrackedState& State()
+{
+    if (!s_Initialized)
+        Forget(); 
+    return s_State; 
+}
+
+//true when the cached value already matches, otherwise stores it
+static inline bool Same(unsigned int& cached, unsigned int value)
+{
+    if (cached == value)
+    { 
+        s_Stats.Elided++; 
+        return true; 
+    }
+    cached = value; 
+    s_Stats.Issued++; 
+    return false; 
+}
+
+static int BufferSlotOf(unsigned int target)
+{
+    switch (target)
+    { 
+        case GL_ARRAY_BUFFER:          return ArrayBufferSlot; 
+        case GL_UNIFORM_BUFFER:        return UniformBufferSlot; 
+        case GL_COPY_READ_BUFFER:      return CopyReadSlot; 
+        case GL_COPY_WRITE_BUFFER:     return CopyWriteSlot; 
+        case GL_PIXEL_PACK_BUFFER:     return PixelPackSlot; 
+        case GL_PIXEL_UNPACK_BUFFER:   return PixelUnpackSlot; 
+        case GL_DRAW_INDIRECT_BUFFER:  return DrawIndirectSlot; 
+        case GL_SHADER_STORAGE_BUFFER: return ShaderStorageSlot; 
+        case GL_TEXTURE_BUFFER:        return TextureBufferSlot; 
+        case GL_PARAMETER_BUFFER_ARB:  return ParameterBufferSlot; 
+    }
+    return -1; 
+}
+
+static int TextureSlotOf(unsigned int target)
+{
+    switch (target)
+    { 
+        case GL_TEXTURE_2D:        return Texture2DSlot; 
+        case GL_TEXTURE_2D_ARRAY:  return Texture2DArraySlot; 
+        case GL_TEXTURE_CUBE_MAP:  return TextureCubeSlot; 
+    }
+    return -1; 
+}
+
+static int CapabilitySlotOf(unsigned int capability)
+{
+    switch (capability)
+    { 
+        case GL_BLEND:        return BlendSlot; 
+        case GL_DEPTH_TEST:   return DepthTestSlot; 
+        case GL_CULL_FACE:    return CullFaceSlot; 
+        case GL_SCISSOR_TEST: return ScissorTestSlot; 
+    }
+    return -1; 
+}
+
+void GLState::BindBuffer(unsigned int target, unsigned int buffer)
+{
+    TrackedState& state = State(); 
+
+    if (target == GL_ELEMENT_ARRAY_BUFFER)
+    { 
+        //without a known VAO we cannot tell what is bound
+        if (state.VertexArray == Unknown)
+        { 
+            s_Stats.Issued++; 
+            GLCall(glBindBuffer(target, buffer)); 
+            return; 
+        }
+        auto it = state.ElementBuffers.find(state.VertexArray); 
+        if (it != state.ElementBuffers.end() && Same(it->second, buffer))
+            return; 
+        if (it == state.ElementBuffers.end())
+        { 
+            state.ElementBuffers[state.VertexArray] = buffer; 
+            s_Stats.Issued++; 
+        }
+        GLCall(glBindBuffer(target, buffer)); 
+        return; 
+    }
+
+    int slot = BufferSlotOf(target); 
+    if (slot < 0)
+    { 
+        s_Stats.Issued++; 
+        GLCall(glBindBuffer(target, buffer)); 
+        return; 
+    }
+    if (!Same(state.Buffers[slot], buffer))
+        GLCall(glBindBuffer(target, buffer)); 
+}
+
+void GLState::BindBufferBase(unsigned int target, unsigned int index, unsigned int buffer)
+{
+    TrackedState& state = State(); 
+    //indexed bindings are not tracked, but the generic one changes with them
+    s_Stats.Issued++; 
+    GLCall(glBindBufferBase(target, index, buffer)); 
+    int slot = BufferSlotOf(target); 
+    if (slot >= 0)
+        state.Buffers[slot] = buffer; 
+}
+
+void GLState::BindVertexArray(unsigned int vao)
+{
+    if (!Same(State().VertexArray, vao))
+        GLCall(glBindVertexArray(vao)); 
+}
+
+void GLState::UseProgram(unsigned int program)
+{
+    if (!Same(State().Program, program))
+        GLCall(glUseProgram(program)); 
+}
+
+static void BindTextureOn(unsigned int unit, unsigned int target, unsigned int texture, bool select)
+{
+    TrackedState& state = State(); 
+    int slot = TextureSlotOf(target); 
+    bool bound = slot >= 0 && unit < GLState::MaxTextureUnits && state.Textures[unit][slot] == texture; 
+    if ((select || !bound) && !Same(state.ActiveTexture, unit))
+        GLCall(glActiveTexture(GL_TEXTURE0 + unit)); 
+    if (bound)
+    { 
+        s_Stats.Elided++; 
+        return; 
+    }
+
+    s_Stats.Issued++; 
+    GLCall(glBindTexture(target, texture)); 
+    if (slot >= 0 && unit < GLState::MaxTextureUnits)
+        state.Textures[unit][slot] = texture; 
+}
+
+void GLState::BindTexture(unsigned int unit, unsigned int target, unsigned int texture)
+{
+    BindTextureOn(unit, target, texture, false); 
+}
+
+void GLState::BindTextureForEdit(unsigned int unit, unsigned int target, unsigned int texture)
+{
+    BindTextureOn(unit, target, texture, true); 
+}
+
+void GLState::SetEnabled(unsigned int capability, bool enabled)
+{
+    int slot = CapabilitySlotOf(capability); 
+    if (slot >= 0 && Same(State().Capabilities[slot], enabled))
+        return; 
+    if (slot < 0)
+        s_Stats.Issued++; 
+
+    if (enabled)
+        GLCall(glEnable(capability)); 
+    else
+        GLCall(glDisable(capability)); 
+}
+
+void GLState::BlendFunc(unsigned int source, unsigned int destination)
+{
+    TrackedState& state = State(); 
+    if (state.BlendSource == source && state.BlendDestination == destination)
+    { 
+        s_Stats.Elided++; 
+        return; 
+    }
+    state.BlendSource = source; 
+    state.BlendDestination = destination; 
+    s_Stats.Issued++; 
+    GLCall(glBlendFunc(source, destination)); 
+}
+
+void GLState::DepthFunc(unsigned int func)
+{
+    if (!Same(State().DepthFunc, func))
+        GLCall(glDepthFunc(func)); 
+}
+
+void GLState::DepthMask(bool write)
+{
+    if (!Same(State().DepthMask, write))
+        GLCall(glDepthMask(write ? GL_TRUE : GL_FALSE)); 
+}
+
+void GLState::DeleteBuffer(unsigned int buffer)
+{
+    DeleteBuffers(1, &buffer); 
+}
+
+void GLState::DeleteBuffers(unsigned int count, const unsigned int* buffers)
+{
+    TrackedState& state = State(); 
+    GLCall(glDeleteBuffers(count, buffers)); 
+
+    for (unsigned int i = 0; i < count; i++)
+    { 
+        unsigned int buffer = buffers[i]; 
+        //GL drops the bindings of a deleted buffer in the current context
+        for (unsigned int& bound : state.Buffers)
+            if (bound == buffer)
+                bound = 0; 
+        auto it = state.ElementBuffers.find(state.VertexArray); 
+        if (it != state.ElementBuffers.end() && it->second == buffer)
+            it->second = 0; 
+        //other VAOs keep a reference to the old name, so a reused name is not trustworthy there
+        for (auto& entry : state.ElementBuffers)
+            if (entry.second == buffer)
+                entry.second = Unknown; 
+    }
+}
+
+void GLState::DeleteVertexArray(unsigned int vao)
+{
+    TrackedState& state = State(); 
+    GLCall(glDeleteVertexArrays(1, &vao)); 
+    state.ElementBuffers.erase(vao); 
+    if (state.VertexArray == vao)
+        state.VertexArray = 0; 
+}
+
+void GLState::DeleteProgram(unsigned int program)
+{
+    TrackedState& state = State(); 
+    GLCall(glDeleteProgram(program)); 
+    //a bound program lives on until it is unbound, after that the name may come back
+    if (state.Program == program)
+        state.Program = Unknown; 
+}
+
+void GLState::DeleteTexture(unsigned int texture)
+{
+    DeleteTextures(1, &texture); 
+}
+
+void GLState::DeleteTextures(unsigned int count, const unsigned int* textures)
+{
+    TrackedState& state = State(); 
+    GLCall(glDeleteTextures(count, textures)); 
+    for (unsigned int i = 0; i < count; i++)
+        for (auto& unit : state.Textures)
+            for (unsigned int& bound : unit)
+                if (bound == textures[i])
+                    bound = 0; 
+}
+
+void GLState::Invalidate()
+{
+    Forget(); 
+}
+
+const GLState::Stats& GLState::GetStats()
+{
+    return s_Stats; 
+}
+
+void GLState::ResetStats()
+{
+    s_Stats = Stats(); 
+}
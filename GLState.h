@@ -0,0 +1,51 @@
+#pragma once
+
+//Shadow copy of the GL binding and pipeline state. Every wrapper goes through
+//here instead of calling glBind*/glEnable directly, so a bind of what is
+//already bound never reaches the driver. It assumes it is the only one
+//changing this state; after raw GL calls from elsewhere call Invalidate().
+//
+//The element array buffer binding belongs to the bound vertex array, so it is
+//remembered per VAO. Deleting a bound object unbinds it in GL, so deletes
+//have to go through here too.
+class GLState
+{ 
+public: 
+	static const unsigned int MaxTextureUnits = 32; 
+
+	struct Stats
+	{ 
+		unsigned int Issued = 0; 
+		unsigned int Elided = 0; 
+	}; 
+
+	static void BindBuffer(unsigned int target, unsigned int buffer); 
+	//binds to an indexed point, which also sets the generic binding of target
+	static void BindBufferBase(unsigned int target, unsigned int index, unsigned int buffer); 
+	static void BindVertexArray(unsigned int vao); 
+	static void UseProgram(unsigned int program); 
+	//for drawing; an elided bind leaves the active unit where it was
+	static void BindTexture(unsigned int unit, unsigned int target, unsigned int texture); 
+	//for glTex* calls, which change whatever is bound on the active unit, so
+	//unit is made active even when the bind itself is elided
+	static void BindTextureForEdit(unsigned int unit, unsigned int target, unsigned int texture); 
+
+	static void SetEnabled(unsigned int capability, bool enabled); 
+	static void BlendFunc(unsigned int source, unsigned int destination); 
+	static void DepthFunc(unsigned int func); 
+	static void DepthMask(bool write); 
+
+	static void DeleteBuffer(unsigned int buffer); 
+	static void DeleteBuffers(unsigned int count, const unsigned int* buffers); 
+	static void DeleteVertexArray(unsigned int vao); 
+	static void DeleteProgram(unsigned int program); 
+	static void DeleteTexture(unsigned int texture); 
+	static void DeleteTextures(unsigned int count, const unsigned int* textures); 
+
+	//forgets everything, the next call of each kind goes to the driver
+	static void Invalidate(); 
+
+	static const Stats& GetStats(); 
+	//call once a frame to get per-frame numbers
+	static void ResetStats(); 
+}; 
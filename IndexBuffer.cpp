@@ -1,29 +1,73 @@
 #include "IndexBuffer.h"
 #include "Renderer.h"
+#include "GLState.h"
+
+#include <vector>
 
 IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count)
-  : m_Count(count)
 {
-	//generates buffer(s)
-    GLCall(glGenBuffers(1, &m_RendererID));
-    //select buffer to render data
-    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
-    //cout << "Binded buffer to opengl" << endl;
-    GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW));  
-    //cout << "Generated buffer data addeed posistions" << endl;
+    unsigned int largest = 0; 
+    for (unsigned int i = 0; i < count; i++)
+        largest = data[i] > largest ? data[i] : largest; 
+
+    if (largest > 0xffff)
+    { 
+        Create(data, count, GL_UNSIGNED_INT, GL_STATIC_DRAW); 
+        return; 
+    }
+    std::vector<unsigned short> shorts(data, data + count); 
+    Create(shorts.data(), count, GL_UNSIGNED_SHORT, GL_STATIC_DRAW); 
+}
+
+IndexBuffer::IndexBuffer(const unsigned short* data, unsigned int count)
+{
+    Create(data, count, GL_UNSIGNED_SHORT, GL_STATIC_DRAW); 
+}
+
+IndexBuffer::IndexBuffer(unsigned int count, unsigned int type)
+{
+    Create(nullptr, count, type, GL_DYNAMIC_DRAW); 
+}
+
+void IndexBuffer::Create(const void* data, unsigned int count, unsigned int type, unsigned int usage)
+{
+    m_Count = count; 
+    m_Type = type; 
+    m_Buffer = GpuBuffer::Create(); 
+    //through the copy target like UpdateData, binding the element target would
+    //replace the index buffer of whatever vertex array is bound
+    GLState::BindBuffer(GL_COPY_WRITE_BUFFER, m_Buffer.Get()); 
+    GLCall(glBufferData(GL_COPY_WRITE_BUFFER, count * SizeOf(type), data, usage));
+}
+
+IndexBuffer* IndexBuffer::Adopt(unsigned int rendererID, unsigned int count, unsigned int type)
+{
+    IndexBuffer* ib = new IndexBuffer(); 
+    ib->m_Buffer = GpuBuffer::Adopt(rendererID); 
+    ib->m_Count = count; 
+    ib->m_Type = type; 
+    return ib; 
 }
 
-IndexBuffer::~IndexBuffer()
+unsigned int IndexBuffer::SizeOf(unsigned int type)
 {
-	GLCall(glDeleteBuffers(1, &m_RendererID)); 
+    return type == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int); 
+}
+
+void IndexBuffer::UpdateData(const void* data, unsigned int count, unsigned int first)
+{
+    ASSERT(first + count <= m_Count);
+    //through the copy target, binding the element target would change the bound vertex array
+    GLState::BindBuffer(GL_COPY_WRITE_BUFFER, m_Buffer.Get()); 
+    GLCall(glBufferSubData(GL_COPY_WRITE_BUFFER, first * SizeOf(m_Type), count * SizeOf(m_Type), data));
 }
 
 void IndexBuffer::Bind() const 
 {
-   GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
+   GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Buffer.Get()); 
 }
 
 void IndexBuffer::Unbind() const 
 {
-   GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
-}
\ No newline at end of file
+   GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
@@ -1,17 +1,43 @@
 #pragma once
 
+#include "ResourceManager.h"
 
+//pooled and deleted like a VertexBuffer
 class IndexBuffer
 { 
 private: 
-	unsigned int m_RendererID; 
+	GpuBuffer m_Buffer; 
 	unsigned int m_Count; 
+	unsigned int m_Type; 
+
+	IndexBuffer() {}
+	void Create(const void* data, unsigned int count, unsigned int type, unsigned int usage); 
 public: 
+	//stored as GL_UNSIGNED_SHORT when every index fits, which halves the index bandwidth
 	IndexBuffer(const unsigned int* data, unsigned int count); 
-	~IndexBuffer(); 
+	IndexBuffer(const unsigned short* data, unsigned int count); 
+	//dynamic buffer of count indices, filled later with UpdateData
+	IndexBuffer(unsigned int count, unsigned int type); 
+
+	IndexBuffer(const IndexBuffer&) = delete; 
+	IndexBuffer& operator=(const IndexBuffer&) = delete; 
+	IndexBuffer(IndexBuffer&&) = default; 
+	IndexBuffer& operator=(IndexBuffer&&) = default; 
+
+	//takes over a buffer created elsewhere, e.g. by the AssetLoader upload thread
+	static IndexBuffer* Adopt(unsigned int rendererID, unsigned int count, unsigned int type); 
+
+	//bytes per index of GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+	static unsigned int SizeOf(unsigned int type); 
+
+	//overwrites count indices from first on, data has to be of the buffer's type
+	void UpdateData(const void* data, unsigned int count, unsigned int first); 
 
 	void Bind()  const; 
 	void Unbind() const; 
 
 	inline unsigned int GetCount() const { return m_Count; }
-};
\ No newline at end of file
+	//what draw calls pass as their index type
+	inline unsigned int GetType() const { return m_Type; }
+	inline unsigned int GetRendererID() const { return m_Buffer.Get(); }
+};
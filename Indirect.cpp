@@ -0,0 +1,132 @@
+#include <GL/glew.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+
+#include "Renderer.h"
+#include "Context.h"
+#include "IndirectRenderer.h"
+#include "Shader.h"
+
+using namespace std; 
+
+//Draws 50k objects made of 256 different meshes, each one a star with its
+//own number of points, with the IndirectRenderer. The objects cover twice
+//the screen in each direction so about a quarter survives culling. Asks for
+//a 4.3 context and prints which path the renderer ended up on; force one
+//with
+//
+//  ./Indirect gpu-cull|multi-draw|base-instance|fallback
+
+//a star around the origin with radius 1, center vertex first
+static void MakeStar(unsigned int points, float inner, vector<Float2>& vertices, vector<unsigned int>& indices)
+{ 
+    vertices.clear(); 
+    indices.clear(); 
+    vertices.push_back({ { 0.0f, 0.0f } }); 
+    for (unsigned int i = 0; i < points * 2; i++)
+    { 
+        float angle = i * 3.14159265f / points; 
+        float radius = i % 2 ? inner : 1.0f; 
+        vertices.push_back({ { radius * cos(angle), radius * sin(angle) } }); 
+    }
+    for (unsigned int i = 0; i < points * 2; i++)
+    { 
+        indices.push_back(0); 
+        indices.push_back(1 + i); 
+        indices.push_back(1 + (i + 1) % (points * 2)); 
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ContextOptions options; 
+    options.Title = "Indirect"; 
+    options.SwapInterval = 0; 
+    options.MinorVersion = 3; 
+    Context context(options); 
+    if (!context.IsValid())
+        return -1; 
+    cout << glGetString(GL_VERSION) << endl; 
+
+    {
+    Shader shader("res/shaders/Instanced.shader"); 
+    Shader* cullShader = nullptr; 
+    if (GLEW_VERSION_4_3)
+        cullShader = new Shader("res/shaders/Cull.shader"); 
+
+    const unsigned int meshCount = 256; 
+    MeshPool meshes(VertexBufferLayout::Of<Float2>()); 
+    vector<Float2> vertices; 
+    vector<unsigned int> indices; 
+    for (unsigned int i = 0; i < meshCount; i++)
+    { 
+        MakeStar(3 + i % 29, 0.3f + 0.4f * (i / 29) / 9.0f, vertices, indices); 
+        meshes.Add(vertices.data(), (unsigned int)vertices.size(), indices.data(), (unsigned int)indices.size()); 
+    }
+    meshes.Upload(); 
+
+    const unsigned int count = 50000; 
+    IndirectRenderer renderer(meshes, count, cullShader); 
+    if (argc > 1)
+    { 
+        bool found = false; 
+        for (IndirectRenderer::Path path : { IndirectRenderer::Path::GPUCull, IndirectRenderer::Path::MultiDraw,
+                                             IndirectRenderer::Path::BaseInstance, IndirectRenderer::Path::Fallback })
+        { 
+            if (strcmp(argv[1], IndirectRenderer::GetPathName(path)))
+                continue; 
+            found = true; 
+            if (!renderer.SetPath(path))
+                cout << argv[1] << " is not supported here" << endl; 
+        }
+        if (!found)
+            cout << "unknown path " << argv[1] << endl; 
+    }
+    cout << "drawing with " << IndirectRenderer::GetPathName(renderer.GetPath()) << endl; 
+
+    srand(1); 
+    for (unsigned int i = 0; i < count; i++)
+    { 
+        float x = rand() / (float)RAND_MAX * 4.0f - 2.0f; 
+        float y = rand() / (float)RAND_MAX * 4.0f - 2.0f; 
+        float scale = 0.005f + rand() / (float)RAND_MAX * 0.01f; 
+        IndirectObject object; 
+        object.Transform = { { x, y, scale, rand() / (float)RAND_MAX * 6.28f } }; 
+        object.Color = { { (unsigned char)(rand() % 256), (unsigned char)(rand() % 256), (unsigned char)(rand() % 256), 255 } }; 
+        renderer.Add(rand() % meshCount, object, x - scale, y - scale, x + scale, y + scale); 
+    }
+
+    const ViewRect view = { -1.0f, -1.0f, 1.0f, 1.0f }; 
+    double lastReport = chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count(); 
+    unsigned int frames = 0; 
+    while (!context.ShouldClose())
+    { 
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+        renderer.Draw(view, shader); 
+        frames++; 
+
+        double now = chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count(); 
+        if (now - lastReport >= 1.0)
+        { 
+            const IndirectRenderer::Stats& stats = renderer.GetStats(); 
+            cout << frames / (now - lastReport) << " fps, " << stats.Objects / frames << " objects, "
+                 << stats.Commands / frames << " commands in " << stats.DrawCalls / frames << " draw calls, culling took "
+                 << stats.CullMs / frames << " ms" << endl; 
+            renderer.ResetStats(); 
+            lastReport = now; 
+            frames = 0; 
+        }
+
+        context.SwapBuffers(); 
+        context.PollEvents(); 
+    }
+    delete cullShader; 
+    }
+    return 0;
+}
@@ -0,0 +1,315 @@
+#include "IndirectRenderer.h"
+#include "Renderer.h"
+#include "GLState.h"
+#include "Shader.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "StreamBuffer.h"
+
+#include <chrono>
+#include <cstring>
+
+using namespace std; 
+
+//Cull.shader's local_size_x
+static const unsigned int CullGroupSize = 64; 
+//command buffers in flight on the MultiDraw path
+static const unsigned int IndirectFrames = 3; 
+
+MeshPool::MeshPool(const VertexBufferLayout& layout)
+  : m_Layout(layout), m_VertexBuffer(nullptr), m_IndexBuffer(nullptr)
+{
+}
+
+MeshPool::~MeshPool()
+{
+    delete m_VertexBuffer; 
+    delete m_IndexBuffer; 
+}
+
+unsigned int MeshPool::Add(const void* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount)
+{
+    ASSERT(!m_VertexBuffer);
+    Range range; 
+    range.FirstIndex = (unsigned int)m_Indices.size(); 
+    range.IndexCount = indexCount; 
+    range.BaseVertex = (int)(m_Vertices.size() / m_Layout.GetStride()); 
+    range.VertexCount = vertexCount; 
+
+    const unsigned char* bytes = (const unsigned char*)vertices; 
+    m_Vertices.insert(m_Vertices.end(), bytes, bytes + vertexCount * m_Layout.GetStride()); 
+    m_Indices.insert(m_Indices.end(), indices, indices + indexCount); 
+    m_Meshes.push_back(range); 
+    return (unsigned int)m_Meshes.size() - 1; 
+}
+
+void MeshPool::Upload()
+{
+    ASSERT(!m_VertexBuffer);
+    m_VertexBuffer = new VertexBuffer(m_Vertices.data(), (unsigned int)m_Vertices.size()); 
+    //narrows to 16-bit by itself when the biggest mesh allows it
+    m_IndexBuffer = new IndexBuffer(m_Indices.data(), (unsigned int)m_Indices.size()); 
+    vector<unsigned char>().swap(m_Vertices); 
+    vector<unsigned int>().swap(m_Indices); 
+}
+
+IndirectRenderer::IndirectRenderer(const MeshPool& meshes, unsigned int capacity, Shader* cullShader)
+  : m_Meshes(meshes), m_Capacity(capacity), m_Objects(sizeof(IndirectObject), capacity), m_CullShader(cullShader),
+    m_ViewHandle(-1), m_CountHandle(-1), m_CullObjectBuffer(0), m_MeshBuffer(0), m_CommandBuffer(0), m_CounterBuffer(0), m_CullObjectsDirty(false),
+    m_IndirectStream(nullptr)
+{
+    m_VertexArray.AddBuffer(m_Meshes.GetVertexBuffer(), m_Meshes.GetLayout()); 
+    m_ObjectBinding = m_VertexArray.AddBuffer<IndirectObject>(m_Objects.GetVertexBuffer(), 1); 
+    m_VertexArray.SetIndexBuffer(m_Meshes.GetIndexBuffer()); 
+
+    m_CullObjects.reserve(capacity); 
+    m_Culler.Reserve(capacity); 
+    m_Commands.reserve(capacity); 
+
+    m_Path = Path::Fallback; 
+    for (Path path : { Path::GPUCull, Path::MultiDraw, Path::BaseInstance })
+        if (SetPath(path))
+            break; 
+}
+
+IndirectRenderer::~IndirectRenderer()
+{
+    for (unsigned int buffer : { m_CullObjectBuffer, m_MeshBuffer, m_CommandBuffer, m_CounterBuffer })
+        if (buffer)
+            GLState::DeleteBuffer(buffer); 
+    delete m_IndirectStream; 
+}
+
+const char* IndirectRenderer::GetPathName(Path path)
+{
+    switch (path)
+    { 
+        case Path::GPUCull:      return "gpu-cull"; 
+        case Path::MultiDraw:    return "multi-draw"; 
+        case Path::BaseInstance: return "base-instance"; 
+        case Path::Fallback:     return "fallback"; 
+    }
+    return "unknown"; 
+}
+
+bool IndirectRenderer::IsSupported(Path path) const
+{
+    bool baseInstance = GLEW_VERSION_4_2 || GLEW_ARB_base_instance; 
+    switch (path)
+    { 
+        case Path::GPUCull:      return m_CullShader && GLEW_VERSION_4_3; 
+        case Path::MultiDraw:    return baseInstance && (GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect); 
+        case Path::BaseInstance: return baseInstance; 
+        case Path::Fallback:     return true; 
+    }
+    return false; 
+}
+
+bool IndirectRenderer::SetPath(Path path)
+{
+    if (!IsSupported(path))
+        return false; 
+    m_Path = path; 
+
+    if (m_Path == Path::GPUCull && !m_CommandBuffer)
+        CreateGPUBuffers(); 
+    if (m_Path == Path::MultiDraw && !m_IndirectStream)
+        m_IndirectStream = new StreamBuffer(GL_DRAW_INDIRECT_BUFFER, IndirectFrames * m_Capacity * sizeof(DrawElementsIndirectCommand)); 
+    //the fallback moves the binding around, everything else reads from the start
+    m_VertexArray.SetBuffer(m_ObjectBinding, m_Objects.GetVertexBuffer()); 
+    m_CullObjectsDirty = true; 
+    return true; 
+}
+
+void IndirectRenderer::CreateGPUBuffers()
+{
+    vector<CullMesh> meshes(m_Meshes.GetCount()); 
+    for (unsigned int i = 0; i < meshes.size(); i++)
+    { 
+        const MeshPool::Range& range = m_Meshes.Get(i); 
+        meshes[i] = { range.IndexCount, range.FirstIndex, range.BaseVertex, 0 }; 
+    }
+
+    m_ViewHandle = m_CullShader->GetUniform("u_View"); 
+    m_CountHandle = m_CullShader->GetUniform("u_Count"); 
+
+    unsigned int* buffers[] = { &m_CullObjectBuffer, &m_MeshBuffer, &m_CommandBuffer, &m_CounterBuffer }; 
+    unsigned int sizes[] = { 
+        (unsigned int)(m_Capacity * sizeof(CullObject)), 
+        (unsigned int)(meshes.size() * sizeof(CullMesh)), 
+        (unsigned int)(m_Capacity * sizeof(DrawElementsIndirectCommand)), 
+        (unsigned int)sizeof(unsigned int) 
+    }; 
+    const void* data[] = { nullptr, meshes.data(), nullptr, nullptr }; 
+    for (unsigned int i = 0; i < 4; i++)
+    { 
+        GLCall(glGenBuffers(1, buffers[i]));
+        GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, *buffers[i]); 
+        GLCall(glBufferData(GL_SHADER_STORAGE_BUFFER, sizes[i], data[i], data[i] ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW));
+    }
+}
+
+unsigned int IndirectRenderer::Add(unsigned int mesh, const IndirectObject& object, float minX, float minY, float maxX, float maxY)
+{
+    ASSERT(m_CullObjects.size() < m_Capacity);
+    unsigned int index = (unsigned int)m_CullObjects.size(); 
+    m_CullObjects.push_back({ { minX, minY, maxX, maxY }, mesh, { 0, 0, 0 } }); 
+    m_Culler.Add(minX, minY, maxX, maxY); 
+    m_Objects.Set(index, object); 
+    m_CullObjectsDirty = true; 
+    return index; 
+}
+
+void IndirectRenderer::Set(unsigned int index, const IndirectObject& object)
+{
+    m_Objects.Set(index, object); 
+}
+
+void IndirectRenderer::SetBounds(unsigned int index, float minX, float minY, float maxX, float maxY)
+{
+    CullObject& cull = m_CullObjects[index]; 
+    cull.Bounds[0] = minX; 
+    cull.Bounds[1] = minY; 
+    cull.Bounds[2] = maxX; 
+    cull.Bounds[3] = maxY; 
+    m_Culler.Set(index, minX, minY, maxX, maxY); 
+    m_CullObjectsDirty = true; 
+}
+
+void IndirectRenderer::CullOnGPU(const ViewRect& view)
+{
+    unsigned int count = GetCount(); 
+    if (m_CullObjectsDirty)
+    { 
+        GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, m_CullObjectBuffer); 
+        GLCall(glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, count * sizeof(CullObject), m_CullObjects.data()));
+        m_CullObjectsDirty = false; 
+    }
+
+    //culled objects leave zeroed commands behind, which draw nothing
+    unsigned int zero = 0; 
+    GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, m_CommandBuffer); 
+    GLCall(glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero));
+    GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, m_CounterBuffer); 
+    GLCall(glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero));
+
+    m_CullShader->Bind(); 
+    m_CullShader->SetUniform4f(m_ViewHandle, view.MinX, view.MinY, view.MaxX, view.MaxY); 
+    m_CullShader->SetUniform1i(m_CountHandle, (int)count); 
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_CullObjectBuffer); 
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_MeshBuffer); 
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_CommandBuffer); 
+    GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, m_CounterBuffer); 
+    GLCall(glDispatchCompute((count + CullGroupSize - 1) / CullGroupSize, 1, 1));
+    //the draw reads the commands and the count written by the shader
+    GLCall(glMemoryBarrier(GL_COMMAND_BARRIER_BIT));
+
+    m_Stats.Commands += count; 
+}
+
+void IndirectRenderer::CullOnCPU(const ViewRect& view)
+{
+    auto start = chrono::steady_clock::now(); 
+    m_Visible.resize(m_Culler.GetPaddedCount()); 
+    unsigned int visible = m_Culler.Cull(view, m_Visible.data()); 
+
+    //neighbours drawing the same mesh become one instanced command
+    m_Commands.clear(); 
+    for (unsigned int i = 0; i < visible; i++)
+    { 
+        unsigned int object = m_Visible[i]; 
+        unsigned int mesh = m_CullObjects[object].Mesh; 
+        if (!m_Commands.empty())
+        { 
+            DrawElementsIndirectCommand& last = m_Commands.back(); 
+            if (last.BaseInstance + last.InstanceCount == object && m_CullObjects[last.BaseInstance].Mesh == mesh)
+            { 
+                last.InstanceCount++; 
+                continue; 
+            }
+        }
+        const MeshPool::Range& range = m_Meshes.Get(mesh); 
+        m_Commands.push_back({ range.IndexCount, 1, range.FirstIndex, range.BaseVertex, object }); 
+    }
+
+    m_Stats.Commands += (unsigned int)m_Commands.size(); 
+    m_Stats.CullMs += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(); 
+}
+
+void IndirectRenderer::Draw(const ViewRect& view, Shader& shader)
+{
+    unsigned int count = GetCount(); 
+    m_Stats.Objects += count; 
+    if (!count)
+        return; 
+
+    m_Objects.Upload(); 
+    if (m_Path == Path::GPUCull)
+        CullOnGPU(view); 
+    else
+        CullOnCPU(view); 
+
+    shader.Bind(); 
+    m_VertexArray.Bind(); 
+    Submit(); 
+}
+
+void IndirectRenderer::Submit()
+{
+    unsigned int type = m_VertexArray.GetIndexType(); 
+    unsigned int indexSize = IndexBuffer::SizeOf(type); 
+    const unsigned int stride = sizeof(DrawElementsIndirectCommand); 
+
+    switch (m_Path)
+    { 
+        case Path::GPUCull: 
+        { 
+            GLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_CommandBuffer); 
+            if (GLEW_ARB_indirect_parameters)
+            { 
+                //only as many draws as the shader counted
+                GLState::BindBuffer(GL_PARAMETER_BUFFER_ARB, m_CounterBuffer); 
+                GLCall(glMultiDrawElementsIndirectCountARB(GL_TRIANGLES, type, nullptr, 0, GetCount(), stride));
+            }
+            else
+                GLCall(glMultiDrawElementsIndirect(GL_TRIANGLES, type, nullptr, GetCount(), stride));
+            m_Stats.DrawCalls++; 
+            break; 
+        }
+        case Path::MultiDraw: 
+        { 
+            if (m_Commands.empty())
+                break; 
+            unsigned int size = (unsigned int)(m_Commands.size() * stride); 
+            unsigned int offset; 
+            void* commands = m_IndirectStream->Map(size, offset); 
+            memcpy(commands, m_Commands.data(), size); 
+            m_IndirectStream->Unmap(); 
+            m_IndirectStream->Bind(); 
+            GLCall(glMultiDrawElementsIndirect(GL_TRIANGLES, type, (const void*)(size_t)offset, (int)m_Commands.size(), stride));
+            m_IndirectStream->EndFrame(); 
+            m_Stats.DrawCalls++; 
+            break; 
+        }
+        case Path::BaseInstance: 
+            for (const DrawElementsIndirectCommand& command : m_Commands)
+            { 
+                const void* indices = (const void*)(size_t)(command.FirstIndex * indexSize); 
+                GLCall(glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, command.Count, type, indices,
+                    command.InstanceCount, command.BaseVertex, command.BaseInstance));
+            }
+            m_Stats.DrawCalls += (unsigned int)m_Commands.size(); 
+            break; 
+        case Path::Fallback: 
+            //no base instance before 4.2, the instance attributes start at the object instead
+            for (const DrawElementsIndirectCommand& command : m_Commands)
+            { 
+                m_VertexArray.SetBuffer(m_ObjectBinding, m_Objects.GetVertexBuffer(), command.BaseInstance * sizeof(IndirectObject)); 
+                const void* indices = (const void*)(size_t)(command.FirstIndex * indexSize); 
+                GLCall(glDrawElementsInstancedBaseVertex(GL_TRIANGLES, command.Count, type, indices,
+                    command.InstanceCount, command.BaseVertex));
+            }
+            m_Stats.DrawCalls += (unsigned int)m_Commands.size(); 
+            break; 
+    }
+}
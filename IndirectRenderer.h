@@ -0,0 +1,173 @@
+#pragma once
+
+#include <vector>
+
+#include "VertexBufferLayout.h"
+#include "VertexArray.h"
+#include "InstanceBuffer.h"
+#include "Culling.h"
+
+class Shader; 
+class IndexBuffer; 
+class StreamBuffer; 
+
+//what glMultiDrawElementsIndirect reads for each draw
+struct DrawElementsIndirectCommand
+{ 
+	unsigned int Count; 
+	unsigned int InstanceCount; 
+	unsigned int FirstIndex; 
+	int BaseVertex; 
+	unsigned int BaseInstance; 
+}; 
+
+//Many meshes of one vertex layout packed into a single vertex and a single
+//index buffer, so they can all be drawn from one vertex array. Indices stay
+//relative to their mesh and the draw adds the base vertex, which keeps them
+//16-bit as long as every mesh on its own fits.
+class MeshPool
+{ 
+public: 
+	struct Range
+	{ 
+		unsigned int FirstIndex; 
+		unsigned int IndexCount; 
+		int BaseVertex; 
+		unsigned int VertexCount; 
+	}; 
+private: 
+	VertexBufferLayout m_Layout; 
+	std::vector<unsigned char> m_Vertices; 
+	std::vector<unsigned int> m_Indices; 
+	std::vector<Range> m_Meshes; 
+	VertexBuffer* m_VertexBuffer; 
+	IndexBuffer* m_IndexBuffer; 
+public: 
+	MeshPool(const VertexBufferLayout& layout); 
+	~MeshPool(); 
+
+	MeshPool(const MeshPool&) = delete; 
+	MeshPool& operator=(const MeshPool&) = delete; 
+
+	//only before Upload, returns the mesh index
+	unsigned int Add(const void* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount); 
+	//creates the GL buffers and drops the CPU copies
+	void Upload(); 
+
+	inline const Range& Get(unsigned int mesh) const { return m_Meshes[mesh]; }
+	inline unsigned int GetCount() const { return (unsigned int)m_Meshes.size(); }
+	inline const VertexBufferLayout& GetLayout() const { return m_Layout; }
+	inline const VertexBuffer& GetVertexBuffer() const { return *m_VertexBuffer; }
+	inline const IndexBuffer& GetIndexBuffer() const { return *m_IndexBuffer; }
+}; 
+
+//per-object attributes on the locations after the mesh's, 1 and 2 for the
+//Float2 meshes of Instanced.shader
+struct IndirectObject
+{ 
+	Float4 Transform; 
+	UNorm8x4 Color; 
+}; 
+
+template<> struct VertexFormat<IndirectObject> : VertexAttributes<Float4, UNorm8x4> {}; 
+
+//Draws objects that are each an instance of one mesh of a MeshPool with as
+//few calls as the context allows. A visible object becomes a
+//DrawElementsIndirectCommand whose base instance is the object's index, so
+//its attributes come out of the instance buffer and no uniform changes
+//between draws. From best to worst:
+//
+//  GPUCull       4.3 and a cull shader: a compute pass culls and writes the
+//                commands compacted, one glMultiDrawElementsIndirect
+//  MultiDraw     culled on the CPU, the commands are streamed to the GPU,
+//                one glMultiDrawElementsIndirect
+//  BaseInstance  4.2, culled on the CPU, one draw call per command
+//  Fallback      4.1, culled on the CPU, the instance binding is moved to
+//                the object before each draw
+//
+//The CPU paths merge visible neighbours of the same mesh into one instanced
+//command.
+class IndirectRenderer
+{ 
+public: 
+	enum class Path { GPUCull, MultiDraw, BaseInstance, Fallback }; 
+
+	struct Stats
+	{ 
+		unsigned int Objects = 0; 
+		//every object on the GPU path, where the culled count stays on the GPU
+		unsigned int Commands = 0; 
+		unsigned int DrawCalls = 0; 
+		double CullMs = 0.0; 
+	}; 
+private: 
+	//std430 layouts of Cull.shader
+	struct CullObject
+	{ 
+		float Bounds[4]; 
+		unsigned int Mesh; 
+		unsigned int Padding[3]; 
+	}; 
+
+	struct CullMesh
+	{ 
+		unsigned int Count; 
+		unsigned int FirstIndex; 
+		int BaseVertex; 
+		unsigned int Padding; 
+	}; 
+
+	const MeshPool& m_Meshes; 
+	unsigned int m_Capacity; 
+	VertexArray m_VertexArray; 
+	InstanceBuffer m_Objects; 
+	unsigned int m_ObjectBinding; 
+	std::vector<CullObject> m_CullObjects; 
+	Culler m_Culler; 
+	std::vector<unsigned int> m_Visible; 
+	std::vector<DrawElementsIndirectCommand> m_Commands; 
+	Path m_Path; 
+	Stats m_Stats; 
+
+	Shader* m_CullShader; 
+	int m_ViewHandle; 
+	int m_CountHandle; 
+	unsigned int m_CullObjectBuffer; 
+	unsigned int m_MeshBuffer; 
+	unsigned int m_CommandBuffer; 
+	unsigned int m_CounterBuffer; 
+	bool m_CullObjectsDirty; 
+	StreamBuffer* m_IndirectStream; 
+
+	bool IsSupported(Path path) const; 
+	void CreateGPUBuffers(); 
+	void CullOnGPU(const ViewRect& view); 
+	void CullOnCPU(const ViewRect& view); 
+	void Submit(); 
+public: 
+	//the cull shader is res/shaders/Cull.shader, without one the culling stays on the CPU
+	IndirectRenderer(const MeshPool& meshes, unsigned int capacity, Shader* cullShader = nullptr); 
+	~IndirectRenderer(); 
+
+	IndirectRenderer(const IndirectRenderer&) = delete; 
+	IndirectRenderer& operator=(const IndirectRenderer&) = delete; 
+
+	static const char* GetPathName(Path path); 
+	//false and nothing changes when the context cannot do it
+	bool SetPath(Path path); 
+	inline Path GetPath() const { return m_Path; }
+
+	//bounds are in the space of the view passed to Draw
+	unsigned int Add(unsigned int mesh, const IndirectObject& object, float minX, float minY, float maxX, float maxY); 
+	void Set(unsigned int index, const IndirectObject& object); 
+	void SetBounds(unsigned int index, float minX, float minY, float maxX, float maxY); 
+
+	//draws every object overlapping the view with the given program, GL thread only
+	void Draw(const ViewRect& view, Shader& shader); 
+
+	//call once a frame to get per-frame numbers
+	void ResetStats() { m_Stats = Stats(); }
+
+	inline unsigned int GetCount() const { return (unsigned int)m_CullObjects.size(); }
+	inline const Stats& GetStats() const { return m_Stats; }
+}; 
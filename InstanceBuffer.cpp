@@ -0,0 +1,56 @@
+#include "InstanceBuffer.h"
+#include "Renderer.h"
+
+#include <cstring>
+
+InstanceBuffer::InstanceBuffer(unsigned int stride, unsigned int capacity)
+  : m_Stride(stride), m_Capacity(capacity), m_Count(0),
+    m_Data(stride * capacity),
+    m_DirtyBlocks((capacity + BlockSize - 1) / BlockSize, false),
+    m_VertexBuffer(stride * capacity)
+{
+}
+
+void InstanceBuffer::Set(unsigned int index, const void* instance)
+{
+    ASSERT(index < m_Capacity);
+    memcpy(&m_Data[index * m_Stride], instance, m_Stride); 
+    m_DirtyBlocks[index / BlockSize] = true; 
+    if (index >= m_Count)
+        m_Count = index + 1; 
+}
+
+void InstanceBuffer::SetCount(unsigned int count)
+{
+    ASSERT(count <= m_Capacity);
+    m_Count = count; 
+}
+
+void InstanceBuffer::Upload()
+{
+    unsigned int blocks = (unsigned int)m_DirtyBlocks.size(); 
+    unsigned int block = 0; 
+    while (block < blocks)
+    { 
+        if (!m_DirtyBlocks[block])
+        { 
+            block++; 
+            continue; 
+        }
+
+        //merge neighbouring dirty blocks into one glBufferSubData
+        unsigned int first = block; 
+        while (block < blocks && m_DirtyBlocks[block])
+            m_DirtyBlocks[block++] = false; 
+
+        unsigned int offset = first * BlockSize * m_Stride; 
+        unsigned int end = block * BlockSize; 
+        if (end > m_Capacity)
+            end = m_Capacity; 
+        unsigned int size = end * m_Stride - offset; 
+
+        m_VertexBuffer.UpdateData(&m_Data[offset], size, offset); 
+        m_Stats.Uploads++; 
+        m_Stats.BytesUploaded += size; 
+    }
+}
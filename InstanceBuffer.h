@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+#include "VertexBuffer.h"
+
+//Per-instance attribute stream. A CPU copy of every instance is kept and
+//changed instances mark their block dirty; Upload() then sends only the dirty
+//blocks, merged into contiguous runs, so the per-frame cost follows what
+//changed rather than how many instances there are.
+class InstanceBuffer
+{ 
+public: 
+	static const unsigned int BlockSize = 256; 
+
+	struct Stats
+	{ 
+		unsigned int Uploads = 0; 
+		unsigned int BytesUploaded = 0; 
+	}; 
+private: 
+	unsigned int m_Stride; 
+	unsigned int m_Capacity; 
+	unsigned int m_Count; 
+	std::vector<unsigned char> m_Data; 
+	std::vector<bool> m_DirtyBlocks; 
+	VertexBuffer m_VertexBuffer; 
+	Stats m_Stats; 
+public: 
+	InstanceBuffer(unsigned int stride, unsigned int capacity); 
+
+	void Set(unsigned int index, const void* instance); 
+	template<typename Instance>
+	void Set(unsigned int index, const Instance& instance) { Set(index, (const void*)&instance); }
+
+	template<typename Instance>
+	const Instance& Get(unsigned int index) const { return *(const Instance*)&m_Data[index * m_Stride]; }
+
+	void SetCount(unsigned int count); 
+	void Upload(); 
+
+	//call once a frame to get per-frame numbers
+	void ResetStats() { m_Stats = Stats(); }
+
+	inline const VertexBuffer& GetVertexBuffer() const { return m_VertexBuffer; }
+	inline unsigned int GetCount() const { return m_Count; }
+	inline unsigned int GetCapacity() const { return m_Capacity; }
+	inline const Stats& GetStats() const { return m_Stats; }
+}; 
@@ -0,0 +1,151 @@
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+#include <string>
+#include <cmath>
+
+#include "Renderer.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "ShaderCache.h"
+#include "VertexArray.h"
+#include "InstanceBuffer.h"
+#include "Shader.h"
+#include "Context.h"
+
+using namespace std; 
+
+//per-instance data, x/y/scale/rotation and a packed color
+struct ShapeInstance
+{ 
+    Float4 Transform; 
+    UNorm8x4 Color; 
+}; 
+
+template<> struct VertexFormat<ShapeInstance> : VertexAttributes<Float4, UNorm8x4> {}; 
+
+int main(void)
+{
+    GLFWwindow* window;
+
+    /* Initialize the library */
+    if (!glfwInit()){
+        cout << "FAILED TO INITIALIZE GLFW!" << endl; 
+        return -1;
+    }
+
+    //COMMANDS TO GET EVERYTHING RUNNING WITH MAC
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#if GL_CHECK_LEVEL != GL_CHECK_OFF
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+#endif
+    
+    /* Create a windowed mode window and its OpenGL context */
+    window = glfwCreateWindow(640, 480, "Instanced", NULL, NULL);
+    if (!window)    
+    {
+        cout << "FAILED TO CREATE WINDOW!" << endl; 
+        glfwTerminate();
+        return -1;
+    }
+
+    /* Make the window's context current */
+    glfwMakeContextCurrent(window);
+
+    //no vsync, we want to see what instancing can push
+    glfwSwapInterval(0);
+
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK)
+        cout << "FAILED TO INITIALIZE GLEW!" <<  endl; 
+    
+    //errors are reported by the driver callback when KHR_debug is there
+    GLInitDebugOutput(); 
+
+    //print open gl versions
+    cout << glGetString(GL_VERSION) << endl; 
+
+    {
+    ShaderCache shaderCache; 
+    Shader shader(shaderCache.Load("res/shaders/Instanced.shader"));
+    shaderCache.PrintStats(); 
+
+    //one small quad, shared by every instance
+    Float2 positions[] = { 
+       { -0.5f, -0.5f }, 
+       {  0.5f, -0.5f }, 
+       {  0.5f,  0.5f }, 
+       { -0.5f,  0.5f }, 
+    }; 
+    unsigned int indices[] = { 0, 1, 2, 2, 3, 0 };
+
+    VertexArray va; 
+    VertexBuffer vb(positions, sizeof(positions));
+    va.AddBuffer<Float2>(vb); 
+    IndexBuffer ib(indices, 6); 
+    va.SetIndexBuffer(ib); 
+
+    //1000 x 1000 grid of instances
+    const unsigned int side = 1000; 
+    const unsigned int count = side * side; 
+    InstanceBuffer instances(sizeof(ShapeInstance), count); 
+    va.AddBuffer<ShapeInstance>(instances.GetVertexBuffer(), 1); 
+
+    const float cell = 2.0f / side; 
+    for (unsigned int i = 0; i < count; i++)
+    { 
+        ShapeInstance instance; 
+        instance.Transform = { { -1.0f + (i % side + 0.5f) * cell, -1.0f + (i / side + 0.5f) * cell, cell * 0.8f, 0.0f } }; 
+        instance.Color = { { (unsigned char)(i % side * 255 / side), (unsigned char)(i / side * 255 / side), 200, 255 } }; 
+        instances.Set(i, instance); 
+    }
+
+    Renderer renderer; 
+    unsigned int frame = 0; 
+    double lastReport = glfwGetTime(); 
+    unsigned int frames = 0; 
+    /* Loop until the user closes the window */
+    while (!glfwWindowShouldClose(window))
+    {
+        renderer.Clear(); 
+
+        //spin one row per frame, only that row gets uploaded
+        unsigned int row = frame % side; 
+        for (unsigned int x = 0; x < side; x++)
+        { 
+            ShapeInstance instance = instances.Get<ShapeInstance>(row * side + x); 
+            instance.Transform[3] += 0.5f; 
+            instances.Set(row * side + x, instance); 
+        }
+        instances.ResetStats(); 
+        instances.Upload(); 
+
+        renderer.DrawInstanced(va, ib, shader, instances.GetCount()); 
+        frame++; 
+        frames++; 
+
+        double now = glfwGetTime(); 
+        if (now - lastReport >= 1.0)
+        { 
+            cout << frames / (now - lastReport) << " fps, " << instances.GetCount() << " instances in 1 draw call, "
+                 << instances.GetStats().BytesUploaded << " bytes uploaded in "
+                 << instances.GetStats().Uploads << " ranges last frame" << endl; 
+            lastReport = now; 
+            frames = 0; 
+        }
+
+        /* Swap front and back buffers */
+        Context::SwapWindow(window); 
+
+        /* Poll for and process events */
+        glfwPollEvents();
+    }
+    }
+    Context::Terminate(); 
+    return 0;
+}
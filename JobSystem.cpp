@@ -0,0 +1,140 @@
+#include "JobSystem.h"
+
+JobSystem::JobSystem(unsigned int threads)
+  : m_Running(true), m_Queued(0), m_NextQueue(0)
+{
+    if (threads == 0)
+    { 
+        unsigned int cores = std::thread::hardware_concurrency(); 
+        threads = cores > 1 ? cores - 1 : 1; 
+    }
+
+    for (unsigned int i = 0; i < threads + 1; i++)
+        m_Queues.push_back(new Queue()); 
+    for (unsigned int i = 0; i < threads; i++)
+        m_Threads.emplace_back(&JobSystem::WorkerLoop, this, i); 
+}
+
+JobSystem::~JobSystem()
+{
+    { 
+        std::lock_guard<std::mutex> lock(m_SleepMutex); 
+        m_Running = false; 
+    }
+    m_Wake.notify_all(); 
+    for (std::thread& thread : m_Threads)
+        thread.join(); 
+    for (Queue* queue : m_Queues)
+        delete queue; 
+}
+
+bool JobSystem::Push(unsigned int index, const Job& job)
+{
+    Queue& queue = *m_Queues[index]; 
+    std::lock_guard<std::mutex> lock(queue.Mutex); 
+    if (queue.Tail - queue.Head == QueueSize)
+        return false; 
+    queue.Jobs[queue.Tail % QueueSize] = job; 
+    queue.Tail++; 
+    return true; 
+}
+
+bool JobSystem::PopOwn(unsigned int index, Job& job)
+{
+    //newest first, its data is most likely still in cache
+    Queue& queue = *m_Queues[index]; 
+    std::lock_guard<std::mutex> lock(queue.Mutex); 
+    if (queue.Tail == queue.Head)
+        return false; 
+    queue.Tail--; 
+    job = queue.Jobs[queue.Tail % QueueSize]; 
+    return true; 
+}
+
+bool JobSystem::Steal(unsigned int thief, Job& job)
+{
+    unsigned int count = (unsigned int)m_Queues.size(); 
+    for (unsigned int i = 1; i < count; i++)
+    { 
+        Queue& queue = *m_Queues[(thief + i) % count]; 
+        std::lock_guard<std::mutex> lock(queue.Mutex); 
+        if (queue.Tail == queue.Head)
+            continue; 
+        //oldest first, the owner works from the other end
+        job = queue.Jobs[queue.Head % QueueSize]; 
+        queue.Head++; 
+        return true; 
+    }
+    return false; 
+}
+
+bool JobSystem::RunOne(unsigned int worker)
+{
+    Job job; 
+    if (!PopOwn(worker, job) && !Steal(worker, job))
+        return false; 
+
+    m_Queued.fetch_sub(1, std::memory_order_relaxed); 
+    job.Function(job.Context, job.Begin, job.End, worker); 
+    job.Counter->Pending.fetch_sub(1, std::memory_order_release); 
+    return true; 
+}
+
+void JobSystem::WorkerLoop(unsigned int worker)
+{
+    while (true)
+    { 
+        if (RunOne(worker))
+            continue; 
+
+        std::unique_lock<std::mutex> lock(m_SleepMutex); 
+        m_Wake.wait(lock, [this] { return !m_Running || m_Queued.load(std::memory_order_relaxed) > 0; }); 
+        if (!m_Running)
+            return; 
+    }
+}
+
+void JobSystem::Dispatch(unsigned int count, unsigned int chunkSize, JobFunction function, void* context, JobCounter& counter)
+{
+    if (chunkSize == 0)
+        chunkSize = 1; 
+    unsigned int caller = GetThreadCount() - 1; 
+
+    for (unsigned int begin = 0; begin < count; begin += chunkSize)
+    { 
+        Job job; 
+        job.Function = function; 
+        job.Context = context; 
+        job.Begin = begin; 
+        job.End = begin + chunkSize < count ? begin + chunkSize : count; 
+        job.Counter = &counter; 
+        counter.Pending.fetch_add(1, std::memory_order_relaxed); 
+
+        //spread over the workers, run it right here if every queue is full
+        m_Queued.fetch_add(1, std::memory_order_relaxed); 
+        bool queued = false; 
+        for (unsigned int tries = 0; tries < m_Queues.size() && !queued; tries++)
+            queued = Push(m_NextQueue++ % m_Queues.size(), job); 
+        if (!queued)
+        { 
+            m_Queued.fetch_sub(1, std::memory_order_relaxed); 
+            function(context, job.Begin, job.End, caller); 
+            counter.Pending.fetch_sub(1, std::memory_order_release); 
+        }
+    }
+
+    { 
+        std::lock_guard<std::mutex> lock(m_SleepMutex); 
+    }
+    m_Wake.notify_all(); 
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    unsigned int caller = GetThreadCount() - 1; 
+    while (!counter.IsDone())
+    { 
+        if (!RunOne(caller))
+            std::this_thread::yield(); 
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <vector>
+
+//Counts the jobs of one dispatch that have not finished yet.
+struct JobCounter
+{ 
+	std::atomic<unsigned int> Pending { 0 }; 
+
+	inline bool IsDone() const { return Pending.load(std::memory_order_acquire) == 0; }
+}; 
+
+//Fixed pool of worker threads, each with its own job queue. Workers take
+//jobs from the back of their own queue and steal from the front of the
+//others when it runs dry, so uneven chunks still keep every core busy.
+//Jobs are plain function pointers plus a context, queues are fixed size
+//rings, so dispatching never allocates.
+class JobSystem
+{ 
+public: 
+	typedef void (*JobFunction)(void* context, unsigned int begin, unsigned int end, unsigned int worker); 
+
+	static const unsigned int QueueSize = 1024; 
+private: 
+	struct Job
+	{ 
+		JobFunction Function; 
+		void* Context; 
+		unsigned int Begin; 
+		unsigned int End; 
+		JobCounter* Counter; 
+	}; 
+
+	struct Queue
+	{ 
+		std::mutex Mutex; 
+		Job Jobs[QueueSize]; 
+		unsigned int Head = 0; 
+		unsigned int Tail = 0; 
+	}; 
+
+	std::vector<std::thread> m_Threads; 
+	//one per worker plus one for the thread that dispatches
+	std::vector<Queue*> m_Queues; 
+	std::atomic<bool> m_Running; 
+	std::atomic<unsigned int> m_Queued; 
+	std::mutex m_SleepMutex; 
+	std::condition_variable m_Wake; 
+	unsigned int m_NextQueue; 
+
+	bool Push(unsigned int queue, const Job& job); 
+	bool PopOwn(unsigned int queue, Job& job); 
+	bool Steal(unsigned int thief, Job& job); 
+	bool RunOne(unsigned int worker); 
+	void WorkerLoop(unsigned int worker); 
+public: 
+	//0 picks one thread less than there are cores, the dispatching thread works too
+	JobSystem(unsigned int threads = 0); 
+	~JobSystem(); 
+
+	JobSystem(const JobSystem&) = delete; 
+	JobSystem& operator=(const JobSystem&) = delete; 
+
+	//splits [0, count) into chunks of chunkSize and queues one job per chunk
+	void Dispatch(unsigned int count, unsigned int chunkSize, JobFunction function, void* context, JobCounter& counter); 
+	//runs jobs on the calling thread until the counter drops to zero
+	void Wait(JobCounter& counter); 
+
+	template<typename F>
+	void ParallelFor(unsigned int count, unsigned int chunkSize, F& function, JobCounter& counter)
+	{ 
+		Dispatch(count, chunkSize, [](void* context, unsigned int begin, unsigned int end, unsigned int worker)
+		{ 
+			(*(F*)context)(begin, end, worker); 
+		}, &function, counter); 
+	}
+
+	//workers plus the dispatching thread, index of the latter is GetThreadCount() - 1
+	inline unsigned int GetThreadCount() const { return (unsigned int)m_Queues.size(); }
+}; 
@@ -1,7 +1,688 @@
-#include <iostream>
+#include "Log.h"
 
-void Log(const char* message){ 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
-	std::cout << message << std::endl; 
+using namespace std; 
 
-}
\ No newline at end of file
+static_assert(sizeof(Logger::Record) == Logger::RecordSize, "Record does not fill its slot"); 
+
+const unsigned int Logger::RecordSize; 
+const unsigned int Logger::RingSize; 
+
+std::atomic<int> Logger::s_Level(LOG_LEVEL); 
+
+//identical messages seen recently by one thread, direct mapped by hash
+struct RateEntry
+{
+    const LogSite* Site; 
+    unsigned long long Hash; 
+    unsigned long long WindowStart; 
+    unsigned int Count; 
+    unsigned int Suppressed; 
+}; 
+
+static const unsigned int RateTableSize = 64; 
+static const unsigned long long RateWindow = 1000000000ull; 
+//for the suppressed count of an entry pushed out of the rate table by another message
+static const LogSite s_EvictedSite = { LogLevel::Warn, __FILE__, __LINE__, "{} repeats of the message from {}:{} were dropped by the rate limit" }; 
+
+//single producer, single consumer: the owning thread moves Head, the writer moves Tail
+struct LogRing
+{
+    Logger::Record Slots[Logger::RingSize]; 
+    alignas(64) std::atomic<unsigned int> Head; 
+    alignas(64) std::atomic<unsigned int> Tail; 
+    //only touched by the owning thread, read by GetStats
+    alignas(64) std::atomic<unsigned long long> Dropped; 
+    std::atomic<unsigned long long> Suppressed; 
+    std::atomic<bool> Retired; 
+    unsigned int Thread; 
+    RateEntry Rate[RateTableSize]; 
+}; 
+
+//plain pointers, so they can still be read after the thread's destructors ran
+static thread_local LogRing* t_Ring = nullptr; 
+static thread_local bool t_RingRetired = false; 
+
+//marks the ring for the writer to free once the thread is gone, whatever the
+//thread logs after that is dropped
+struct RingOwner
+{
+    bool Owns = false; 
+    ~RingOwner()
+    {
+        if (!t_Ring)
+            return; 
+        t_Ring->Retired.store(true, memory_order_release); 
+        t_Ring = nullptr; 
+        t_RingRetired = true; 
+    }
+}; 
+
+static thread_local RingOwner t_RingOwner; 
+
+static mutex s_RingsMutex; 
+static vector<LogRing*> s_Rings; 
+static unsigned int s_NextThread = 0; 
+//of rings already freed
+static unsigned long long s_RetiredDropped = 0; 
+static unsigned long long s_RetiredSuppressed = 0; 
+
+static thread s_Writer; 
+static atomic<bool> s_Running(false); 
+//set once by Shutdown, the writer never starts again
+static atomic<bool> s_ShutDown(false); 
+static mutex s_WakeMutex; 
+static condition_variable s_Wake; 
+static atomic<bool> s_WakePending(false); 
+
+//everything below belongs to whoever holds s_DrainMutex
+static mutex s_DrainMutex; 
+static vector<LogRing*> s_DrainRings; 
+//where each ring's drained records end
+static vector<unsigned int> s_DrainHeads; 
+//formatted straight out of the rings, their slots are only given back after
+static vector<const Logger::Record*> s_Batch; 
+static string s_Text; 
+static string s_Binary; 
+static FILE* s_TextOutput = stderr; 
+static FILE* s_BinaryOutput = nullptr; 
+static unordered_map<const LogSite*, unsigned int> s_SiteIds; 
+static atomic<unsigned long long> s_Written(0); 
+
+static const chrono::steady_clock::time_point s_Start = chrono::steady_clock::now(); 
+
+static const char s_BinaryMagic[4] = { 'L', 'O', 'G', 'B' }; 
+static const unsigned int s_BinaryVersion = 1; 
+enum BinaryEntry : unsigned char { SiteEntry = 1, RecordEntry = 2 }; 
+
+static void Drain(); 
+
+static void WriterLoop()
+{
+    unique_lock<mutex> lock(s_WakeMutex); 
+    while (s_Running.load(memory_order_relaxed))
+    {
+        //producers never block on this, a missed wake up only costs the timeout
+        s_Wake.wait_for(lock, chrono::milliseconds(5)); 
+        s_WakePending.store(false, memory_order_relaxed); 
+        lock.unlock(); 
+        Drain(); 
+        lock.lock(); 
+    }
+}
+
+//false once shut down, also during static destruction when the mutex may be gone
+static bool StartWriter()
+{
+    if (s_ShutDown.load(memory_order_acquire))
+        return false; 
+    lock_guard<mutex> lock(s_RingsMutex); 
+    if (s_ShutDown.load(memory_order_relaxed))
+        return false; 
+    if (!s_Running.load(memory_order_relaxed))
+    {
+        s_Running.store(true, memory_order_relaxed); 
+        s_Writer = thread(WriterLoop); 
+    }
+    return true; 
+}
+
+static LogRing* RegisterThread()
+{
+    LogRing* ring = new LogRing(); 
+    ring->Head.store(0, memory_order_relaxed); 
+    ring->Tail.store(0, memory_order_relaxed); 
+    ring->Dropped.store(0, memory_order_relaxed); 
+    ring->Suppressed.store(0, memory_order_relaxed); 
+    ring->Retired.store(false, memory_order_relaxed); 
+    memset(ring->Rate, 0, sizeof(ring->Rate)); 
+    {
+        lock_guard<mutex> lock(s_RingsMutex); 
+        ring->Thread = s_NextThread++; 
+        s_Rings.push_back(ring); 
+    }
+    t_Ring = ring; 
+    t_RingOwner.Owns = true; 
+    return ring; 
+}
+
+static inline unsigned long long Now()
+{
+    return (unsigned long long)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - s_Start).count(); 
+}
+
+//over the call site and the encoded arguments, eight bytes at a time since
+//this runs for every message
+static inline unsigned long long HashMessage(const LogSite* site, const unsigned char* args, unsigned int size)
+{
+    unsigned long long hash = 14695981039346656037ull ^ (unsigned long long)(size_t)site ^ size; 
+    unsigned int i = 0; 
+    for (; i + 8 <= size; i += 8)
+    {
+        unsigned long long word; 
+        memcpy(&word, args + i, sizeof(word)); 
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull; 
+        hash ^= hash >> 29; 
+    }
+    unsigned long long tail = 0; 
+    memcpy(&tail, args + i, size - i); 
+    hash = (hash ^ tail) * 0x9E3779B97F4A7C15ull; 
+    return hash ^ (hash >> 32); 
+}
+
+static const char s_Truncated[] = "...(truncated)"; 
+static const size_t s_TruncatedLength = sizeof(s_Truncated) - 1; 
+
+void LogArgWriter::PutString(const char* value, size_t length)
+{
+    size_t room = End - Position; 
+    if (room < 1 + sizeof(unsigned short) + s_TruncatedLength)
+    {
+        Position = End; 
+        return; 
+    }
+    room -= 1 + sizeof(unsigned short); 
+    //but never more than half of what is left to a later argument
+    room -= Reserve < room / 2 ? Reserve : room / 2; 
+    if (room < s_TruncatedLength)
+        room = s_TruncatedLength; 
+    if (room > 0xffff)
+        room = 0xffff; 
+    bool cut = length > room; 
+    unsigned short size = (unsigned short)(cut ? room : length); 
+    *Position++ = (unsigned char)LogArgType::String; 
+    memcpy(Position, &size, sizeof(size)); 
+    Position += sizeof(size); 
+    if (cut)
+    {
+        memcpy(Position, value, size - s_TruncatedLength); 
+        memcpy(Position + size - s_TruncatedLength, s_Truncated, s_TruncatedLength); 
+    }
+    else
+        memcpy(Position, value, size); 
+    Position += size; 
+}
+
+Logger::Record* Logger::BeginRecord(size_t argBytes)
+{
+    if (!s_Running.load(memory_order_relaxed) && !StartWriter())
+        return nullptr; 
+    LogRing* ring = t_Ring; 
+    if (!ring)
+    {
+        //the thread is exiting and its ring is the writer's to free
+        if (t_RingRetired)
+            return nullptr; 
+        ring = RegisterThread(); 
+    }
+
+    size_t bytes = offsetof(Record, Args) + argBytes; 
+    unsigned int slots = (unsigned int)((bytes + RecordSize - 1) / RecordSize); 
+    if (slots > MaxRecordSlots)
+        slots = MaxRecordSlots; 
+
+    //the slots of a record are contiguous, one that would wrap starts over at the front
+    unsigned int head = ring->Head.load(memory_order_relaxed); 
+    unsigned int index = head % RingSize; 
+    unsigned int filler = index + slots > RingSize ? RingSize - index : 0; 
+    if (head - ring->Tail.load(memory_order_acquire) + filler + slots > RingSize)
+    {
+        //the writer is behind, losing a message beats stalling the frame
+        ring->Dropped.store(ring->Dropped.load(memory_order_relaxed) + 1, memory_order_relaxed); 
+        return nullptr; 
+    }
+    if (filler)
+    {
+        ring->Slots[index].Site = nullptr; 
+        ring->Slots[index].Slots = (unsigned short)filler; 
+        head += filler; 
+        ring->Head.store(head, memory_order_release); 
+    }
+    Record* record = &ring->Slots[head % RingSize]; 
+    record->Slots = (unsigned short)slots; 
+    return record; 
+}
+
+void Logger::CommitRecord(Record* record, const LogSite* site, unsigned int argBytes)
+{
+    LogRing* ring = t_Ring; 
+    unsigned long long now = Now(); 
+    record->Site = site; 
+    record->Time = now; 
+    record->Thread = ring->Thread; 
+    record->ArgBytes = (unsigned short)argBytes; 
+
+    unsigned long long hash = HashMessage(site, record->GetArgs(), argBytes); 
+    RateEntry& entry = ring->Rate[hash % RateTableSize]; 
+    const LogSite* evicted = nullptr; 
+    unsigned int evictedCount = 0; 
+    if (entry.Hash != hash || now - entry.WindowStart >= RateWindow)
+    {
+        record->Suppressed = entry.Hash == hash ? entry.Suppressed : 0; 
+        if (entry.Hash != hash && entry.Suppressed)
+        {
+            evicted = entry.Site; 
+            evictedCount = entry.Suppressed; 
+        }
+        entry.Site = site; 
+        entry.Hash = hash; 
+        entry.WindowStart = now; 
+        entry.Count = 1; 
+        entry.Suppressed = 0; 
+    }
+    else if (entry.Count >= LOG_RATE_LIMIT)
+    {
+        entry.Suppressed++; 
+        ring->Suppressed.store(ring->Suppressed.load(memory_order_relaxed) + 1, memory_order_relaxed); 
+        return; 
+    }
+    else
+    {
+        entry.Count++; 
+        record->Suppressed = entry.Suppressed; 
+        entry.Suppressed = 0; 
+    }
+
+    unsigned int head = ring->Head.load(memory_order_relaxed) + record->Slots; 
+    ring->Head.store(head, memory_order_release); 
+    //more than half full, do not wait for the timeout
+    if (head - ring->Tail.load(memory_order_relaxed) > RingSize / 2 && !s_WakePending.exchange(true, memory_order_relaxed))
+        s_Wake.notify_one(); 
+
+    //the evicted message may never come again to carry its count
+    if (evictedCount)
+        Write(&s_EvictedSite, evictedCount, evicted->File, evicted->Line); 
+}
+
+static void AppendArg(const unsigned char*& args, const unsigned char* end, string& out)
+{
+    char buffer[64]; 
+    LogArgType type = (LogArgType)*args++; 
+    switch (type)
+    {
+        case LogArgType::Int:
+        {
+            int value; 
+            memcpy(&value, args, sizeof(value)); 
+            args += sizeof(value); 
+            snprintf(buffer, sizeof(buffer), "%d", value); 
+            break; 
+        }
+        case LogArgType::UInt:
+        {
+            unsigned int value; 
+            memcpy(&value, args, sizeof(value)); 
+            args += sizeof(value); 
+            snprintf(buffer, sizeof(buffer), "%u", value); 
+            break; 
+        }
+        case LogArgType::Int64:
+        {
+            long long value; 
+            memcpy(&value, args, sizeof(value)); 
+            args += sizeof(value); 
+            snprintf(buffer, sizeof(buffer), "%lld", value); 
+            break; 
+        }
+        case LogArgType::UInt64:
+        {
+            unsigned long long value; 
+            memcpy(&value, args, sizeof(value)); 
+            args += sizeof(value); 
+            snprintf(buffer, sizeof(buffer), "%llu", value); 
+            break; 
+        }
+        case LogArgType::Double:
+        {
+            double value; 
+            memcpy(&value, args, sizeof(value)); 
+            args += sizeof(value); 
+            snprintf(buffer, sizeof(buffer), "%g", value); 
+            break; 
+        }
+        case LogArgType::Pointer:
+        {
+            const void* value; 
+            memcpy(&value, args, sizeof(value)); 
+            args += sizeof(value); 
+            snprintf(buffer, sizeof(buffer), "%p", value); 
+            break; 
+        }
+        case LogArgType::String:
+        {
+            unsigned short size; 
+            memcpy(&size, args, sizeof(size)); 
+            args += sizeof(size); 
+            out.append((const char*)args, size); 
+            args += size; 
+            return; 
+        }
+        default:
+            //not something we wrote, stop reading
+            args = end; 
+            return; 
+    }
+    out += buffer; 
+}
+
+static const char* LevelName(LogLevel level)
+{
+    switch (level)
+    {
+        case LogLevel::Trace: return "TRACE"; 
+        case LogLevel::Debug: return "DEBUG"; 
+        case LogLevel::Info:  return "INFO "; 
+        case LogLevel::Warn:  return "WARN "; 
+        case LogLevel::Error: return "ERROR"; 
+    }
+    return "?????"; 
+}
+
+//one line of text, shared by the writer and DecodeBinary
+static void FormatLine(LogLevel level, const char* file, int line, const char* format, unsigned long long time,
+    unsigned int thread, unsigned int suppressed, const unsigned char* args, unsigned int argBytes, string& out)
+{
+    const char* name = file; 
+    for (const char* c = file; *c; c++)
+        if (*c == '/' || *c == '\\')
+            name = c + 1; 
+
+    char header[128]; 
+    snprintf(header, sizeof(header), "[%12.6f] %s t%u %s:%d ", time / 1e9, LevelName(level), thread, name, line); 
+    out += header; 
+
+    const unsigned char* end = args + argBytes; 
+    for (const char* c = format; *c; c++)
+    {
+        if (c[0] == '{' && c[1] == '}' && args < end)
+        {
+            AppendArg(args, end, out); 
+            c++; 
+        }
+        else
+            out += *c; 
+    }
+    if (suppressed)
+    {
+        char note[64]; 
+        snprintf(note, sizeof(note), " (%u identical messages suppressed)", suppressed); 
+        out += note; 
+    }
+    out += '\n'; 
+}
+
+template<typename T>
+static void AppendBinary(string& out, const T& value)
+{
+    out.append((const char*)&value, sizeof(value)); 
+}
+
+static void AppendBinaryString(string& out, const char* value)
+{
+    unsigned short size = (unsigned short)strlen(value); 
+    AppendBinary(out, size); 
+    out.append(value, size); 
+}
+
+static void WriteBinary(const Logger::Record& record)
+{
+    auto it = s_SiteIds.find(record.Site); 
+    unsigned int id; 
+    if (it != s_SiteIds.end())
+        id = it->second; 
+    else
+    {
+        //a site is described the first time it shows up
+        id = (unsigned int)s_SiteIds.size(); 
+        s_SiteIds[record.Site] = id; 
+        s_Binary += (char)SiteEntry; 
+        AppendBinary(s_Binary, id); 
+        AppendBinary(s_Binary, (unsigned char)record.Site->Level); 
+        AppendBinary(s_Binary, record.Site->Line); 
+        AppendBinaryString(s_Binary, record.Site->File); 
+        AppendBinaryString(s_Binary, record.Site->Format); 
+    }
+    s_Binary += (char)RecordEntry; 
+    AppendBinary(s_Binary, id); 
+    AppendBinary(s_Binary, record.Time); 
+    AppendBinary(s_Binary, record.Thread); 
+    AppendBinary(s_Binary, record.Suppressed); 
+    AppendBinary(s_Binary, record.ArgBytes); 
+    s_Binary.append((const char*)record.GetArgs(), record.ArgBytes); 
+}
+
+static void Drain()
+{
+    lock_guard<mutex> drainLock(s_DrainMutex); 
+    {
+        lock_guard<mutex> lock(s_RingsMutex); 
+        s_DrainRings = s_Rings; 
+    }
+
+    s_Batch.clear(); 
+    s_DrainHeads.clear(); 
+    bool retired = false; 
+    for (LogRing* ring : s_DrainRings)
+    {
+        //checked first, a retired ring gets nothing new after this
+        retired |= ring->Retired.load(memory_order_acquire); 
+        unsigned int tail = ring->Tail.load(memory_order_relaxed); 
+        unsigned int head = ring->Head.load(memory_order_acquire); 
+        while (tail != head)
+        {
+            const Logger::Record& record = ring->Slots[tail % Logger::RingSize]; 
+            if (record.Site)
+                s_Batch.push_back(&record); 
+            tail += record.Slots; 
+        }
+        s_DrainHeads.push_back(head); 
+    }
+
+    //rings are drained one after the other, put the threads back in order
+    stable_sort(s_Batch.begin(), s_Batch.end(), [](const Logger::Record* a, const Logger::Record* b) { return a->Time < b->Time; }); 
+
+    s_Text.clear(); 
+    s_Binary.clear(); 
+    for (const Logger::Record* record : s_Batch)
+    {
+        const LogSite* site = record->Site; 
+        if (s_TextOutput)
+            FormatLine(site->Level, site->File, site->Line, site->Format, record->Time, record->Thread, record->Suppressed,
+                record->GetArgs(), record->ArgBytes, s_Text); 
+        if (s_BinaryOutput)
+            WriteBinary(*record); 
+    }
+    for (size_t i = 0; i < s_DrainRings.size(); i++)
+        s_DrainRings[i]->Tail.store(s_DrainHeads[i], memory_order_release); 
+    //one write per batch instead of one per message
+    if (s_TextOutput && !s_Text.empty())
+    {
+        fwrite(s_Text.data(), 1, s_Text.size(), s_TextOutput); 
+        fflush(s_TextOutput); 
+    }
+    if (s_BinaryOutput && !s_Binary.empty())
+    {
+        fwrite(s_Binary.data(), 1, s_Binary.size(), s_BinaryOutput); 
+        fflush(s_BinaryOutput); 
+    }
+    s_Written.fetch_add(s_Batch.size(), memory_order_relaxed); 
+
+    if (retired)
+    {
+        lock_guard<mutex> lock(s_RingsMutex); 
+        for (size_t i = 0; i < s_Rings.size(); )
+        {
+            LogRing* ring = s_Rings[i]; 
+            bool done = ring->Retired.load(memory_order_acquire) && ring->Head.load(memory_order_acquire) == ring->Tail.load(memory_order_relaxed); 
+            if (!done)
+            {
+                i++; 
+                continue; 
+            }
+            s_RetiredDropped += ring->Dropped.load(memory_order_relaxed); 
+            s_RetiredSuppressed += ring->Suppressed.load(memory_order_relaxed); 
+            delete ring; 
+            s_Rings[i] = s_Rings.back(); 
+            s_Rings.pop_back(); 
+        }
+    }
+}
+
+void Logger::SetTextOutput(FILE* file)
+{
+    Drain(); 
+    lock_guard<mutex> lock(s_DrainMutex); 
+    s_TextOutput = file; 
+}
+
+bool Logger::SetBinaryOutput(const char* path)
+{
+    Drain(); 
+    lock_guard<mutex> lock(s_DrainMutex); 
+    if (s_BinaryOutput)
+        fclose(s_BinaryOutput); 
+    s_BinaryOutput = nullptr; 
+    s_SiteIds.clear(); 
+    if (!path)
+        return true; 
+
+    s_BinaryOutput = fopen(path, "wb"); 
+    if (!s_BinaryOutput)
+        return false; 
+    fwrite(s_BinaryMagic, 1, sizeof(s_BinaryMagic), s_BinaryOutput); 
+    fwrite(&s_BinaryVersion, sizeof(s_BinaryVersion), 1, s_BinaryOutput); 
+    return true; 
+}
+
+bool Logger::DecodeBinary(const char* path, FILE* out)
+{
+    FILE* file = fopen(path, "rb"); 
+    if (!file)
+        return false; 
+    string data; 
+    char chunk[65536]; 
+    size_t read; 
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+        data.append(chunk, read); 
+    fclose(file); 
+
+    unsigned int version = 0; 
+    if (data.size() < 8 || memcmp(data.data(), s_BinaryMagic, 4) != 0)
+        return false; 
+    memcpy(&version, data.data() + 4, sizeof(version)); 
+    if (version != s_BinaryVersion)
+        return false; 
+
+    struct Site
+    {
+        LogLevel Level; 
+        int Line; 
+        string File; 
+        string Format; 
+    }; 
+    vector<Site> sites; 
+    const unsigned char* p = (const unsigned char*)data.data() + 8; 
+    const unsigned char* end = (const unsigned char*)data.data() + data.size(); 
+    auto take = [&](void* value, size_t size) {
+        if ((size_t)(end - p) < size)
+            return false; 
+        memcpy(value, p, size); 
+        p += size; 
+        return true; 
+    }; 
+    auto takeString = [&](string& value) {
+        unsigned short size; 
+        if (!take(&size, sizeof(size)) || (size_t)(end - p) < size)
+            return false; 
+        value.assign((const char*)p, size); 
+        p += size; 
+        return true; 
+    }; 
+
+    string text; 
+    while (p < end)
+    {
+        unsigned char kind = *p++; 
+        unsigned int id; 
+        if (!take(&id, sizeof(id)))
+            return false; 
+        if (kind == SiteEntry)
+        {
+            Site site; 
+            unsigned char level; 
+            if (!take(&level, 1) || !take(&site.Line, sizeof(site.Line)) || !takeString(site.File) || !takeString(site.Format))
+                return false; 
+            site.Level = (LogLevel)level; 
+            if (sites.size() <= id)
+                sites.resize(id + 1); 
+            sites[id] = site; 
+        }
+        else if (kind == RecordEntry)
+        {
+            unsigned long long time; 
+            unsigned int thread, suppressed; 
+            unsigned short argBytes; 
+            if (!take(&time, sizeof(time)) || !take(&thread, sizeof(thread)) || !take(&suppressed, sizeof(suppressed))
+                || !take(&argBytes, sizeof(argBytes)) || (size_t)(end - p) < argBytes || id >= sites.size())
+                return false; 
+            const Site& site = sites[id]; 
+            text.clear(); 
+            FormatLine(site.Level, site.File.c_str(), site.Line, site.Format.c_str(), time, thread, suppressed, p, argBytes, text); 
+            fwrite(text.data(), 1, text.size(), out); 
+            p += argBytes; 
+        }
+        else
+            return false; 
+    }
+    return true; 
+}
+
+void Logger::Flush()
+{
+    Drain(); 
+}
+
+void Logger::Shutdown()
+{
+    {
+        lock_guard<mutex> lock(s_RingsMutex); 
+        s_ShutDown.store(true, memory_order_release); 
+        s_Running.store(false, memory_order_relaxed); 
+    }
+    {
+        lock_guard<mutex> lock(s_WakeMutex); 
+        s_Wake.notify_one(); 
+    }
+    if (s_Writer.joinable())
+        s_Writer.join(); 
+    Drain(); 
+}
+
+Logger::Stats Logger::GetStats()
+{
+    Stats stats; 
+    stats.Written = s_Written.load(memory_order_relaxed); 
+    lock_guard<mutex> lock(s_RingsMutex); 
+    stats.Dropped = s_RetiredDropped; 
+    stats.Suppressed = s_RetiredSuppressed; 
+    for (LogRing* ring : s_Rings)
+    {
+        stats.Dropped += ring->Dropped.load(memory_order_relaxed); 
+        stats.Suppressed += ring->Suppressed.load(memory_order_relaxed); 
+    }
+    return stats; 
+}
+
+//last of the statics in this file, so it goes first at exit and the writer
+//still finds everything it needs
+static struct LoggerExit
+{
+    ~LoggerExit() { Logger::Shutdown(); }
+} s_Exit; 
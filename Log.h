@@ -0,0 +1,236 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+//
+// Asynchronous logging. LOG_ERROR("texture {} is {}x{}", id, w, h) copies the
+// call site and the raw arguments into a ring buffer owned by the calling
+// thread and returns; a background thread formats and writes them. The call
+// never locks, allocates or does I/O, so it is safe in the frame loop; only
+// the first message of each thread allocates its ring and registers it under
+// a lock, log once while loading to have that out of the way.
+//
+// Levels below LOG_LEVEL are compiled out, pick one with -DLOG_LEVEL=n
+//
+// LOG_LEVEL_TRACE 0
+// LOG_LEVEL_DEBUG 1   default in development builds
+// LOG_LEVEL_INFO  2   default with NDEBUG
+// LOG_LEVEL_WARN  3
+// LOG_LEVEL_ERROR 4
+// LOG_LEVEL_OFF   5
+//
+// A message repeated with the same arguments from the same place is written at
+// most LOG_RATE_LIMIT times a second per thread, the next one that gets
+// through says how many were dropped in between. When another message takes
+// its place in the rate table first, a warning reports the count instead.
+// A full ring drops messages rather than waiting. Long arguments, e.g.
+// shader info logs, take several consecutive slots of the ring; beyond
+// MaxRecordSlots they are cut and end in "...(truncated)".
+//
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_WARN  3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_OFF   5
+
+#ifndef LOG_LEVEL
+    #ifdef NDEBUG
+        #define LOG_LEVEL LOG_LEVEL_INFO
+    #else
+        #define LOG_LEVEL LOG_LEVEL_DEBUG
+    #endif
+#endif
+
+#ifndef LOG_RATE_LIMIT
+    #define LOG_RATE_LIMIT 16
+#endif
+
+enum class LogLevel : unsigned char
+{
+	Trace = LOG_LEVEL_TRACE, Debug, Info, Warn, Error
+}; 
+
+//one per LOG_* statement, records point at it instead of copying it
+struct LogSite
+{
+	LogLevel Level; 
+	const char* File; 
+	int Line; 
+	//"{}" marks where the arguments go
+	const char* Format; 
+}; 
+
+enum class LogArgType : unsigned char
+{
+	Int, UInt, Int64, UInt64, Double, String, Pointer
+}; 
+
+//what a record's arguments are encoded into, a string that does not fit is
+//cut and marked
+struct LogArgWriter
+{
+	unsigned char* Position; 
+	unsigned char* End; 
+	//what the arguments after this one need, a cut string leaves them room
+	size_t Reserve; 
+
+	inline void Put(LogArgType type, const void* value, unsigned int size)
+	{
+		if (Position + 1 + size > End)
+		{
+			Position = End; 
+			return; 
+		}
+		*Position++ = (unsigned char)type; 
+		memcpy(Position, value, size); 
+		Position += size; 
+	}
+
+	void PutString(const char* value, size_t length); 
+}; 
+
+inline void LogEncode(LogArgWriter& w, int value) { w.Put(LogArgType::Int, &value, sizeof(value)); }
+inline void LogEncode(LogArgWriter& w, unsigned int value) { w.Put(LogArgType::UInt, &value, sizeof(value)); }
+inline void LogEncode(LogArgWriter& w, long value) { long long v = value; w.Put(LogArgType::Int64, &v, sizeof(v)); }
+inline void LogEncode(LogArgWriter& w, unsigned long value) { unsigned long long v = value; w.Put(LogArgType::UInt64, &v, sizeof(v)); }
+inline void LogEncode(LogArgWriter& w, long long value) { w.Put(LogArgType::Int64, &value, sizeof(value)); }
+inline void LogEncode(LogArgWriter& w, unsigned long long value) { w.Put(LogArgType::UInt64, &value, sizeof(value)); }
+inline void LogEncode(LogArgWriter& w, double value) { w.Put(LogArgType::Double, &value, sizeof(value)); }
+inline void LogEncode(LogArgWriter& w, const char* value) { w.PutString(value ? value : "(null)", value ? strlen(value) : 6); }
+inline void LogEncode(LogArgWriter& w, char* value) { LogEncode(w, (const char*)value); }
+//glGetString and friends
+inline void LogEncode(LogArgWriter& w, const unsigned char* value) { LogEncode(w, (const char*)value); }
+inline void LogEncode(LogArgWriter& w, const std::string& value) { w.PutString(value.c_str(), value.size()); }
+template<typename T>
+inline void LogEncode(LogArgWriter& w, T* value) { const void* v = value; w.Put(LogArgType::Pointer, &v, sizeof(v)); }
+
+//bytes LogEncode writes for an argument, so a record can take enough slots
+inline size_t LogEncodedSize(int) { return 1 + sizeof(int); }
+inline size_t LogEncodedSize(unsigned int) { return 1 + sizeof(unsigned int); }
+inline size_t LogEncodedSize(long) { return 1 + sizeof(long long); }
+inline size_t LogEncodedSize(unsigned long) { return 1 + sizeof(unsigned long long); }
+inline size_t LogEncodedSize(long long) { return 1 + sizeof(long long); }
+inline size_t LogEncodedSize(unsigned long long) { return 1 + sizeof(unsigned long long); }
+inline size_t LogEncodedSize(double) { return 1 + sizeof(double); }
+inline size_t LogEncodedSize(const char* value) { return 1 + sizeof(unsigned short) + (value ? strlen(value) : 6); }
+inline size_t LogEncodedSize(char* value) { return LogEncodedSize((const char*)value); }
+inline size_t LogEncodedSize(const unsigned char* value) { return LogEncodedSize((const char*)value); }
+inline size_t LogEncodedSize(const std::string& value) { return 1 + sizeof(unsigned short) + value.size(); }
+template<typename T>
+inline size_t LogEncodedSize(T*) { return 1 + sizeof(const void*); }
+
+//Owns the per-thread rings and the thread that empties them. Everything is
+//static, the writer thread starts with the first message.
+class Logger
+{
+public:
+	//a record takes one fixed slot of a ring, what is left after the header
+	//holds the arguments; longer arguments run on into the following slots
+	static const unsigned int RecordSize = 256; 
+	static const unsigned int RingSize = 1024; 
+	static const unsigned int MaxRecordSlots = 32; 
+
+	struct Record
+	{
+		//null for the filler that skips to the start of the ring
+		const LogSite* Site; 
+		unsigned long long Time; 
+		unsigned int Thread; 
+		//identical messages dropped by the rate limit since the last one written
+		unsigned int Suppressed; 
+		unsigned short ArgBytes; 
+		unsigned short Slots; 
+		unsigned char Args[RecordSize - 32]; 
+
+		//the arguments may go past Args, into the record's other slots
+		inline unsigned char* GetArgs() { return (unsigned char*)this + offsetof(Record, Args); }
+		inline const unsigned char* GetArgs() const { return (const unsigned char*)this + offsetof(Record, Args); }
+		inline unsigned char* GetArgsEnd() { return (unsigned char*)this + Slots * RecordSize; }
+	}; 
+
+	struct Stats
+	{
+		unsigned long long Written = 0; 
+		//rings were full
+		unsigned long long Dropped = 0; 
+		//by the rate limit
+		unsigned long long Suppressed = 0; 
+	}; 
+private:
+	static std::atomic<int> s_Level; 
+
+	static Record* BeginRecord(size_t argBytes); 
+	static void CommitRecord(Record* record, const LogSite* site, unsigned int argBytes); 
+public:
+	//below the compiled LOG_LEVEL nothing comes through anyway
+	static void SetLevel(LogLevel level) { s_Level.store((int)level, std::memory_order_relaxed); }
+	static inline bool IsEnabled(LogLevel level) { return (int)level >= s_Level.load(std::memory_order_relaxed); }
+
+	template<typename... T>
+	static void Write(const LogSite* site, const T&... args)
+	{
+		size_t sizes[] = { LogEncodedSize(args)..., 0 }; 
+		size_t size = 0; 
+		for (size_t argSize : sizes)
+			size += argSize; 
+		Record* record = BeginRecord(size); 
+		if (!record)
+			return; 
+		LogArgWriter writer = { record->GetArgs(), record->GetArgsEnd(), size }; 
+		unsigned int arg = 0; 
+		int expand[] = { 0, (writer.Reserve -= sizes[arg++], LogEncode(writer, args), 0)... }; 
+		(void)expand; 
+		CommitRecord(record, site, (unsigned int)(writer.Position - record->GetArgs())); 
+	}
+
+	//text goes to stderr unless set, null stops it
+	static void SetTextOutput(FILE* file); 
+	//compact records with the call sites written once, read them with
+	//DecodeBinary (or the LogDump tool); null closes the file
+	static bool SetBinaryOutput(const char* path); 
+	static bool DecodeBinary(const char* path, FILE* out); 
+
+	//writes everything logged so far before returning, e.g. before a crash
+	static void Flush(); 
+	//stops the writer thread after a final flush, anything logged after it is dropped
+	static void Shutdown(); 
+
+	static Stats GetStats(); 
+}; 
+
+#define LOG_WRITE(level, format, ...) do { \
+        static const LogSite _logSite = { level, __FILE__, __LINE__, format }; \
+        if (Logger::IsEnabled(level)) \
+            Logger::Write(&_logSite, ##__VA_ARGS__); \
+    } while (0)
+
+#if LOG_LEVEL <= LOG_LEVEL_TRACE
+    #define LOG_TRACE(format, ...) LOG_WRITE(LogLevel::Trace, format, ##__VA_ARGS__)
+#else
+    #define LOG_TRACE(format, ...) ((void)0)
+#endif
+#if LOG_LEVEL <= LOG_LEVEL_DEBUG
+    #define LOG_DEBUG(format, ...) LOG_WRITE(LogLevel::Debug, format, ##__VA_ARGS__)
+#else
+    #define LOG_DEBUG(format, ...) ((void)0)
+#endif
+#if LOG_LEVEL <= LOG_LEVEL_INFO
+    #define LOG_INFO(format, ...) LOG_WRITE(LogLevel::Info, format, ##__VA_ARGS__)
+#else
+    #define LOG_INFO(format, ...) ((void)0)
+#endif
+#if LOG_LEVEL <= LOG_LEVEL_WARN
+    #define LOG_WARN(format, ...) LOG_WRITE(LogLevel::Warn, format, ##__VA_ARGS__)
+#else
+    #define LOG_WARN(format, ...) ((void)0)
+#endif
+#if LOG_LEVEL <= LOG_LEVEL_ERROR
+    #define LOG_ERROR(format, ...) LOG_WRITE(LogLevel::Error, format, ##__VA_ARGS__)
+#else
+    #define LOG_ERROR(format, ...) ((void)0)
+#endif
@@ -0,0 +1,179 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "Log.h"
+
+using namespace std; 
+
+//Measures what a log statement costs the thread that makes it and prints the
+//nanoseconds per message as JSON, e.g.
+//
+//  ./LogBench --messages 1000000 > log.json
+//
+//Bursts are half a ring long and the rings are flushed between them outside
+//the timing, so nothing is dropped and the numbers are the call site alone.
+//The writer thread goes to /dev/null. ofstream with endl is the old way,
+//for comparison.
+
+static const unsigned int Burst = Logger::RingSize / 2; 
+
+static double Now()
+{
+    return chrono::duration<double, nano>(chrono::steady_clock::now().time_since_epoch()).count(); 
+}
+
+//a typical GL error report
+static double Messages(unsigned int count)
+{
+    double total = 0; 
+    for (unsigned int done = 0; done < count; done += Burst)
+    {
+        double start = Now(); 
+        for (unsigned int i = 0; i < Burst; i++)
+            LOG_ERROR("[OpenGL Error] GL_{} ({}): {} {}:{}", "INVALID_OPERATION", 1282u, "glDrawElements(...)", "Renderer.cpp", (int)(done + i)); 
+        total += Now() - start; 
+        Logger::Flush(); 
+    }
+    return total / count; 
+}
+
+//the same message over and over, all but a few are suppressed
+static double RateLimited(unsigned int count)
+{
+    double start = Now(); 
+    for (unsigned int i = 0; i < count; i++)
+        LOG_ERROR("[OpenGL Error] GL_{} ({}): {} {}:{}", "INVALID_OPERATION", 1282u, "glDrawElements(...)", "Renderer.cpp", 42); 
+    double total = Now() - start; 
+    Logger::Flush(); 
+    return total / count; 
+}
+
+//compiled in but below the level set at runtime
+static double Filtered(unsigned int count)
+{
+    Logger::SetLevel(LogLevel::Error); 
+    double start = Now(); 
+    for (unsigned int i = 0; i < count; i++)
+        LOG_INFO("draw {} of {}", i, count); 
+    double total = Now() - start; 
+    Logger::SetLevel((LogLevel)LOG_LEVEL); 
+    return total / count; 
+}
+
+static double CompiledOut(unsigned int count)
+{
+    double start = Now(); 
+    for (unsigned int i = 0; i < count; i++)
+        LOG_TRACE("draw {} of {}", i, count); 
+    return (Now() - start) / count; 
+}
+
+//every thread times its own bursts, the flushes are shared
+static double Threaded(unsigned int count, unsigned int threadCount)
+{
+    vector<double> totals(threadCount, 0.0); 
+    vector<thread> threads; 
+    for (unsigned int t = 0; t < threadCount; t++)
+        threads.emplace_back([&totals, t, count]() {
+            for (unsigned int done = 0; done < count; done += Burst)
+            {
+                double start = Now(); 
+                for (unsigned int i = 0; i < Burst; i++)
+                    LOG_INFO("thread {} message {}", t, done + i); 
+                totals[t] += Now() - start; 
+                Logger::Flush(); 
+            }
+        }); 
+    for (thread& t : threads)
+        t.join(); 
+    Logger::Flush(); 
+
+    double total = 0; 
+    for (double t : totals)
+        total += t; 
+    return total / ((double)count * threadCount); 
+}
+
+static double Stream(unsigned int count)
+{
+    ofstream out("/dev/null"); 
+    double start = Now(); 
+    for (unsigned int i = 0; i < count; i++)
+        out << "[OpenGL Error] GL_" << "INVALID_OPERATION" << " (" << 1282u << "): " << "glDrawElements(...)" << " " << "Renderer.cpp" << ":" << i << endl; 
+    return (Now() - start) / count; 
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int count = 1000000; 
+    unsigned int threadCount = 4; 
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--messages") && i + 1 < argc)
+            count = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+            threadCount = atoi(argv[++i]); 
+        else
+        {
+            cerr << "usage: LogBench [--messages n] [--threads n]" << endl; 
+            return -1; 
+        }
+    }
+    count = (count + Burst - 1) / Burst * Burst; 
+    if (!count || !threadCount)
+    {
+        cerr << "needs at least one message and one thread" << endl; 
+        return -1; 
+    }
+
+    FILE* devNull = fopen("/dev/null", "w"); 
+    if (!devNull)
+    {
+        cerr << "cannot open /dev/null" << endl; 
+        return -1; 
+    }
+    Logger::SetTextOutput(devNull); 
+
+    //first message of the thread allocates its ring
+    Messages(Burst); 
+
+    double text = Messages(count); 
+    double rateLimited = RateLimited(count); 
+    double filtered = Filtered(count); 
+    double compiledOut = CompiledOut(count); 
+    double threaded = Threaded(count, threadCount); 
+
+    Logger::SetTextOutput(nullptr); 
+    bool binaryOpen = Logger::SetBinaryOutput("/dev/null"); 
+    double binary = binaryOpen ? Messages(count) : 0; 
+    Logger::SetBinaryOutput(nullptr); 
+
+    double stream = Stream(count); 
+
+    Logger::Stats stats = Logger::GetStats(); 
+    cout << "{\n"; 
+    cout << "  \"messages\": " << count << ",\n"; 
+    cout << "  \"threads\": " << threadCount << ",\n"; 
+    cout << "  \"ns_per_message\": {\n"; 
+    cout << "    \"logger_text\": " << text << ",\n"; 
+    cout << "    \"logger_binary\": " << binary << ",\n"; 
+    cout << "    \"logger_rate_limited\": " << rateLimited << ",\n"; 
+    cout << "    \"logger_level_filtered\": " << filtered << ",\n"; 
+    cout << "    \"logger_compiled_out\": " << compiledOut << ",\n"; 
+    cout << "    \"logger_threaded\": " << threaded << ",\n"; 
+    cout << "    \"ofstream_endl\": " << stream << "\n"; 
+    cout << "  },\n"; 
+    cout << "  \"written\": " << stats.Written << ",\n"; 
+    cout << "  \"dropped\": " << stats.Dropped << ",\n"; 
+    cout << "  \"suppressed\": " << stats.Suppressed << "\n"; 
+    cout << "}" << endl; 
+
+    Logger::Shutdown(); 
+    fclose(devNull); 
+    return 0; 
+}
@@ -0,0 +1,24 @@
+#include <iostream>
+
+#include "Log.h"
+
+using namespace std; 
+
+//Prints a log written with Logger::SetBinaryOutput as text
+//
+//  ./LogDump frame.logb > frame.log
+
+int main(int argc, char** argv)
+{
+    if (argc != 2)
+    {
+        cerr << "usage: LogDump <file>" << endl; 
+        return -1; 
+    }
+    if (!Logger::DecodeBinary(argv[1], stdout))
+    {
+        cerr << "cannot read " << argv[1] << endl; 
+        return -1; 
+    }
+    return 0; 
+}
@@ -0,0 +1,46 @@
+#include "Mesh.h"
+#include "MeshFile.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "VertexArray.h"
+#include "Renderer.h"
+#include "GLState.h"
+
+#include <cstring>
+
+//immutable storage filled from the mapping; bound to the copy target so no
+//VAO's element array binding is touched
+static unsigned int CreateStaticBuffer(const void* data, size_t size)
+{ 
+    unsigned int buffer; 
+    GLCall(glGenBuffers(1, &buffer)); 
+    GLState::BindBuffer(GL_COPY_WRITE_BUFFER, buffer); 
+    if (GLEW_ARB_buffer_storage)
+        GLCall(glBufferStorage(GL_COPY_WRITE_BUFFER, size, data, 0)); 
+    else
+        GLCall(glBufferData(GL_COPY_WRITE_BUFFER, size, data, GL_STATIC_DRAW)); 
+    return buffer; 
+}
+
+Mesh::Mesh(const MeshFile& file, unsigned int mesh)
+{
+    const MeshRecord& record = file.GetRecord(mesh); 
+    file.Prefetch(mesh); 
+
+    m_VertexBuffer = VertexBuffer::Adopt(CreateStaticBuffer(file.GetVertices(mesh), record.VertexSize), (unsigned int)record.VertexSize); 
+    m_IndexBuffer = IndexBuffer::Adopt(CreateStaticBuffer(file.GetIndices(mesh), record.IndexSize), record.IndexCount, record.IndexType); 
+    m_IndexType = record.IndexType; 
+    memcpy(m_Bounds, record.Bounds, sizeof(m_Bounds)); 
+
+    m_VertexArray = new VertexArray(); 
+    m_VertexArray->AddBuffer(*m_VertexBuffer, file.GetLayout(mesh)); 
+    m_VertexArray->SetIndexBuffer(*m_IndexBuffer); 
+    m_VertexArray->Unbind(); 
+}
+
+Mesh::~Mesh()
+{
+    delete m_VertexArray; 
+    delete m_VertexBuffer; 
+    delete m_IndexBuffer; 
+}
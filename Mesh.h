@@ -0,0 +1,31 @@
+#pragma once
+
+class MeshFile; 
+class VertexBuffer; 
+class IndexBuffer; 
+class VertexArray; 
+
+//GPU copy of one mesh of a MeshFile. The buffers are created straight from
+//the mapped file, glBufferStorage (or glBufferData before 4.4) reads the
+//pages itself, so the only copy is the one into GL memory.
+class Mesh
+{ 
+private: 
+	VertexBuffer* m_VertexBuffer; 
+	IndexBuffer* m_IndexBuffer; 
+	VertexArray* m_VertexArray; 
+	unsigned int m_IndexType; 
+	float m_Bounds[6]; 
+public: 
+	Mesh(const MeshFile& file, unsigned int mesh); 
+	~Mesh(); 
+
+	Mesh(const Mesh&) = delete; 
+	Mesh& operator=(const Mesh&) = delete; 
+
+	inline const VertexArray& GetVertexArray() const { return *m_VertexArray; }
+	inline const IndexBuffer& GetIndexBuffer() const { return *m_IndexBuffer; }
+	inline unsigned int GetIndexType() const { return m_IndexType; }
+	//min x, y, z then max x, y, z
+	inline const float* GetBounds() const { return m_Bounds; }
+}; 
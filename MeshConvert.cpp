@@ -0,0 +1,278 @@
+#include <GL/glew.h>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cstddef>
+
+#include "MeshFile.h"
+#include "MeshOptimizer.h"
+
+using namespace std; 
+
+//Offline converter to the .mesh format, one mesh per input:
+//
+//  ./MeshConvert out.mesh teapot.obj bunny.obj
+//  ./MeshConvert out.mesh --grid 1000 --copies 9
+//
+//OBJ positions, texture coordinates and normals go into one interleaved
+//vertex, faces are triangulated as fans and equal corners are merged. --grid
+//writes generated height field grids instead, which is handy for testing
+//load times on big files (a 1000 grid is about 56 MB).
+//
+//Every mesh goes through the MeshOptimizer unless --no-optimize is given,
+//and its ACMR before and after is printed.
+struct MeshVertex
+{ 
+    Float3 Position; 
+    Float3 Normal; 
+    Float2 TexCoord; 
+}; 
+template<> struct VertexFormat<MeshVertex> : VertexAttributes<Float3, Float3, Float2> {}; 
+
+struct MeshData
+{ 
+    string Name; 
+    vector<MeshVertex> Vertices; 
+    vector<unsigned int> Indices; 
+}; 
+
+//an OBJ face corner, indices of position, texture coordinate and normal
+struct Corner
+{ 
+    int Position, TexCoord, Normal; 
+
+    bool operator==(const Corner& other) const 
+    { 
+        return Position == other.Position && TexCoord == other.TexCoord && Normal == other.Normal; 
+    }
+}; 
+
+struct CornerHash
+{ 
+    size_t operator()(const Corner& corner) const 
+    { 
+        return ((size_t)corner.Position * 73856093) ^ ((size_t)corner.TexCoord * 19349663) ^ ((size_t)corner.Normal * 83492791); 
+    }
+}; 
+
+//OBJ indices start at 1 and count back from the end when negative
+static int ResolveIndex(const char*& cursor, int count)
+{ 
+    char* end; 
+    long index = strtol(cursor, &end, 10); 
+    if (end == cursor)
+        return -1; 
+    cursor = end; 
+    return index < 0 ? count + (int)index : (int)index - 1; 
+}
+
+static bool LoadObj(const string& path, MeshData& mesh)
+{ 
+    ifstream stream(path); 
+    if (!stream)
+        return false; 
+
+    vector<float> positions, texCoords, normals; 
+    unordered_map<Corner, unsigned int, CornerHash> corners; 
+    vector<unsigned int> face; 
+    string line; 
+    while (getline(stream, line))
+    { 
+        const char* cursor = line.c_str(); 
+        char* end; 
+        if (line.compare(0, 2, "v ") == 0 || line.compare(0, 3, "vn ") == 0 || line.compare(0, 3, "vt ") == 0)
+        { 
+            vector<float>& target = line[1] == 'n' ? normals : (line[1] == 't' ? texCoords : positions); 
+            int components = line[1] == 't' ? 2 : 3; 
+            cursor += line[1] == ' ' ? 2 : 3; 
+            for (int c = 0; c < components; c++)
+            { 
+                target.push_back(strtof(cursor, &end)); 
+                cursor = end; 
+            }
+        }
+        else if (line.compare(0, 2, "f ") == 0)
+        { 
+            face.clear(); 
+            cursor += 2; 
+            while (true)
+            { 
+                while (*cursor == ' ' || *cursor == '\t')
+                    cursor++; 
+                if (*cursor == '\0' || *cursor == '\r')
+                    break; 
+
+                Corner corner = { ResolveIndex(cursor, (int)positions.size() / 3), -1, -1 }; 
+                if (*cursor == '/')
+                { 
+                    cursor++; 
+                    if (*cursor != '/')
+                        corner.TexCoord = ResolveIndex(cursor, (int)texCoords.size() / 2); 
+                    if (*cursor == '/')
+                    { 
+                        cursor++; 
+                        corner.Normal = ResolveIndex(cursor, (int)normals.size() / 3); 
+                    }
+                }
+                if (corner.Position < 0 || corner.Position >= (int)positions.size() / 3)
+                    return false; 
+
+                auto found = corners.find(corner); 
+                if (found == corners.end())
+                { 
+                    MeshVertex vertex = {}; 
+                    for (int c = 0; c < 3; c++)
+                        vertex.Position[c] = positions[corner.Position * 3 + c]; 
+                    if (corner.Normal >= 0 && corner.Normal < (int)normals.size() / 3)
+                        for (int c = 0; c < 3; c++)
+                            vertex.Normal[c] = normals[corner.Normal * 3 + c]; 
+                    if (corner.TexCoord >= 0 && corner.TexCoord < (int)texCoords.size() / 2)
+                        for (int c = 0; c < 2; c++)
+                            vertex.TexCoord[c] = texCoords[corner.TexCoord * 2 + c]; 
+                    found = corners.emplace(corner, (unsigned int)mesh.Vertices.size()).first; 
+                    mesh.Vertices.push_back(vertex); 
+                }
+                face.push_back(found->second); 
+
+                //skip whatever else is on the corner
+                while (*cursor && *cursor != ' ' && *cursor != '\t')
+                    cursor++; 
+            }
+            for (unsigned int i = 2; i < face.size(); i++)
+            { 
+                mesh.Indices.push_back(face[0]); 
+                mesh.Indices.push_back(face[i - 1]); 
+                mesh.Indices.push_back(face[i]); 
+            }
+        }
+    }
+    return true; 
+}
+
+//size x size quads over a gentle height field, normals from the slope
+static void GenerateGrid(unsigned int size, unsigned int seed, MeshData& mesh)
+{ 
+    float phase = seed * 1.7f; 
+    for (unsigned int y = 0; y <= size; y++)
+    { 
+        for (unsigned int x = 0; x <= size; x++)
+        { 
+            float u = (float)x / size, v = (float)y / size; 
+            float height = 0.05f * sin(u * 12.0f + phase) * cos(v * 9.0f + phase); 
+            float dx = 0.05f * 12.0f * cos(u * 12.0f + phase) * cos(v * 9.0f + phase); 
+            float dy = -0.05f * 9.0f * sin(u * 12.0f + phase) * sin(v * 9.0f + phase); 
+            float length = sqrt(dx * dx + dy * dy + 1.0f); 
+
+            MeshVertex vertex; 
+            vertex.Position = { { u - 0.5f, height, v - 0.5f } }; 
+            vertex.Normal = { { -dx / length, 1.0f / length, -dy / length } }; 
+            vertex.TexCoord = { { u, v } }; 
+            mesh.Vertices.push_back(vertex); 
+        }
+    }
+    for (unsigned int y = 0; y < size; y++)
+    { 
+        for (unsigned int x = 0; x < size; x++)
+        { 
+            unsigned int i = y * (size + 1) + x; 
+            unsigned int quad[6] = { i, i + size + 1, i + 1, i + 1, i + size + 1, i + size + 2 }; 
+            mesh.Indices.insert(mesh.Indices.end(), quad, quad + 6); 
+        }
+    }
+}
+
+static string Stem(const string& path)
+{ 
+    size_t slash = path.find_last_of("/\\"); 
+    string name = slash == string::npos ? path : path.substr(slash + 1); 
+    return name.substr(0, name.find_last_of('.')); 
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    { 
+        cout << "usage: MeshConvert out.mesh input.obj... | --grid size [--copies n]" << endl; 
+        return 1; 
+    }
+
+    vector<MeshData> meshes; 
+    unsigned int gridSize = 0, copies = 1; 
+    bool optimize = true; 
+    for (int i = 2; i < argc; i++)
+    { 
+        if (!strcmp(argv[i], "--grid") && i + 1 < argc)
+            gridSize = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--copies") && i + 1 < argc)
+            copies = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--no-optimize"))
+            optimize = false; 
+        else
+        { 
+            meshes.emplace_back(); 
+            meshes.back().Name = Stem(argv[i]); 
+            if (!LoadObj(argv[i], meshes.back()))
+            { 
+                cout << "Failed to read " << argv[i] << endl; 
+                return 1; 
+            }
+        }
+    }
+    for (unsigned int c = 0; gridSize && c < copies; c++)
+    { 
+        meshes.emplace_back(); 
+        meshes.back().Name = "grid" + to_string(c); 
+        GenerateGrid(gridSize, c, meshes.back()); 
+    }
+
+    vector<MeshSource> sources; 
+    for (MeshData& mesh : meshes)
+    { 
+        cout << mesh.Name << ": " << mesh.Vertices.size() << " vertices, " << mesh.Indices.size() / 3 << " triangles"; 
+        if (optimize && !mesh.Indices.empty())
+        { 
+            unsigned int vertexCount = (unsigned int)mesh.Vertices.size(); 
+            MeshOptimizer::Report report = MeshOptimizer::Optimize(mesh.Vertices.data(), vertexCount, sizeof(MeshVertex), 
+                offsetof(MeshVertex, Position), mesh.Indices.data(), (unsigned int)mesh.Indices.size()); 
+            mesh.Vertices.resize(vertexCount); 
+            cout << ", " << report.VerticesAfter << " vertices after optimizing, ACMR " << report.AcmrBefore << " -> " << report.AcmrAfter
+                 << ", ATVR " << report.AtvrBefore << " -> " << report.AtvrAfter; 
+        }
+        cout << (mesh.Vertices.size() <= 0x10000 ? ", 16" : ", 32") << " bit indices" << endl; 
+
+        MeshSource source; 
+        source.Name = mesh.Name; 
+        source.Layout = VertexBufferLayout::Of<MeshVertex>(); 
+        source.Vertices = mesh.Vertices.data(); 
+        source.VertexCount = (unsigned int)mesh.Vertices.size(); 
+        source.Indices = mesh.Indices.data(); 
+        source.IndexCount = (unsigned int)mesh.Indices.size(); 
+        for (int c = 0; c < 3; c++)
+        { 
+            source.Bounds[c] = mesh.Vertices.empty() ? 0.0f : INFINITY; 
+            source.Bounds[c + 3] = mesh.Vertices.empty() ? 0.0f : -INFINITY; 
+        }
+        for (const MeshVertex& vertex : mesh.Vertices)
+        { 
+            for (int c = 0; c < 3; c++)
+            { 
+                source.Bounds[c] = min(source.Bounds[c], vertex.Position[c]); 
+                source.Bounds[c + 3] = max(source.Bounds[c + 3], vertex.Position[c]); 
+            }
+        }
+        sources.push_back(source); 
+    }
+
+    if (!MeshFile::Write(argv[1], sources))
+    { 
+        cout << "Failed to write " << argv[1] << endl; 
+        return 1; 
+    }
+    return 0;
+}
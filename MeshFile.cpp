@@ -0,0 +1,202 @@
+#include "MeshFile.h"
+#include "Log.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std; 
+
+//a page on every platform we run on, so blobs can be mapped and prefetched on their own
+static const uint32_t BlobAlignment = 4096; 
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{ 
+    return (value + alignment - 1) / alignment * alignment; 
+}
+
+MeshFile::MeshFile(const std::string& path)
+  : m_Data(nullptr), m_Size(0), m_Header(nullptr), m_Records(nullptr)
+{
+    int file = open(path.c_str(), O_RDONLY); 
+    if (file < 0)
+    { 
+        LOG_ERROR("Failed to open mesh file {}", path); 
+        return; 
+    }
+
+    struct stat info; 
+    if (fstat(file, &info) == 0 && info.st_size >= (off_t)sizeof(MeshFileHeader))
+    { 
+        m_Size = (size_t)info.st_size; 
+        m_Data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, file, 0); 
+        if (m_Data == MAP_FAILED)
+            m_Data = nullptr; 
+    }
+    //the mapping keeps the file open on its own
+    close(file); 
+
+    if (!m_Data)
+    { 
+        LOG_ERROR("Failed to map mesh file {}", path); 
+        return; 
+    }
+    //blobs are read front to back by the uploads
+    madvise(m_Data, m_Size, MADV_SEQUENTIAL); 
+
+    if (!Validate())
+    { 
+        LOG_ERROR("Invalid mesh file {}", path); 
+        return; 
+    }
+    m_Header = (const MeshFileHeader*)m_Data; 
+    m_Records = (const MeshRecord*)(m_Header + 1); 
+}
+
+MeshFile::~MeshFile()
+{
+    if (m_Data)
+        munmap(m_Data, m_Size); 
+}
+
+bool MeshFile::Validate() const
+{
+    const MeshFileHeader* header = (const MeshFileHeader*)m_Data; 
+    if (memcmp(header->Magic, MeshFileMagic, 4) != 0 || header->Version != MeshFileVersion)
+        return false; 
+    if (sizeof(MeshFileHeader) + (uint64_t)header->MeshCount * sizeof(MeshRecord) > m_Size)
+        return false; 
+
+    //a damaged file must not send GL reading past the mapping
+    const MeshRecord* records = (const MeshRecord*)(header + 1); 
+    for (unsigned int i = 0; i < header->MeshCount; i++)
+    { 
+        const MeshRecord& record = records[i]; 
+        if (record.AttributeCount > MeshRecord::MaxAttributes || (record.IndexType != GL_UNSIGNED_INT && record.IndexType != GL_UNSIGNED_SHORT))
+            return false; 
+        uint64_t indexSize = record.IndexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t); 
+        if (record.VertexSize != (uint64_t)record.VertexCount * record.VertexStride ||
+            record.IndexSize != (uint64_t)record.IndexCount * indexSize)
+            return false; 
+        if (record.VertexOffset > m_Size || record.VertexSize > m_Size - record.VertexOffset ||
+            record.IndexOffset > m_Size || record.IndexSize > m_Size - record.IndexOffset)
+            return false; 
+    }
+    return true; 
+}
+
+bool MeshFile::Write(const std::string& path, const std::vector<MeshSource>& meshes)
+{
+    MeshFileHeader header; 
+    memcpy(header.Magic, MeshFileMagic, 4); 
+    header.Version = MeshFileVersion; 
+    header.MeshCount = (uint32_t)meshes.size(); 
+    header.BlobAlignment = BlobAlignment; 
+
+    std::vector<MeshRecord> records(meshes.size()); 
+    uint64_t offset = AlignUp(sizeof(MeshFileHeader) + records.size() * sizeof(MeshRecord), BlobAlignment); 
+    for (unsigned int i = 0; i < meshes.size(); i++)
+    { 
+        const MeshSource& mesh = meshes[i]; 
+        const std::vector<VertexBufferElement>& elements = mesh.Layout.GetElements(); 
+        if (elements.size() > MeshRecord::MaxAttributes)
+            return false; 
+
+        MeshRecord& record = records[i]; 
+        memset(&record, 0, sizeof(record)); 
+        strncpy(record.Name, mesh.Name.c_str(), sizeof(record.Name) - 1); 
+        record.VertexCount = mesh.VertexCount; 
+        record.VertexStride = mesh.Layout.GetStride(); 
+        record.IndexCount = mesh.IndexCount; 
+        record.IndexType = mesh.VertexCount <= 0x10000 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT; 
+        record.AttributeCount = (uint32_t)elements.size(); 
+        for (unsigned int a = 0; a < elements.size(); a++)
+        { 
+            record.Attributes[a].Type = elements[a].Type; 
+            record.Attributes[a].Count = (uint8_t)elements[a].Count; 
+            record.Attributes[a].Normalized = elements[a].Normalized; 
+            record.Attributes[a].Integer = elements[a].Integer; 
+            record.Attributes[a].Offset = elements[a].Offset; 
+        }
+        memcpy(record.Bounds, mesh.Bounds, sizeof(record.Bounds)); 
+
+        record.VertexOffset = offset; 
+        record.VertexSize = (uint64_t)mesh.VertexCount * record.VertexStride; 
+        offset = AlignUp(offset + record.VertexSize, BlobAlignment); 
+        record.IndexOffset = offset; 
+        record.IndexSize = (uint64_t)mesh.IndexCount * (record.IndexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t)); 
+        offset = AlignUp(offset + record.IndexSize, BlobAlignment); 
+    }
+
+    FILE* file = fopen(path.c_str(), "wb"); 
+    if (!file)
+        return false; 
+
+    static const char zeros[BlobAlignment] = {}; 
+    uint64_t written = 0; 
+    auto write = [&](const void* data, uint64_t size)
+    { 
+        fwrite(data, 1, size, file); 
+        written += size; 
+    }; 
+    auto pad = [&]()
+    { 
+        write(zeros, AlignUp(written, BlobAlignment) - written); 
+    }; 
+
+    write(&header, sizeof(header)); 
+    write(records.data(), records.size() * sizeof(MeshRecord)); 
+    for (unsigned int i = 0; i < meshes.size(); i++)
+    { 
+        pad(); 
+        write(meshes[i].Vertices, records[i].VertexSize); 
+        pad(); 
+        if (records[i].IndexType == GL_UNSIGNED_SHORT)
+        { 
+            std::vector<uint16_t> shorts(meshes[i].Indices, meshes[i].Indices + meshes[i].IndexCount); 
+            write(shorts.data(), records[i].IndexSize); 
+        }
+        else
+        { 
+            write(meshes[i].Indices, records[i].IndexSize); 
+        }
+    }
+    pad(); 
+
+    bool ok = !ferror(file); 
+    return fclose(file) == 0 && ok; 
+}
+
+int MeshFile::Find(const std::string& name) const
+{
+    for (unsigned int i = 0; i < GetMeshCount(); i++)
+    { 
+        if (strncmp(m_Records[i].Name, name.c_str(), sizeof(m_Records[i].Name)) == 0)
+            return (int)i; 
+    }
+    return -1; 
+}
+
+VertexBufferLayout MeshFile::GetLayout(unsigned int mesh) const
+{
+    const MeshRecord& record = m_Records[mesh]; 
+    std::vector<VertexBufferElement> elements(record.AttributeCount); 
+    for (unsigned int a = 0; a < record.AttributeCount; a++)
+    { 
+        const MeshAttribute& attribute = record.Attributes[a]; 
+        elements[a] = { attribute.Type, attribute.Count, attribute.Normalized != 0, attribute.Integer != 0, attribute.Offset }; 
+    }
+    return VertexBufferLayout(elements, record.VertexStride); 
+}
+
+void MeshFile::Prefetch(unsigned int mesh) const
+{
+    //madvise wants page aligned starts, which the blobs have
+    const MeshRecord& record = m_Records[mesh]; 
+    madvise((char*)m_Data + record.VertexOffset, record.VertexSize, MADV_WILLNEED); 
+    madvise((char*)m_Data + record.IndexOffset, record.IndexSize, MADV_WILLNEED); 
+}
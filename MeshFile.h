@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "VertexBufferLayout.h"
+
+//On disk layout of a .mesh file, little endian, every field naturally
+//aligned so the header and records are read in place:
+//
+//  MeshFileHeader
+//  MeshRecord[MeshCount]
+//  vertex and index blobs, each starting on a BlobAlignment boundary
+//
+//Blobs start on page boundaries, so a mapped blob is handed to GL as it is.
+static const char MeshFileMagic[4] = { 'M', 'E', 'S', 'H' }; 
+static const uint32_t MeshFileVersion = 1; 
+
+struct MeshFileHeader
+{ 
+	char Magic[4]; 
+	uint32_t Version; 
+	uint32_t MeshCount; 
+	uint32_t BlobAlignment; 
+}; 
+
+struct MeshAttribute
+{ 
+	//GL_FLOAT, GL_HALF_FLOAT, ... as in VertexBufferElement
+	uint32_t Type; 
+	uint8_t Count; 
+	uint8_t Normalized; 
+	uint8_t Integer; 
+	uint8_t Padding; 
+	uint32_t Offset; 
+}; 
+
+struct MeshRecord
+{ 
+	static const unsigned int MaxAttributes = 8; 
+
+	char Name[32]; 
+	uint32_t VertexCount; 
+	uint32_t VertexStride; 
+	uint32_t IndexCount; 
+	//GL_UNSIGNED_SHORT when the mesh has at most 65536 vertices, else GL_UNSIGNED_INT
+	uint32_t IndexType; 
+	uint32_t AttributeCount; 
+	uint32_t Reserved; 
+	MeshAttribute Attributes[MaxAttributes]; 
+	//byte ranges from the start of the file
+	uint64_t VertexOffset; 
+	uint64_t VertexSize; 
+	uint64_t IndexOffset; 
+	uint64_t IndexSize; 
+	//min x, y, z then max x, y, z
+	float Bounds[6]; 
+	uint32_t Padding; 
+}; 
+
+//one mesh to write, pointing at data owned by the caller
+struct MeshSource
+{ 
+	std::string Name; 
+	VertexBufferLayout Layout; 
+	const void* Vertices; 
+	unsigned int VertexCount; 
+	const unsigned int* Indices; 
+	unsigned int IndexCount; 
+	float Bounds[6]; 
+}; 
+
+//A .mesh file mapped into memory. Nothing is parsed or copied, the header
+//and records are checked and used in place and GetVertices/GetIndices point
+//straight into the mapping, so the pages come in from disk (or the page
+//cache) only when GL reads them.
+class MeshFile
+{ 
+private: 
+	void* m_Data; 
+	size_t m_Size; 
+	const MeshFileHeader* m_Header; 
+	const MeshRecord* m_Records; 
+
+	bool Validate() const; 
+public: 
+	MeshFile(const std::string& path); 
+	~MeshFile(); 
+
+	MeshFile(const MeshFile&) = delete; 
+	MeshFile& operator=(const MeshFile&) = delete; 
+
+	static bool Write(const std::string& path, const std::vector<MeshSource>& meshes); 
+
+	//-1 when there is no mesh of that name
+	int Find(const std::string& name) const; 
+	VertexBufferLayout GetLayout(unsigned int mesh) const; 
+	//asks the kernel to start reading a mesh's pages ahead of use
+	void Prefetch(unsigned int mesh) const; 
+
+	inline bool IsValid() const { return m_Header != nullptr; }
+	inline unsigned int GetMeshCount() const { return m_Header ? m_Header->MeshCount : 0; }
+	inline const MeshRecord& GetRecord(unsigned int mesh) const { return m_Records[mesh]; }
+	inline const void* GetVertices(unsigned int mesh) const { return (const char*)m_Data + m_Records[mesh].VertexOffset; }
+	inline const void* GetIndices(unsigned int mesh) const { return (const char*)m_Data + m_Records[mesh].IndexOffset; }
+	inline size_t GetSize() const { return m_Size; }
+}; 
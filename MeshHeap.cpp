@@ -0,0 +1,170 @@
+#include "MeshHeap.h"
+#include "Renderer.h"
+#include "GLState.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+
+#include <algorithm>
+
+using namespace std; 
+
+MeshHeap::MeshHeap(const VertexBufferLayout& layout, unsigned int vertexCapacity, unsigned int indexCapacity, unsigned int indexType)
+  : m_Layout(layout), m_Stride(layout.GetStride()), m_IndexType(indexType), m_IndexSize(IndexBuffer::SizeOf(indexType)),
+    m_Vertices(vertexCapacity), m_Indices(indexCapacity), m_VertexBuffer(nullptr), m_IndexBuffer(nullptr), m_Binding(0),
+    m_Defragmentations(0), m_BytesMoved(0)
+{
+    m_VertexBuffer = new VertexBuffer(vertexCapacity * m_Stride); 
+    m_IndexBuffer = new IndexBuffer(indexCapacity, indexType); 
+    m_Binding = m_VertexArray.AddBuffer(*m_VertexBuffer, m_Layout); 
+    m_VertexArray.SetIndexBuffer(*m_IndexBuffer); 
+}
+
+MeshHeap::~MeshHeap()
+{
+    delete m_VertexBuffer; 
+    delete m_IndexBuffer; 
+}
+
+unsigned int MeshHeap::Add(const void* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount)
+{
+    //an empty range is never allocated, it would only set off a Defragment
+    if (!vertexCount || !indexCount)
+        return Invalid; 
+    //16-bit indices only reach that far past the base vertex
+    if (m_IndexType == GL_UNSIGNED_SHORT && vertexCount > 0x10000)
+        return Invalid; 
+
+    RangeAllocator::Allocation vertexRange = m_Vertices.Allocate(vertexCount); 
+    RangeAllocator::Allocation indexRange = m_Indices.Allocate(indexCount); 
+    if (!vertexRange.IsValid() || !indexRange.IsValid())
+    { 
+        m_Vertices.Free(vertexRange); 
+        m_Indices.Free(indexRange); 
+        //there is room, just not in one piece
+        if (m_Vertices.GetCapacity() - m_Vertices.GetUsed() < vertexCount || m_Indices.GetCapacity() - m_Indices.GetUsed() < indexCount)
+            return Invalid; 
+        Defragment(); 
+        vertexRange = m_Vertices.Allocate(vertexCount); 
+        indexRange = m_Indices.Allocate(indexCount); 
+        if (!vertexRange.IsValid() || !indexRange.IsValid())
+        { 
+            m_Vertices.Free(vertexRange); 
+            m_Indices.Free(indexRange); 
+            return Invalid; 
+        }
+    }
+
+    m_VertexBuffer->UpdateData(vertices, vertexCount * m_Stride, vertexRange.Offset * m_Stride); 
+    if (m_IndexType == GL_UNSIGNED_SHORT)
+    { 
+        m_Narrowed.assign(indices, indices + indexCount); 
+        m_IndexBuffer->UpdateData(m_Narrowed.data(), indexCount, indexRange.Offset); 
+    }
+    else
+        m_IndexBuffer->UpdateData(indices, indexCount, indexRange.Offset); 
+
+    unsigned int mesh; 
+    if (m_FreeMeshes.empty())
+    { 
+        mesh = (unsigned int)m_Meshes.size(); 
+        m_Meshes.push_back(Entry()); 
+    }
+    else
+    { 
+        mesh = m_FreeMeshes.back(); 
+        m_FreeMeshes.pop_back(); 
+    }
+    m_Meshes[mesh].Vertices = vertexRange; 
+    m_Meshes[mesh].Indices = indexRange; 
+    m_Meshes[mesh].Alive = true; 
+    return mesh; 
+}
+
+void MeshHeap::Remove(unsigned int mesh)
+{
+    ASSERT(mesh < m_Meshes.size() && m_Meshes[mesh].Alive);
+    Entry& entry = m_Meshes[mesh]; 
+    m_Vertices.Free(entry.Vertices); 
+    m_Indices.Free(entry.Indices); 
+    entry.Alive = false; 
+    m_FreeMeshes.push_back(mesh); 
+}
+
+MeshHeap::Range MeshHeap::Get(unsigned int mesh) const
+{
+    const Entry& entry = m_Meshes[mesh]; 
+    Range range; 
+    range.FirstIndex = entry.Indices.Offset; 
+    range.IndexCount = entry.Indices.Size; 
+    range.BaseVertex = (int)entry.Vertices.Offset; 
+    range.VertexCount = entry.Vertices.Size; 
+    return range; 
+}
+
+void MeshHeap::Draw(unsigned int mesh) const
+{
+    const Entry& entry = m_Meshes[mesh]; 
+    m_VertexArray.Bind(); 
+    const void* first = (const void*)(size_t)(entry.Indices.Offset * m_IndexSize); 
+    GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, entry.Indices.Size, m_IndexType, first, (int)entry.Vertices.Offset));
+}
+
+void MeshHeap::Defragment()
+{
+    //in buffer order, so the meshes keep their order and the copies read forward
+    vector<unsigned int> order; 
+    for (unsigned int i = 0; i < m_Meshes.size(); i++)
+        if (m_Meshes[i].Alive)
+            order.push_back(i); 
+    sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) { 
+        return m_Meshes[a].Vertices.Offset < m_Meshes[b].Vertices.Offset; 
+    }); 
+
+    //copying into the same buffer would need ranges that never overlap
+    VertexBuffer* vertexBuffer = new VertexBuffer(m_Vertices.GetCapacity() * m_Stride); 
+    IndexBuffer* indexBuffer = new IndexBuffer(m_Indices.GetCapacity(), m_IndexType); 
+    m_Vertices.Reset(); 
+    m_Indices.Reset(); 
+
+    GLState::BindBuffer(GL_COPY_READ_BUFFER, m_VertexBuffer->GetRendererID()); 
+    GLState::BindBuffer(GL_COPY_WRITE_BUFFER, vertexBuffer->GetRendererID()); 
+    for (unsigned int mesh : order)
+    { 
+        RangeAllocator::Allocation& range = m_Meshes[mesh].Vertices; 
+        RangeAllocator::Allocation moved = m_Vertices.Allocate(range.Size); 
+        GLCall(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, range.Offset * m_Stride, moved.Offset * m_Stride, range.Size * m_Stride));
+        m_BytesMoved += range.Size * m_Stride; 
+        range = moved; 
+    }
+
+    GLState::BindBuffer(GL_COPY_READ_BUFFER, m_IndexBuffer->GetRendererID()); 
+    GLState::BindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer->GetRendererID()); 
+    for (unsigned int mesh : order)
+    { 
+        RangeAllocator::Allocation& range = m_Meshes[mesh].Indices; 
+        RangeAllocator::Allocation moved = m_Indices.Allocate(range.Size); 
+        GLCall(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, range.Offset * m_IndexSize, moved.Offset * m_IndexSize, range.Size * m_IndexSize));
+        m_BytesMoved += range.Size * m_IndexSize; 
+        range = moved; 
+    }
+
+    //draws already queued still read the old buffers, the ResourceManager keeps them until the GPU is done
+    delete m_VertexBuffer; 
+    delete m_IndexBuffer; 
+    m_VertexBuffer = vertexBuffer; 
+    m_IndexBuffer = indexBuffer; 
+    m_VertexArray.SetBuffer(m_Binding, *m_VertexBuffer); 
+    m_VertexArray.SetIndexBuffer(*m_IndexBuffer); 
+    m_Defragmentations++; 
+}
+
+MeshHeap::Stats MeshHeap::GetStats() const
+{
+    Stats stats; 
+    stats.Vertices = m_Vertices.GetStats(); 
+    stats.Indices = m_Indices.GetStats(); 
+    stats.Meshes = (unsigned int)(m_Meshes.size() - m_FreeMeshes.size()); 
+    stats.Defragmentations = m_Defragmentations; 
+    stats.BytesMoved = m_BytesMoved; 
+    return stats; 
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <vector>
+
+#include "VertexBufferLayout.h"
+#include "VertexArray.h"
+#include "RangeAllocator.h"
+
+class VertexBuffer; 
+class IndexBuffer; 
+
+//Meshes of one vertex layout that come and go at runtime, sub-allocated out
+//of one large vertex buffer and one large index buffer. Every mesh is drawn
+//from the same vertex array with glDrawElementsBaseVertex, so switching
+//meshes changes no binding at all, and the driver sees two buffers instead
+//of two per mesh. Vertex ranges are counted in vertices and index ranges in
+//indices, so every offset is a valid base vertex or first index.
+//
+//Unlike a MeshPool meshes can be removed. The holes are reused, and when an
+//Add finds enough free space but none of it in one piece, Defragment moves
+//the meshes together on the GPU first.
+class MeshHeap
+{
+public:
+	static const unsigned int Invalid = ~0u; 
+
+	//what RenderQueue::Draw and DrawElementsIndirectCommand take
+	struct Range
+	{
+		unsigned int FirstIndex; 
+		unsigned int IndexCount; 
+		int BaseVertex; 
+		unsigned int VertexCount; 
+	}; 
+
+	struct Stats
+	{
+		RangeAllocator::Stats Vertices; 
+		RangeAllocator::Stats Indices; 
+		unsigned int Meshes = 0; 
+		unsigned int Defragmentations = 0; 
+		unsigned long long BytesMoved = 0; 
+	}; 
+private:
+	struct Entry
+	{
+		RangeAllocator::Allocation Vertices; 
+		RangeAllocator::Allocation Indices; 
+		bool Alive; 
+	}; 
+
+	VertexBufferLayout m_Layout; 
+	unsigned int m_Stride; 
+	unsigned int m_IndexType; 
+	unsigned int m_IndexSize; 
+	RangeAllocator m_Vertices; 
+	RangeAllocator m_Indices; 
+	VertexBuffer* m_VertexBuffer; 
+	IndexBuffer* m_IndexBuffer; 
+	VertexArray m_VertexArray; 
+	unsigned int m_Binding; 
+
+	std::vector<Entry> m_Meshes; 
+	std::vector<unsigned int> m_FreeMeshes; 
+	//indices narrowed to 16 bits before the upload
+	std::vector<unsigned short> m_Narrowed; 
+	unsigned int m_Defragmentations; 
+	unsigned long long m_BytesMoved; 
+public:
+	//GL_UNSIGNED_SHORT indices hold meshes of up to 65536 vertices each, the
+	//base vertex takes care of where they are in the heap
+	MeshHeap(const VertexBufferLayout& layout, unsigned int vertexCapacity, unsigned int indexCapacity, unsigned int indexType); 
+	~MeshHeap(); 
+
+	MeshHeap(const MeshHeap&) = delete; 
+	MeshHeap& operator=(const MeshHeap&) = delete; 
+
+	//indices are relative to the mesh's first vertex; Invalid when the heap is
+	//full or the mesh has no vertices or no indices
+	unsigned int Add(const void* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount); 
+	//the ranges are reused right away, GL still gets earlier draws right,
+	//at worst by waiting for them before the new data lands
+	void Remove(unsigned int mesh); 
+
+	Range Get(unsigned int mesh) const; 
+	void Draw(unsigned int mesh) const; 
+
+	//copies every mesh to the front of new buffers with glCopyBufferSubData, the
+	//data never comes back to the CPU; the old buffers go once the GPU is done
+	//with them. Mesh ids stay, their ranges change.
+	void Defragment(); 
+
+	Stats GetStats() const; 
+
+	inline const VertexArray& GetVertexArray() const { return m_VertexArray; }
+	inline unsigned int GetIndexType() const { return m_IndexType; }
+}; 
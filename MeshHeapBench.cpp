@@ -0,0 +1,211 @@
+#include <GL/glew.h>
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "Renderer.h"
+#include "Context.h"
+#include "GLState.h"
+#include "MeshHeap.h"
+#include "Shader.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+
+using namespace std; 
+
+//Draws a few thousand small meshes once with a vertex array and two
+//buffers each and once out of a MeshHeap, then replaces half of the heap's
+//meshes with ones of other sizes and defragments it, and prints the times
+//and the heap's stats as JSON, e.g.
+//
+//  ./MeshHeapBench --meshes 4000 --iterations 20 > heap.json
+
+struct Shape
+{
+    vector<Float2> Vertices; 
+    vector<unsigned int> Indices; 
+}; 
+
+//a fan of 3 to 64 triangles, so the meshes differ in size
+static Shape MakeShape()
+{
+    Shape shape; 
+    unsigned int sides = 3 + rand() % 62; 
+    float x = rand() / (float)RAND_MAX * 1.8f - 0.9f; 
+    float y = rand() / (float)RAND_MAX * 1.8f - 0.9f; 
+    shape.Vertices.push_back({ x, y }); 
+    for (unsigned int i = 0; i < sides; i++)
+    {
+        float angle = 6.2831853f * i / sides; 
+        shape.Vertices.push_back({ x + 0.02f * cosf(angle), y + 0.02f * sinf(angle) }); 
+        shape.Indices.push_back(0); 
+        shape.Indices.push_back(1 + i); 
+        shape.Indices.push_back(1 + (i + 1) % sides); 
+    }
+    return shape; 
+}
+
+template<typename F>
+static double Time(int iterations, F draw)
+{
+    vector<double> times; 
+    for (int i = 0; i < iterations; i++)
+    {
+        auto start = chrono::steady_clock::now(); 
+        draw(); 
+        GLCall(glFinish());
+        times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count()); 
+    }
+    sort(times.begin(), times.end()); 
+    return times[times.size() / 2]; 
+}
+
+static void PrintRanges(const char* name, const RangeAllocator::Stats& stats, bool last)
+{
+    cout << "      \"" << name << "\": { \"capacity\": " << stats.Capacity << ", \"used\": " << stats.Used
+         << ", \"utilization\": " << (stats.Capacity ? (double)stats.Used / stats.Capacity : 0.0)
+         << ", \"free_ranges\": " << stats.FreeRanges << ", \"largest_free\": " << stats.LargestFree
+         << ", \"fragmentation\": " << stats.Fragmentation << " }" << (last ? "\n" : ",\n"); 
+}
+
+static void PrintHeap(const char* name, const MeshHeap::Stats& stats, bool last)
+{
+    cout << "    \"" << name << "\": {\n      \"meshes\": " << stats.Meshes << ",\n"; 
+    PrintRanges("vertices", stats.Vertices, false); 
+    PrintRanges("indices", stats.Indices, true); 
+    cout << "    }" << (last ? "\n" : ",\n"); 
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int meshCount = 4000; 
+    int iterations = 20; 
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--meshes") && i + 1 < argc)
+            meshCount = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--iterations") && i + 1 < argc)
+            iterations = atoi(argv[++i]); 
+        else
+        {
+            cerr << "usage: MeshHeapBench [--meshes n] [--iterations n]" << endl; 
+            return -1; 
+        }
+    }
+    if (iterations < 1)
+        iterations = 1; 
+    if (!meshCount)
+    {
+        cerr << "needs at least one mesh" << endl; 
+        return -1; 
+    }
+
+    ContextOptions options; 
+    options.Title = "MeshHeapBench"; 
+    options.SwapInterval = 0; 
+    options.Headless = true; 
+    Context context(options); 
+    if (!context.IsValid())
+        return -1; 
+
+    {
+    srand(1); 
+    vector<Shape> shapes; 
+    unsigned int vertexCount = 0, indexCount = 0; 
+    for (unsigned int i = 0; i < meshCount; i++)
+    {
+        shapes.push_back(MakeShape()); 
+        vertexCount += (unsigned int)shapes.back().Vertices.size(); 
+        indexCount += (unsigned int)shapes.back().Indices.size(); 
+    }
+
+    Shader shader("res/shaders/Basic.shader"); 
+    shader.Bind(); 
+    shader.SetUniform4f(shader.GetUniform("u_Color"), 0.2f, 0.3f, 0.8f, 1.0f); 
+
+    //one vertex array and two buffers per mesh
+    vector<VertexArray*> arrays; 
+    vector<VertexBuffer*> vertexBuffers; 
+    vector<IndexBuffer*> indexBuffers; 
+    for (const Shape& shape : shapes)
+    {
+        VertexArray* va = new VertexArray(); 
+        VertexBuffer* vb = new VertexBuffer(shape.Vertices.data(), (unsigned int)(shape.Vertices.size() * sizeof(Float2))); 
+        IndexBuffer* ib = new IndexBuffer(shape.Indices.data(), (unsigned int)shape.Indices.size()); 
+        va->AddBuffer<Float2>(*vb); 
+        va->SetIndexBuffer(*ib); 
+        arrays.push_back(va); 
+        vertexBuffers.push_back(vb); 
+        indexBuffers.push_back(ib); 
+    }
+
+    //room for the same again, for the churn below
+    MeshHeap heap(VertexBufferLayout::Of<Float2>(), vertexCount * 2, indexCount * 2, GL_UNSIGNED_SHORT); 
+    vector<unsigned int> meshes; 
+    for (const Shape& shape : shapes)
+        meshes.push_back(heap.Add(shape.Vertices.data(), (unsigned int)shape.Vertices.size(), shape.Indices.data(), (unsigned int)shape.Indices.size())); 
+
+    GLState::ResetStats(); 
+    double separateMs = Time(iterations, [&]() {
+        for (unsigned int i = 0; i < meshCount; i++)
+        {
+            arrays[i]->Bind(); 
+            GLCall(glDrawElements(GL_TRIANGLES, indexBuffers[i]->GetCount(), indexBuffers[i]->GetType(), nullptr));
+        }
+    }); 
+    unsigned int separateBinds = GLState::GetStats().Issued; 
+
+    GLState::ResetStats(); 
+    double heapMs = Time(iterations, [&]() {
+        for (unsigned int mesh : meshes)
+            heap.Draw(mesh); 
+    }); 
+    unsigned int heapBinds = GLState::GetStats().Issued; 
+
+    //every other mesh replaced by a new shape, the holes rarely fit exactly
+    for (unsigned int i = 0; i < meshCount; i += 2)
+    {
+        heap.Remove(meshes[i]); 
+        Shape shape = MakeShape(); 
+        meshes[i] = heap.Add(shape.Vertices.data(), (unsigned int)shape.Vertices.size(), shape.Indices.data(), (unsigned int)shape.Indices.size()); 
+    }
+    for (unsigned int i = 1; i < meshCount; i += 4)
+        heap.Remove(meshes[i]); 
+    MeshHeap::Stats fragmented = heap.GetStats(); 
+
+    auto start = chrono::steady_clock::now(); 
+    heap.Defragment(); 
+    GLCall(glFinish());
+    double defragmentMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(); 
+    MeshHeap::Stats compacted = heap.GetStats(); 
+
+    cout.setf(ios::fixed); 
+    cout.precision(4); 
+    cout << "{\n  \"renderer\": \"" << glGetString(GL_RENDERER) << "\",\n"
+         << "  \"meshes\": " << meshCount << ",\n"
+         << "  \"iterations\": " << iterations << ",\n"
+         << "  \"separate\": { \"frame_ms\": " << separateMs << ", \"gl_state_issued\": " << separateBinds / iterations
+         << ", \"buffers\": " << meshCount * 2 << " },\n"
+         << "  \"heap\": { \"frame_ms\": " << heapMs << ", \"gl_state_issued\": " << heapBinds / iterations << ", \"buffers\": 2 },\n"
+         << "  \"defragment\": {\n"
+         << "    \"ms\": " << defragmentMs << ",\n"
+         << "    \"bytes_moved\": " << compacted.BytesMoved << ",\n"; 
+    PrintHeap("before", fragmented, false); 
+    PrintHeap("after", compacted, true); 
+    cout << "  }\n}" << endl; 
+
+    for (VertexArray* va : arrays)
+        delete va; 
+    for (VertexBuffer* vb : vertexBuffers)
+        delete vb; 
+    for (IndexBuffer* ib : indexBuffers)
+        delete ib; 
+    }
+    return 0; 
+}
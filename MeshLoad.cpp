@@ -0,0 +1,65 @@
+#include <GL/glew.h>
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+
+#include "Renderer.h"
+#include "Context.h"
+#include "MeshFile.h"
+#include "Mesh.h"
+
+using namespace std; 
+
+//Times loading every mesh of a .mesh file onto the GPU, e.g.
+//
+//  ./MeshConvert big.mesh --grid 1000 --copies 9
+//  ./MeshLoad big.mesh
+//
+//Map is the time to open and check the file, upload is everything from the
+//first byte read to glFinish. With nothing parsed the upload rate should sit
+//close to the disk's read rate on a cold cache and memcpy speed on a warm one.
+static double Seconds(chrono::steady_clock::time_point start)
+{ 
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count(); 
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    { 
+        cout << "usage: MeshLoad file.mesh" << endl; 
+        return 1; 
+    }
+
+    ContextOptions options; 
+    options.Title = "MeshLoad"; 
+    options.Headless = true; 
+    Context context(options); 
+    if (!context.IsValid())
+        return -1; 
+
+    {
+    auto start = chrono::steady_clock::now(); 
+    MeshFile file(argv[1]); 
+    if (!file.IsValid())
+        return 1; 
+    double map = Seconds(start); 
+
+    start = chrono::steady_clock::now(); 
+    vector<Mesh*> meshes; 
+    for (unsigned int i = 0; i < file.GetMeshCount(); i++)
+        meshes.push_back(new Mesh(file, i)); 
+    GLCall(glFinish());
+    double upload = Seconds(start); 
+
+    double megabytes = file.GetSize() / (1024.0 * 1024.0); 
+    cout << "{ \"meshes\": " << file.GetMeshCount() << ", \"megabytes\": " << megabytes 
+         << ", \"map_ms\": " << map * 1000.0 << ", \"upload_ms\": " << upload * 1000.0 
+         << ", \"megabytes_per_second\": " << megabytes / (map + upload) << " }" << endl; 
+
+    for (Mesh* mesh : meshes)
+        delete mesh; 
+    }
+    return 0;
+}
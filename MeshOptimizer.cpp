@@ -0,0 +1,301 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+const unsigned int MeshOptimizer::CacheSize; 
+
+//vertex shader runs of an index order through a FIFO cache of cacheSize
+static unsigned int CountMisses(const unsigned int* indices, unsigned int count, unsigned int vertexCount, unsigned int cacheSize)
+{ 
+    //a vertex is in the cache while fewer than cacheSize others went in after it
+    std::vector<unsigned int> inserted(vertexCount, 0); 
+    unsigned int time = cacheSize + 1; 
+    unsigned int misses = 0; 
+    for (unsigned int i = 0; i < count; i++)
+    { 
+        unsigned int v = indices[i]; 
+        if (time - inserted[v] > cacheSize)
+        { 
+            inserted[v] = time++; 
+            misses++; 
+        }
+    }
+    return misses; 
+}
+
+float MeshOptimizer::ComputeACMR(const unsigned int* indices, unsigned int count, unsigned int vertexCount, unsigned int cacheSize)
+{
+    return count ? (float)CountMisses(indices, count, vertexCount, cacheSize) / (count / 3) : 0.0f; 
+}
+
+float MeshOptimizer::ComputeATVR(const unsigned int* indices, unsigned int count, unsigned int vertexCount, unsigned int cacheSize)
+{
+    //only vertices the indices use count
+    std::vector<bool> used(vertexCount, false); 
+    unsigned int usedCount = 0; 
+    for (unsigned int i = 0; i < count; i++)
+    { 
+        usedCount += !used[indices[i]]; 
+        used[indices[i]] = true; 
+    }
+    return usedCount ? (float)CountMisses(indices, count, vertexCount, cacheSize) / usedCount : 0.0f; 
+}
+
+unsigned int MeshOptimizer::Deduplicate(void* vertices, unsigned int vertexCount, unsigned int stride, unsigned int* indices, unsigned int count)
+{
+    unsigned char* data = (unsigned char*)vertices; 
+    //vertices are compared by their bytes, the map keys are vertex indices
+    auto hash = [data, stride](unsigned int v)
+    { 
+        const unsigned char* bytes = data + (size_t)v * stride; 
+        size_t h = 14695981039346656037ull; 
+        for (unsigned int i = 0; i < stride; i++)
+            h = (h ^ bytes[i]) * 1099511628211ull; 
+        return h; 
+    }; 
+    auto equal = [data, stride](unsigned int a, unsigned int b)
+    { 
+        return memcmp(data + (size_t)a * stride, data + (size_t)b * stride, stride) == 0; 
+    }; 
+    std::unordered_map<unsigned int, unsigned int, decltype(hash), decltype(equal)> unique(vertexCount, hash, equal); 
+
+    std::vector<unsigned int> remap(vertexCount); 
+    unsigned int uniqueCount = 0; 
+    for (unsigned int v = 0; v < vertexCount; v++)
+    { 
+        auto found = unique.find(v); 
+        if (found != unique.end())
+        { 
+            remap[v] = found->second; 
+            continue; 
+        }
+        //the new slot is never after v, so moving it down is safe in place
+        if (uniqueCount != v)
+            memcpy(data + (size_t)uniqueCount * stride, data + (size_t)v * stride, stride); 
+        unique.emplace(uniqueCount, uniqueCount); 
+        remap[v] = uniqueCount++; 
+    }
+
+    for (unsigned int i = 0; i < count; i++)
+        indices[i] = remap[indices[i]]; 
+    return uniqueCount; 
+}
+
+//Tipsify, from Sander, Nehab and Barczak, "Fast Triangle Reordering for
+//Vertex Locality and Reduced Overdraw". Triangles are emitted as fans around
+//one vertex at a time, the next fan centre being a vertex of the last fans
+//still in the cache, so the order stays local without any lookahead.
+void MeshOptimizer::OptimizeVertexCache(unsigned int* indices, unsigned int count, unsigned int vertexCount,
+    unsigned int cacheSize, std::vector<unsigned int>* clusters)
+{
+    unsigned int triangleCount = count / 3; 
+
+    //triangles of every vertex, as offsets into one array
+    std::vector<unsigned int> live(vertexCount, 0); 
+    for (unsigned int i = 0; i < count; i++)
+        live[indices[i]]++; 
+    std::vector<unsigned int> offsets(vertexCount + 1, 0); 
+    for (unsigned int v = 0; v < vertexCount; v++)
+        offsets[v + 1] = offsets[v] + live[v]; 
+    std::vector<unsigned int> adjacency(count); 
+    std::vector<unsigned int> filled(offsets.begin(), offsets.end() - 1); 
+    for (unsigned int t = 0; t < triangleCount; t++)
+        for (unsigned int c = 0; c < 3; c++)
+            adjacency[filled[indices[t * 3 + c]]++] = t; 
+
+    std::vector<unsigned int> cached(vertexCount, 0); 
+    std::vector<bool> emitted(triangleCount, false); 
+    std::vector<unsigned int> deadEnds; 
+    std::vector<unsigned int> candidates; 
+    std::vector<unsigned int> output; 
+    output.reserve(count); 
+    if (clusters)
+        clusters->clear(); 
+
+    unsigned int time = cacheSize + 1; 
+    unsigned int cursor = 0; 
+    //where to look for a fresh start once the dead end stack runs dry
+    auto skipDeadEnd = [&]() -> int
+    { 
+        while (!deadEnds.empty())
+        { 
+            unsigned int v = deadEnds.back(); 
+            deadEnds.pop_back(); 
+            if (live[v] > 0)
+                return (int)v; 
+        }
+        while (cursor < vertexCount)
+        { 
+            if (live[cursor] > 0)
+                return (int)cursor++; 
+            cursor++; 
+        }
+        return -1; 
+    }; 
+
+    int fan = skipDeadEnd(); 
+    bool jumped = true; 
+    while (fan >= 0)
+    { 
+        if (jumped && clusters)
+            clusters->push_back((unsigned int)output.size()); 
+
+        candidates.clear(); 
+        for (unsigned int a = offsets[fan]; a < offsets[fan + 1]; a++)
+        { 
+            unsigned int t = adjacency[a]; 
+            if (emitted[t])
+                continue; 
+            for (unsigned int c = 0; c < 3; c++)
+            { 
+                unsigned int v = indices[t * 3 + c]; 
+                output.push_back(v); 
+                deadEnds.push_back(v); 
+                candidates.push_back(v); 
+                live[v]--; 
+                if (time - cached[v] > cacheSize)
+                    cached[v] = time++; 
+            }
+            emitted[t] = true; 
+        }
+
+        //the candidate still in the cache after its remaining triangles, the oldest first
+        int next = -1; 
+        int best = -1; 
+        for (unsigned int v : candidates)
+        { 
+            if (live[v] == 0)
+                continue; 
+            int priority = 0; 
+            if (time - cached[v] + 2 * live[v] <= cacheSize)
+                priority = (int)(time - cached[v]); 
+            if (priority > best)
+            { 
+                best = priority; 
+                next = (int)v; 
+            }
+        }
+        jumped = next < 0; 
+        fan = jumped ? skipDeadEnd() : next; 
+    }
+
+    memcpy(indices, output.data(), count * sizeof(unsigned int)); 
+}
+
+void MeshOptimizer::OptimizeOverdraw(unsigned int* indices, unsigned int count, const void* vertices, unsigned int vertexCount,
+    unsigned int stride, unsigned int positionOffset, const std::vector<unsigned int>& clusters, float threshold)
+{
+    if (clusters.size() < 2)
+        return; 
+    auto position = [&](unsigned int v)
+    { 
+        return (const float*)((const unsigned char*)vertices + (size_t)v * stride + positionOffset); 
+    }; 
+
+    //the mesh centre, weighted by triangle area
+    struct Cluster { unsigned int Begin, End; float Sort; }; 
+    std::vector<Cluster> order; 
+    double center[3] = { 0.0, 0.0, 0.0 }; 
+    double totalArea = 0.0; 
+    std::vector<float> clusterData(clusters.size() * 7, 0.0f); 
+    for (unsigned int c = 0; c < clusters.size(); c++)
+    { 
+        unsigned int begin = clusters[c]; 
+        unsigned int end = c + 1 < clusters.size() ? clusters[c + 1] : count; 
+        float* data = &clusterData[c * 7]; 
+        for (unsigned int i = begin; i < end; i += 3)
+        { 
+            const float* a = position(indices[i]); 
+            const float* b = position(indices[i + 1]); 
+            const float* d = position(indices[i + 2]); 
+            float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] }; 
+            float e2[3] = { d[0] - a[0], d[1] - a[1], d[2] - a[2] }; 
+            //twice the area times the normal
+            float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] }; 
+            float area = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]); 
+            for (int k = 0; k < 3; k++)
+            { 
+                data[k] += (a[k] + b[k] + d[k]) / 3.0f * area; 
+                data[3 + k] += n[k]; 
+            }
+            data[6] += area; 
+        }
+        for (int k = 0; k < 3; k++)
+            center[k] += data[k]; 
+        totalArea += data[6]; 
+        order.push_back({ begin, end, 0.0f }); 
+    }
+    if (totalArea <= 0.0)
+        return; 
+
+    //clusters facing away from the centre are the ones in front of the rest
+    //from most directions, drawing them first hides more of what follows
+    for (unsigned int c = 0; c < order.size(); c++)
+    { 
+        const float* data = &clusterData[c * 7]; 
+        if (data[6] <= 0.0f)
+            continue; 
+        float sort = 0.0f; 
+        for (int k = 0; k < 3; k++)
+            sort += (data[k] / data[6] - (float)(center[k] / totalArea)) * data[3 + k]; 
+        order[c].Sort = sort; 
+    }
+    std::stable_sort(order.begin(), order.end(), [](const Cluster& a, const Cluster& b) { return a.Sort > b.Sort; }); 
+
+    std::vector<unsigned int> reordered; 
+    reordered.reserve(count); 
+    for (const Cluster& cluster : order)
+        reordered.insert(reordered.end(), indices + cluster.Begin, indices + cluster.End); 
+
+    //clusters start on a cold cache anyway, so this rarely costs anything, but check
+    float before = ComputeACMR(indices, count, vertexCount); 
+    float after = ComputeACMR(reordered.data(), count, vertexCount); 
+    if (after <= before * threshold)
+        memcpy(indices, reordered.data(), count * sizeof(unsigned int)); 
+}
+
+unsigned int MeshOptimizer::OptimizeVertexFetch(void* vertices, unsigned int vertexCount, unsigned int stride, unsigned int* indices, unsigned int count)
+{
+    const unsigned int Unused = 0xffffffff; 
+    std::vector<unsigned int> remap(vertexCount, Unused); 
+    unsigned int next = 0; 
+    for (unsigned int i = 0; i < count; i++)
+    { 
+        unsigned int& target = remap[indices[i]]; 
+        if (target == Unused)
+            target = next++; 
+        indices[i] = target; 
+    }
+
+    unsigned char* data = (unsigned char*)vertices; 
+    std::vector<unsigned char> copy(data, data + (size_t)vertexCount * stride); 
+    for (unsigned int v = 0; v < vertexCount; v++)
+    { 
+        if (remap[v] != Unused)
+            memcpy(data + (size_t)remap[v] * stride, copy.data() + (size_t)v * stride, stride); 
+    }
+    return next; 
+}
+
+MeshOptimizer::Report MeshOptimizer::Optimize(void* vertices, unsigned int& vertexCount, unsigned int stride, unsigned int positionOffset,
+    unsigned int* indices, unsigned int count)
+{
+    Report report; 
+    report.VerticesBefore = vertexCount; 
+    report.AcmrBefore = ComputeACMR(indices, count, vertexCount); 
+    report.AtvrBefore = ComputeATVR(indices, count, vertexCount); 
+
+    vertexCount = Deduplicate(vertices, vertexCount, stride, indices, count); 
+    std::vector<unsigned int> clusters; 
+    OptimizeVertexCache(indices, count, vertexCount, CacheSize, &clusters); 
+    OptimizeOverdraw(indices, count, vertices, vertexCount, stride, positionOffset, clusters); 
+    vertexCount = OptimizeVertexFetch(vertices, vertexCount, stride, indices, count); 
+
+    report.VerticesAfter = vertexCount; 
+    report.AcmrAfter = ComputeACMR(indices, count, vertexCount); 
+    report.AtvrAfter = ComputeATVR(indices, count, vertexCount); 
+    return report; 
+}
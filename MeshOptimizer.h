@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+//Offline passes over indexed triangle lists, run by MeshConvert:
+//
+//  Deduplicate          merges vertices that are equal byte for byte
+//  OptimizeVertexCache  Tipsify triangle order, so most vertices are still in
+//                       the post-transform cache when they come up again
+//  OptimizeOverdraw     draws the outward facing clusters of that order first
+//  OptimizeVertexFetch  stores vertices in the order the indices first use
+//                       them, so vertex fetch walks memory forward
+//
+//Quality is measured as ACMR, vertex shader runs per triangle with a FIFO
+//cache, from 3 for unindexed triangles down to about 0.5 for a regular grid.
+class MeshOptimizer
+{ 
+public: 
+	static const unsigned int CacheSize = 16; 
+
+	struct Report
+	{ 
+		unsigned int VerticesBefore = 0; 
+		unsigned int VerticesAfter = 0; 
+		float AcmrBefore = 0.0f; 
+		float AcmrAfter = 0.0f; 
+		//vertex shader runs per vertex, 1 is the best possible
+		float AtvrBefore = 0.0f; 
+		float AtvrAfter = 0.0f; 
+	}; 
+
+	static float ComputeACMR(const unsigned int* indices, unsigned int count, unsigned int vertexCount, unsigned int cacheSize = CacheSize); 
+	static float ComputeATVR(const unsigned int* indices, unsigned int count, unsigned int vertexCount, unsigned int cacheSize = CacheSize); 
+
+	//returns the new vertex count, the unique vertices are moved to the front
+	static unsigned int Deduplicate(void* vertices, unsigned int vertexCount, unsigned int stride, unsigned int* indices, unsigned int count); 
+	//clusters, when given, receives the index offsets where the order had to
+	//jump to an unrelated part of the mesh
+	static void OptimizeVertexCache(unsigned int* indices, unsigned int count, unsigned int vertexCount,
+		unsigned int cacheSize = CacheSize, std::vector<unsigned int>* clusters = nullptr); 
+	//reorders the clusters of a vertex cache optimized order, keeping the ACMR
+	//within threshold times what it was; positions are three floats per vertex
+	static void OptimizeOverdraw(unsigned int* indices, unsigned int count, const void* vertices, unsigned int vertexCount,
+		unsigned int stride, unsigned int positionOffset, const std::vector<unsigned int>& clusters, float threshold = 1.05f); 
+	//returns the new vertex count, vertices no index uses are dropped
+	static unsigned int OptimizeVertexFetch(void* vertices, unsigned int vertexCount, unsigned int stride, unsigned int* indices, unsigned int count); 
+
+	//every pass in order; vertexCount is updated to what is left
+	static Report Optimize(void* vertices, unsigned int& vertexCount, unsigned int stride, unsigned int positionOffset,
+		unsigned int* indices, unsigned int count); 
+}; 
@@ -0,0 +1,221 @@
+#include "Profiler.h"
+#include "Renderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+bool Profiler::s_Enabled = false; 
+
+//one slot per frame in flight, reused once its queries are read back
+struct FrameSlot
+{ 
+    ProfileFrame Frame; 
+    std::vector<unsigned int> Queries; 
+    unsigned int QueriesUsed = 0; 
+    bool Pending = false; 
+}; 
+
+static FrameSlot s_Slots[Profiler::FramesInFlight]; 
+static unsigned int s_CurrentSlot = 0; 
+static unsigned long long s_FrameIndex = 0; 
+static unsigned int s_Depth = 0; 
+static bool s_InFrame = false; 
+static bool s_DebugGroups = false; 
+
+static std::vector<ProfileFrame> s_History; 
+static unsigned int s_HistoryHead = 0; 
+static std::vector<ProfileFrame> s_Capture; 
+static bool s_Capturing = false; 
+
+static std::chrono::steady_clock::time_point s_Epoch; 
+//GPU timestamp (ns) that matches s_Epoch on the CPU
+static long long s_GpuEpoch = 0; 
+
+static double NowMicroseconds()
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - s_Epoch).count(); 
+}
+
+//begin and end query of a scope, returns the index of the begin one
+static unsigned int ReservePair(FrameSlot& slot)
+{
+    if (slot.QueriesUsed + 2 > slot.Queries.size())
+    { 
+        //grow in chunks so steady frames never create queries
+        unsigned int grow = slot.Queries.empty() ? 64 : (unsigned int)slot.Queries.size(); 
+        slot.Queries.resize(slot.Queries.size() + grow); 
+        GLCall(glGenQueries(grow, &slot.Queries[slot.Queries.size() - grow])); 
+    }
+    unsigned int index = slot.QueriesUsed; 
+    slot.QueriesUsed += 2; 
+    return index; 
+}
+
+static double ReadQuery(unsigned int query)
+{
+    int available = 0; 
+    GLCall(glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available)); 
+    if (!available)
+        return -1.0; 
+    GLuint64 timestamp = 0; 
+    GLCall(glGetQueryObjectui64v(query, GL_QUERY_RESULT, &timestamp)); 
+    return ((long long)timestamp - s_GpuEpoch) / 1000.0; 
+}
+
+static void Resolve(FrameSlot& slot)
+{
+    if (!slot.Pending)
+        return; 
+    slot.Pending = false; 
+
+    ProfileFrame& frame = slot.Frame; 
+    for (ProfileRecord& record : frame.Records)
+    { 
+        record.GpuStart = ReadQuery(slot.Queries[record.Query]); 
+        record.GpuEnd = ReadQuery(slot.Queries[record.Query + 1]); 
+    }
+    if (!frame.Records.empty() && frame.Records[0].GpuStart >= 0.0 && frame.Records[0].GpuEnd >= 0.0)
+        frame.GpuMs = (frame.Records[0].GpuEnd - frame.Records[0].GpuStart) / 1000.0; 
+
+    if (s_History.size() < Profiler::HistorySize)
+        s_History.push_back(frame); 
+    else
+    { 
+        s_History[s_HistoryHead] = frame; 
+        s_HistoryHead = (s_HistoryHead + 1) % Profiler::HistorySize; 
+    }
+    if (s_Capturing)
+        s_Capture.push_back(frame); 
+}
+
+void Profiler::SetEnabled(bool enabled)
+{
+    if (enabled && !s_Enabled)
+    { 
+        s_Epoch = std::chrono::steady_clock::now(); 
+        GLint64 now = 0; 
+        GLCall(glGetInteger64v(GL_TIMESTAMP, &now)); 
+        s_GpuEpoch = now; 
+        s_DebugGroups = GLEW_KHR_debug; 
+    }
+    s_Enabled = enabled; 
+}
+
+void Profiler::BeginFrame()
+{
+    if (!s_Enabled)
+        return; 
+
+    s_CurrentSlot = s_FrameIndex % FramesInFlight; 
+    FrameSlot& slot = s_Slots[s_CurrentSlot]; 
+    //this slot was last used FramesInFlight frames ago, its results should be there by now
+    Resolve(slot); 
+
+    slot.Frame.Index = s_FrameIndex; 
+    slot.Frame.CpuMs = 0.0; 
+    slot.Frame.GpuMs = -1.0; 
+    slot.Frame.Records.clear(); 
+    slot.QueriesUsed = 0; 
+    s_Depth = 0; 
+    s_InFrame = true; 
+
+    //the first record spans the whole frame
+    Begin("Frame"); 
+}
+
+void Profiler::EndFrame()
+{
+    if (!s_Enabled || !s_InFrame)
+        return; 
+
+    FrameSlot& slot = s_Slots[s_CurrentSlot]; 
+    End(0); 
+    slot.Frame.CpuMs = (slot.Frame.Records[0].CpuEnd - slot.Frame.Records[0].CpuStart) / 1000.0; 
+    slot.Pending = true; 
+    s_InFrame = false; 
+    s_FrameIndex++; 
+}
+
+unsigned int Profiler::Begin(const char* name)
+{
+    if (!s_InFrame)
+        return ~0u; 
+
+    FrameSlot& slot = s_Slots[s_CurrentSlot]; 
+    ProfileRecord record; 
+    record.Name = name; 
+    record.Depth = s_Depth++; 
+    record.GpuStart = record.GpuEnd = -1.0; 
+    record.Query = ReservePair(slot); 
+    GLCall(glQueryCounter(slot.Queries[record.Query], GL_TIMESTAMP)); 
+
+    if (s_DebugGroups)
+        GLCall(glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name)); 
+
+    record.CpuStart = NowMicroseconds(); 
+    record.CpuEnd = record.CpuStart; 
+    slot.Frame.Records.push_back(record); 
+    return (unsigned int)slot.Frame.Records.size() - 1; 
+}
+
+void Profiler::End(unsigned int index)
+{
+    if (!s_InFrame || index == ~0u)
+        return; 
+
+    FrameSlot& slot = s_Slots[s_CurrentSlot]; 
+    ProfileRecord& record = slot.Frame.Records[index]; 
+    record.CpuEnd = NowMicroseconds(); 
+
+    GLCall(glQueryCounter(slot.Queries[record.Query + 1], GL_TIMESTAMP)); 
+    if (s_DebugGroups)
+        GLCall(glPopDebugGroup()); 
+    s_Depth--; 
+}
+
+const std::vector<ProfileFrame>& Profiler::GetHistory()
+{
+    //keep it in order so callers can just walk it
+    if (s_HistoryHead != 0)
+    { 
+        std::rotate(s_History.begin(), s_History.begin() + s_HistoryHead, s_History.end()); 
+        s_HistoryHead = 0; 
+    }
+    return s_History; 
+}
+
+void Profiler::StartCapture()
+{
+    s_Capture.clear(); 
+    s_Capturing = true; 
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path)
+{
+    s_Capturing = false; 
+
+    std::ofstream stream(path); 
+    if (!stream)
+        return false; 
+
+    stream.setf(std::ios::fixed); 
+    stream.precision(3); 
+    stream << "{\"traceEvents\":[\n"; 
+    stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n"; 
+    stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}"; 
+    for (const ProfileFrame& frame : s_Capture)
+    { 
+        for (const ProfileRecord& record : frame.Records)
+        { 
+            stream << ",\n{\"name\":\"" << record.Name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << record.CpuStart
+                   << ",\"dur\":" << record.CpuEnd - record.CpuStart << ",\"args\":{\"frame\":" << frame.Index << "}}"; 
+            if (record.GpuStart >= 0.0 && record.GpuEnd >= record.GpuStart)
+                stream << ",\n{\"name\":\"" << record.Name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":" << record.GpuStart
+                       << ",\"dur\":" << record.GpuEnd - record.GpuStart << ",\"args\":{\"frame\":" << frame.Index << "}}"; 
+        }
+    }
+    stream << "\n]}\n"; 
+    s_Capture.clear(); 
+    return (bool)stream; 
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+//Build with -DPROFILE_ENABLED=0 to remove every PROFILE_SCOPE from the code.
+//When compiled in but switched off at runtime a scope costs one branch.
+#ifndef PROFILE_ENABLED
+    #define PROFILE_ENABLED 1
+#endif
+
+struct ProfileRecord
+{ 
+	const char* Name; 
+	unsigned int Depth; 
+	//microseconds since the profiler started, GPU times are moved onto the
+	//CPU clock and are negative when the result was not available
+	double CpuStart, CpuEnd; 
+	double GpuStart, GpuEnd; 
+	unsigned int Query; 
+}; 
+
+struct ProfileFrame
+{ 
+	unsigned long long Index; 
+	double CpuMs; 
+	double GpuMs; 
+	std::vector<ProfileRecord> Records; 
+}; 
+
+//Records CPU time and GPU time for nested scopes. GPU time comes from
+//glQueryCounter timestamps, which nest where GL_TIME_ELAPSED queries do not.
+//The queries of a frame are only read FramesInFlight frames later, so
+//reading them never stalls; a frame shows up in the history once its GPU
+//times are in. Scopes also push KHR_debug groups for frame debuggers.
+class Profiler
+{ 
+public: 
+	static const unsigned int FramesInFlight = 3; 
+	static const unsigned int HistorySize = 120; 
+
+	//needs a current context
+	static void SetEnabled(bool enabled); 
+	static inline bool IsEnabled() { return s_Enabled; }
+
+	static void BeginFrame(); 
+	static void EndFrame(); 
+
+	static unsigned int Begin(const char* name); 
+	static void End(unsigned int record); 
+
+	//finished frames, oldest first
+	static const std::vector<ProfileFrame>& GetHistory(); 
+
+	//keeps every finished frame from now on until WriteChromeTrace
+	static void StartCapture(); 
+	//writes the captured frames as Chrome trace_event JSON (chrome://tracing, Perfetto)
+	static bool WriteChromeTrace(const std::string& path); 
+private: 
+	static bool s_Enabled; 
+}; 
+
+class ProfileScope
+{ 
+private: 
+	unsigned int m_Record; 
+public: 
+	ProfileScope(const char* name)
+	  : m_Record(Profiler::IsEnabled() ? Profiler::Begin(name) : ~0u)
+	{ 
+	}
+	~ProfileScope()
+	{ 
+		if (m_Record != ~0u)
+			Profiler::End(m_Record); 
+	}
+}; 
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if PROFILE_ENABLED
+    #define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(_profileScope, __LINE__)(name)
+    #define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#else
+    #define PROFILE_SCOPE(name)
+    #define PROFILE_FUNCTION()
+#endif
@@ -0,0 +1,233 @@
+#include "RangeAllocator.h"
+
+#include <cstring>
+
+static inline unsigned int HighestBit(unsigned int value)
+{
+    return 31 - __builtin_clz(value); 
+}
+
+static inline unsigned int LowestBit(unsigned int value)
+{
+    return __builtin_ctz(value); 
+}
+
+RangeAllocator::RangeAllocator(unsigned int capacity)
+  : m_Capacity(capacity)
+{
+    Reset(); 
+}
+
+void RangeAllocator::Reset()
+{
+    m_Used = 0; 
+    m_Allocations = 0; 
+    m_FreeRanges = 0; 
+    m_Blocks.clear(); 
+    m_SpareBlocks.clear(); 
+    m_FirstLevelMap = 0; 
+    memset(m_SecondLevelMap, 0, sizeof(m_SecondLevelMap)); 
+    memset(m_Bins, 0xff, sizeof(m_Bins)); 
+    if (m_Capacity)
+        InsertFree(NewBlock(0, m_Capacity)); 
+}
+
+//sizes below SecondLevelCount get a bin each, above that every power of two
+//is split into SecondLevelCount bins
+void RangeAllocator::BinOf(unsigned int size, unsigned int& first, unsigned int& second)
+{
+    if (size < SecondLevelCount)
+    {
+        first = 0; 
+        second = size; 
+        return; 
+    }
+    unsigned int top = HighestBit(size); 
+    first = top - SecondLevelBits + 1; 
+    second = (size >> (top - SecondLevelBits)) - SecondLevelCount; 
+}
+
+unsigned int RangeAllocator::NewBlock(unsigned int offset, unsigned int size)
+{
+    unsigned int index; 
+    if (m_SpareBlocks.empty())
+    {
+        index = (unsigned int)m_Blocks.size(); 
+        m_Blocks.push_back(Block()); 
+    }
+    else
+    {
+        index = m_SpareBlocks.back(); 
+        m_SpareBlocks.pop_back(); 
+    }
+    Block& block = m_Blocks[index]; 
+    block.Offset = offset; 
+    block.Size = size; 
+    block.Previous = Invalid; 
+    block.Next = Invalid; 
+    block.PreviousFree = Invalid; 
+    block.NextFree = Invalid; 
+    block.Free = false; 
+    return index; 
+}
+
+void RangeAllocator::InsertFree(unsigned int index)
+{
+    Block& block = m_Blocks[index]; 
+    unsigned int first, second; 
+    BinOf(block.Size, first, second); 
+
+    unsigned int& head = m_Bins[first][second]; 
+    block.Free = true; 
+    block.PreviousFree = Invalid; 
+    block.NextFree = head; 
+    if (head != Invalid)
+        m_Blocks[head].PreviousFree = index; 
+    head = index; 
+
+    m_FirstLevelMap |= 1u << first; 
+    m_SecondLevelMap[first] |= 1u << second; 
+    m_FreeRanges++; 
+}
+
+void RangeAllocator::RemoveFree(unsigned int index)
+{
+    Block& block = m_Blocks[index]; 
+    unsigned int first, second; 
+    BinOf(block.Size, first, second); 
+
+    if (block.PreviousFree != Invalid)
+        m_Blocks[block.PreviousFree].NextFree = block.NextFree; 
+    else
+        m_Bins[first][second] = block.NextFree; 
+    if (block.NextFree != Invalid)
+        m_Blocks[block.NextFree].PreviousFree = block.PreviousFree; 
+
+    if (m_Bins[first][second] == Invalid)
+    {
+        m_SecondLevelMap[first] &= ~(1u << second); 
+        if (!m_SecondLevelMap[first])
+            m_FirstLevelMap &= ~(1u << first); 
+    }
+    block.Free = false; 
+    m_FreeRanges--; 
+}
+
+unsigned int RangeAllocator::FindFree(unsigned int size) const
+{
+    //rounded up to the next bin, so whatever is in the bin found is big enough
+    unsigned long long rounded = size; 
+    if (size >= SecondLevelCount)
+        rounded += (1ull << (HighestBit(size) - SecondLevelBits)) - 1; 
+    if (rounded > 0xffffffffull)
+        return Invalid; 
+
+    unsigned int first, second; 
+    BinOf((unsigned int)rounded, first, second); 
+    if (first >= FirstLevelCount)
+        return Invalid; 
+
+    unsigned int map = m_SecondLevelMap[first] & (~0u << second); 
+    if (!map)
+    {
+        unsigned int firstMap = first + 1 < 32 ? m_FirstLevelMap & (~0u << (first + 1)) : 0; 
+        if (!firstMap)
+            return Invalid; 
+        first = LowestBit(firstMap); 
+        map = m_SecondLevelMap[first]; 
+    }
+    return m_Bins[first][LowestBit(map)]; 
+}
+
+RangeAllocator::Allocation RangeAllocator::Allocate(unsigned int size)
+{
+    Allocation allocation; 
+    if (!size)
+        return allocation; 
+    unsigned int index = FindFree(size); 
+    if (index == Invalid)
+        return allocation; 
+
+    RemoveFree(index); 
+    if (m_Blocks[index].Size > size)
+    {
+        //the rest stays free right behind the allocation
+        unsigned int rest = NewBlock(m_Blocks[index].Offset + size, m_Blocks[index].Size - size); 
+        Block& block = m_Blocks[index]; 
+        m_Blocks[rest].Previous = index; 
+        m_Blocks[rest].Next = block.Next; 
+        if (block.Next != Invalid)
+            m_Blocks[block.Next].Previous = rest; 
+        block.Next = rest; 
+        block.Size = size; 
+        InsertFree(rest); 
+    }
+
+    m_Used += size; 
+    m_Allocations++; 
+    allocation.Offset = m_Blocks[index].Offset; 
+    allocation.Size = size; 
+    allocation.Block = index; 
+    allocation.Generation = m_Blocks[index].Generation; 
+    return allocation; 
+}
+
+void RangeAllocator::Free(const Allocation& allocation)
+{
+    if (!allocation.IsValid() || allocation.Block >= m_Blocks.size())
+        return; 
+    Block& block = m_Blocks[allocation.Block]; 
+    if (block.Free || block.Generation != allocation.Generation || block.Offset != allocation.Offset)
+        return; 
+    block.Generation++; 
+
+    unsigned int index = allocation.Block; 
+    m_Used -= m_Blocks[index].Size; 
+    m_Allocations--; 
+
+    unsigned int next = m_Blocks[index].Next; 
+    if (next != Invalid && m_Blocks[next].Free)
+    {
+        RemoveFree(next); 
+        m_Blocks[index].Size += m_Blocks[next].Size; 
+        m_Blocks[index].Next = m_Blocks[next].Next; 
+        if (m_Blocks[index].Next != Invalid)
+            m_Blocks[m_Blocks[index].Next].Previous = index; 
+        m_SpareBlocks.push_back(next); 
+    }
+
+    unsigned int previous = m_Blocks[index].Previous; 
+    if (previous != Invalid && m_Blocks[previous].Free)
+    {
+        RemoveFree(previous); 
+        m_Blocks[previous].Size += m_Blocks[index].Size; 
+        m_Blocks[previous].Next = m_Blocks[index].Next; 
+        if (m_Blocks[previous].Next != Invalid)
+            m_Blocks[m_Blocks[previous].Next].Previous = previous; 
+        m_SpareBlocks.push_back(index); 
+        index = previous; 
+    }
+    InsertFree(index); 
+}
+
+RangeAllocator::Stats RangeAllocator::GetStats() const
+{
+    Stats stats; 
+    stats.Capacity = m_Capacity; 
+    stats.Used = m_Used; 
+    stats.Allocations = m_Allocations; 
+    stats.FreeRanges = m_FreeRanges; 
+
+    //the largest range is in the highest bin that has any
+    if (m_FirstLevelMap)
+    {
+        unsigned int first = HighestBit(m_FirstLevelMap); 
+        unsigned int second = HighestBit(m_SecondLevelMap[first]); 
+        for (unsigned int index = m_Bins[first][second]; index != Invalid; index = m_Blocks[index].NextFree)
+            if (m_Blocks[index].Size > stats.LargestFree)
+                stats.LargestFree = m_Blocks[index].Size; 
+    }
+    unsigned int free = m_Capacity - m_Used; 
+    stats.Fragmentation = free ? 1.0f - (float)stats.LargestFree / free : 0.0f; 
+    return stats; 
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+
+//Two-level segregated fit allocator of ranges in [0, capacity), in whatever
+//unit the caller counts, e.g. vertices or indices. Free ranges sit in bins
+//by size, 16 bins per power of two, with a bitmap per level, so allocating
+//and freeing take constant time however many ranges there are. A freed
+//range merges with free neighbours right away.
+//
+//Only offsets are managed, the memory itself is somewhere else, usually a
+//GL buffer.
+class RangeAllocator
+{
+public:
+	static const unsigned int Invalid = ~0u; 
+
+	struct Allocation
+	{
+		unsigned int Offset = Invalid; 
+		unsigned int Size = 0; 
+		//block of the allocator and its generation, for Free
+		unsigned int Block = Invalid; 
+		unsigned int Generation = 0; 
+
+		inline bool IsValid() const { return Offset != Invalid; }
+	}; 
+
+	struct Stats
+	{
+		unsigned int Capacity = 0; 
+		unsigned int Used = 0; 
+		unsigned int Allocations = 0; 
+		unsigned int FreeRanges = 0; 
+		unsigned int LargestFree = 0; 
+		//1 - LargestFree / free space: 0 when all free space is one range,
+		//near 1 when it is scattered in pieces too small to use
+		float Fragmentation = 0.0f; 
+	}; 
+private:
+	static const unsigned int SecondLevelBits = 4; 
+	static const unsigned int SecondLevelCount = 1 << SecondLevelBits; 
+	static const unsigned int FirstLevelCount = 32 - SecondLevelBits + 1; 
+
+	struct Block
+	{
+		unsigned int Offset; 
+		unsigned int Size; 
+		//neighbours in memory
+		unsigned int Previous; 
+		unsigned int Next; 
+		//neighbours in the bin, while free
+		unsigned int PreviousFree; 
+		unsigned int NextFree; 
+		//moves on whenever the block's allocation is freed, so freeing it
+		//again is ignored even after the block was merged or reused
+		unsigned int Generation; 
+		bool Free; 
+	}; 
+
+	unsigned int m_Capacity; 
+	unsigned int m_Used; 
+	unsigned int m_Allocations; 
+	unsigned int m_FreeRanges; 
+	std::vector<Block> m_Blocks; 
+	//entries of m_Blocks not in use
+	std::vector<unsigned int> m_SpareBlocks; 
+
+	unsigned int m_FirstLevelMap; 
+	unsigned int m_SecondLevelMap[FirstLevelCount]; 
+	unsigned int m_Bins[FirstLevelCount][SecondLevelCount]; 
+
+	static void BinOf(unsigned int size, unsigned int& first, unsigned int& second); 
+	unsigned int NewBlock(unsigned int offset, unsigned int size); 
+	void InsertFree(unsigned int block); 
+	void RemoveFree(unsigned int block); 
+	//a free block of at least size, or Invalid
+	unsigned int FindFree(unsigned int size) const; 
+public:
+	RangeAllocator(unsigned int capacity); 
+
+	//invalid when there is no room, and for a size of 0
+	Allocation Allocate(unsigned int size); 
+	//invalid and stale allocations are ignored
+	void Free(const Allocation& allocation); 
+	//forgets every allocation
+	void Reset(); 
+
+	inline unsigned int GetCapacity() const { return m_Capacity; }
+	inline unsigned int GetUsed() const { return m_Used; }
+	Stats GetStats() const; 
+}; 
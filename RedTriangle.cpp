@@ -3,98 +3,14 @@
 #include <GLFW/glfw3.h>
 
 #include <iostream>
-#include <fstream> 
 #include <string>
-#include <sstream>
 
 #include "GLError.h"
+#include "Shader.h"
+#include "Context.h"
 
 using namespace std; 
 
-struct ShaderProgramSource
-{ 
-    string VertexSource; 
-    string FragmentSource; 
-}; 
-
-static ShaderProgramSource ParseShader(const string& filepath)
-{ 
-    ifstream stream(filepath); 
-
-    enum class ShaderType
-    { 
-
-        NONE = -1, VERTEX = 0, FRAGMENT = 1
-    };
-
-    string line;
-    stringstream ss[2] ; 
-    ShaderType type = ShaderType::NONE; 
-    while (getline(stream, line))
-    { 
-        if (line.find("#shader") != string::npos)
-        { 
-            if (line.find("vertex") != string::npos)
-               type = ShaderType::VERTEX; 
-            else if (line.find("fragment") != string::npos)
-                type = ShaderType::FRAGMENT; 
-        }
-        else 
-        { 
-            ss[int(type)] << line << '\n'; 
-        }
-    }
-
-    return { ss[0].str(), ss[1].str() };
-}
-
-static unsigned int CompileShader(unsigned int type, const string& source)
-{ 
-    //cout << "Compiling Shader" << endl; 
-      
-    unsigned int id = glCreateShader(type);
-    //pointer to the begining of our data
-    const char* src = source.c_str(); 
-    glShaderSource(id, 1, &src, nullptr); 
-    glCompileShader(id); 
-
-    //Error Handling: Anything wrong with the shder?
-    int result; 
-    glGetShaderiv(id, GL_COMPILE_STATUS, &result); 
-
-    if (result == GL_FALSE)
-    { 
-        int length; 
-        glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
-        char* message = (char*)alloca(length * sizeof(char)); 
-        glGetShaderInfoLog(id, length, &length, message); 
-        cout << "Failed to compile shader!" << (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader!" << endl; 
-        cout << message << endl; 
-        glDeleteShader(id); 
-        return 0; 
-    }
-
-    return id; 
-}
-
-static unsigned int CreateShader(const string& vertexShader, const string& fragmentshader)
-{
-    //cout << "Creating Shader" << endl; 
-    unsigned int program = glCreateProgram(); 
-    unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexShader); 
-    unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragmentshader);
-
-    glAttachShader(program, vs);  
-    glAttachShader(program, fs);
-    glLinkProgram(program); 
-    glValidateProgram(program); 
-
-    glDeleteShader(vs); 
-    glDeleteShader(fs); 
-
-    return program; 
-}
-
 int main(void)
 {
     GLFWwindow* window;
@@ -200,7 +116,7 @@ int main(void)
         glDrawArrays(GL_TRIANGLES, 0, 3);
 
         /* Swap front and back buffers */
-        glfwSwapBuffers(window);
+        Context::SwapWindow(window); 
 
         /* Poll for and process events */
         glfwPollEvents();
@@ -208,6 +124,6 @@ int main(void)
 
     glDeleteProgram(shader); 
 
-    glfwTerminate();
+    Context::Terminate(); 
     return 0;
 }
\ No newline at end of file
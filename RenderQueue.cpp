@@ -0,0 +1,178 @@
+#include "RenderQueue.h"
+#include "Renderer.h"
+#include "GLState.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "VertexArray.h"
+#include "IndexBuffer.h"
+
+#include <chrono>
+#include <cstring>
+
+using namespace std; 
+
+const unsigned int RenderQueue::LayerBits; 
+const unsigned int RenderQueue::NameBits; 
+const unsigned int RenderQueue::DepthBits; 
+
+static const unsigned long long NameMask = (1ull << RenderQueue::NameBits) - 1; 
+static const unsigned long long DepthMask = (1ull << RenderQueue::DepthBits) - 1; 
+
+RenderQueue::RenderQueue(unsigned int capacity)
+{
+    m_Draws.reserve(capacity); 
+    m_Entries.reserve(capacity); 
+    m_Scratch.reserve(capacity); 
+}
+
+unsigned long long RenderQueue::MakeKey(unsigned int layer, bool translucent, unsigned int program, unsigned int texture, unsigned int vertexArray, float depth)
+{
+    if (!(depth > 0.0f))
+        depth = 0.0f; 
+    if (depth > 1.0f)
+        depth = 1.0f; 
+    unsigned long long d = (unsigned long long)(depth * DepthMask); 
+    unsigned long long state = ((program & NameMask) << (2 * NameBits)) | ((texture & NameMask) << NameBits) | (vertexArray & NameMask); 
+
+    unsigned long long key = (unsigned long long)(layer & ((1u << LayerBits) - 1)) << (64 - LayerBits); 
+    if (!translucent)
+        return key | (state << DepthBits) | d; 
+    //far ones first so they blend under the near ones
+    return key | (1ull << (63 - LayerBits)) | ((DepthMask - d) << (3 * NameBits)) | state; 
+}
+
+void RenderQueue::Clear()
+{
+    m_Draws.clear(); 
+    m_Entries.clear(); 
+    m_Stats = Stats(); 
+}
+
+void RenderQueue::Add(const Draw& draw, unsigned int layer, bool translucent, float depth)
+{
+    unsigned int texture = draw.TextureMap ? draw.TextureMap->GetRendererID() : 0; 
+    Add(draw, MakeKey(layer, translucent, draw.Program->GetRendererID(), texture, draw.Geometry->GetRendererID(), depth)); 
+}
+
+void RenderQueue::Add(const Draw& draw, unsigned long long key)
+{
+    m_Entries.push_back({ key, (unsigned int)m_Draws.size() }); 
+    m_Draws.push_back(draw); 
+}
+
+void RenderQueue::Sort()
+{
+    auto start = chrono::steady_clock::now(); 
+    unsigned int count = (unsigned int)m_Entries.size(); 
+
+    //what submitting in the order of Add would have cost, for the stats
+    //counted the way Execute counts
+    const Shader* program = nullptr; 
+    const Texture* texture = nullptr; 
+    const VertexArray* geometry = nullptr; 
+    int blend = -1; 
+    unsigned int unsorted = 0; 
+    for (const SortEntry& entry : m_Entries)
+    { 
+        const Draw& draw = m_Draws[entry.Index]; 
+        int translucent = IsTranslucent(entry.Key); 
+        unsorted += (draw.Program != program) + (draw.TextureMap && draw.TextureMap != texture) 
+            + (draw.Geometry != geometry) + (translucent != blend); 
+        program = draw.Program; 
+        if (draw.TextureMap)
+            texture = draw.TextureMap; 
+        geometry = draw.Geometry; 
+        blend = translucent; 
+    }
+    m_Stats.UnsortedChanges = unsorted; 
+
+    //all eight byte histograms in one pass, then one scatter per byte that
+    //actually differs between keys; layer and translucency bytes are
+    //usually the same for every draw and get skipped
+    unsigned int histograms[8][256]; 
+    memset(histograms, 0, sizeof(histograms)); 
+    for (const SortEntry& entry : m_Entries)
+        for (unsigned int b = 0; b < 8; b++)
+            histograms[b][(entry.Key >> (b * 8)) & 0xff]++; 
+
+    m_Scratch.resize(count); 
+    SortEntry* source = m_Entries.data(); 
+    SortEntry* destination = m_Scratch.data(); 
+    for (unsigned int b = 0; count > 1 && b < 8; b++)
+    { 
+        unsigned int* histogram = histograms[b]; 
+        if (histogram[(source[0].Key >> (b * 8)) & 0xff] == count)
+            continue; 
+
+        unsigned int offset = 0; 
+        for (unsigned int i = 0; i < 256; i++)
+        { 
+            unsigned int n = histogram[i]; 
+            histogram[i] = offset; 
+            offset += n; 
+        }
+        for (unsigned int i = 0; i < count; i++)
+            destination[histogram[(source[i].Key >> (b * 8)) & 0xff]++] = source[i]; 
+        swap(source, destination); 
+    }
+    if (source != m_Entries.data())
+        m_Entries.swap(m_Scratch); 
+
+    m_Stats.SortMs += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(); 
+}
+
+void RenderQueue::Execute()
+{
+    auto start = chrono::steady_clock::now(); 
+
+    Shader* program = nullptr; 
+    const Texture* texture = nullptr; 
+    const VertexArray* geometry = nullptr; 
+    //unknown until the first draw sets it
+    int blend = -1; 
+    for (const SortEntry& entry : m_Entries)
+    { 
+        const Draw& draw = m_Draws[entry.Index]; 
+        int translucent = IsTranslucent(entry.Key); 
+
+        if (draw.Program != program)
+        { 
+            program = draw.Program; 
+            program->Bind(); 
+            m_Stats.ProgramChanges++; 
+        }
+        if (draw.TextureMap && draw.TextureMap != texture)
+        { 
+            texture = draw.TextureMap; 
+            texture->Bind(0); 
+            m_Stats.TextureChanges++; 
+        }
+        if (draw.Geometry != geometry)
+        { 
+            geometry = draw.Geometry; 
+            geometry->Bind(); 
+            m_Stats.VertexArrayChanges++; 
+        }
+        if (translucent != blend)
+        { 
+            blend = translucent; 
+            GLState::SetEnabled(GL_BLEND, blend != 0); 
+            m_Stats.BlendChanges++; 
+        }
+
+        if (draw.TransformHandle >= 0)
+            draw.Program->SetUniform4f(draw.TransformHandle, draw.Transform[0], draw.Transform[1], draw.Transform[2], draw.Transform[3]); 
+        if (draw.ColorHandle >= 0)
+            draw.Program->SetUniform4f(draw.ColorHandle, draw.Color[0], draw.Color[1], draw.Color[2], draw.Color[3]); 
+
+        unsigned int type = draw.Geometry->GetIndexType(); 
+        const void* indices = (const void*)(size_t)(draw.FirstIndex * IndexBuffer::SizeOf(type)); 
+        GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, draw.IndexCount, type, indices, draw.BaseVertex)); 
+    }
+    //later drawing expects the default
+    if (blend == 1)
+        GLState::SetEnabled(GL_BLEND, false); 
+
+    m_Stats.Draws += (unsigned int)m_Entries.size(); 
+    m_Stats.ExecuteMs += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(); 
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+
+class Shader; 
+class Texture; 
+class VertexArray; 
+
+//Collects a frame's draws with a 64-bit sort key each, radix sorts them and
+//submits them in key order through Shader, Texture, VertexArray and the
+//state tracker, so draws sharing a program, texture or vertex array end up
+//next to each other and the state changes between them go away. Keys sort
+//from the most significant bit:
+//
+//  opaque:      layer:4 | 0 | program:12 | texture:12 | vertex array:12 | depth:23
+//  translucent: layer:4 | 1 | ~depth:23 | program:12 | texture:12 | vertex array:12
+//
+//so opaque draws are grouped by state and go front to back within a group,
+//translucent ones come after them, back to front. Only the low 12 bits of
+//the GL names go into the key; names that collide just sort less well.
+//Draws with equal keys keep the order they were added in.
+class RenderQueue
+{ 
+public: 
+	static const unsigned int LayerBits = 4; 
+	static const unsigned int NameBits = 12; 
+	static const unsigned int DepthBits = 23; 
+
+	struct Draw
+	{ 
+		Shader* Program; 
+		//null draws without touching texture unit 0
+		const Texture* TextureMap; 
+		const VertexArray* Geometry; 
+		unsigned int IndexCount; 
+		unsigned int FirstIndex; 
+		int BaseVertex; 
+		//the per-object vec4s of the Object shader, handles from
+		//Shader::GetUniform, -1 leaves the uniform alone
+		int TransformHandle; 
+		float Transform[4]; 
+		int ColorHandle; 
+		float Color[4]; 
+	}; 
+
+	struct Stats
+	{ 
+		unsigned int Draws = 0; 
+		unsigned int ProgramChanges = 0; 
+		unsigned int TextureChanges = 0; 
+		unsigned int VertexArrayChanges = 0; 
+		unsigned int BlendChanges = 0; 
+		//what the same draws would have changed in the order they were added,
+		//filled in by Sort
+		unsigned int UnsortedChanges = 0; 
+		double SortMs = 0.0; 
+		double ExecuteMs = 0.0; 
+
+		inline unsigned int GetChanges() const { return ProgramChanges + TextureChanges + VertexArrayChanges + BlendChanges; }
+		inline unsigned int GetAvoided() const { return UnsortedChanges > GetChanges() ? UnsortedChanges - GetChanges() : 0; }
+	}; 
+private: 
+	struct SortEntry
+	{ 
+		unsigned long long Key; 
+		unsigned int Index; 
+	}; 
+
+	std::vector<Draw> m_Draws; 
+	std::vector<SortEntry> m_Entries; 
+	std::vector<SortEntry> m_Scratch; 
+	Stats m_Stats; 
+public: 
+	RenderQueue(unsigned int capacity = 1024); 
+
+	//depth is the view depth mapped to [0, 1], 0 nearest
+	static unsigned long long MakeKey(unsigned int layer, bool translucent, unsigned int program, unsigned int texture, unsigned int vertexArray, float depth); 
+	static inline bool IsTranslucent(unsigned long long key) { return (key >> (63 - LayerBits)) & 1; }
+
+	//call at the start of every frame, keeps the memory and resets the stats
+	void Clear(); 
+	//key built from the draw's program, texture and vertex array
+	void Add(const Draw& draw, unsigned int layer, bool translucent, float depth); 
+	void Add(const Draw& draw, unsigned long long key); 
+
+	//stable LSD radix sort on the keys, without it Execute goes in the order of Add
+	void Sort(); 
+	//GL thread only; blending is on for translucent draws and off for opaque
+	//ones, the blend function is left to the caller
+	void Execute(); 
+
+	inline unsigned int GetCount() const { return (unsigned int)m_Entries.size(); }
+	inline const Stats& GetStats() const { return m_Stats; }
+}; 
@@ -0,0 +1,226 @@
+#include <GL/glew.h>
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "Renderer.h"
+#include "Context.h"
+#include "GLState.h"
+#include "RenderQueue.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+
+using namespace std; 
+
+//Submits 100k draws over a mix of programs, textures and vertex arrays in
+//the order they were generated and again sorted by key, and prints the
+//times and state changes of both as JSON, e.g.
+//
+//  ./RenderQueueBench --draws 100000 --iterations 20 > queue.json
+//
+//Every program is a separate link of the Object shader and every texture is
+//1x1, so the cost is the state changes and draw calls, not the pixels.
+
+struct Result
+{ 
+    double SortMs, ExecuteMs, FrameMs; 
+    RenderQueue::Stats Queue; 
+    GLState::Stats State; 
+}; 
+
+static float Random()
+{ 
+    return rand() / (float)RAND_MAX; 
+}
+
+//median of the iterations, so a hiccup of the driver does not decide it
+static Result Run(RenderQueue& queue, const vector<RenderQueue::Draw>& draws, const vector<unsigned long long>& keys, bool sorted, int iterations)
+{ 
+    vector<Result> results; 
+    for (int i = 0; i < iterations; i++)
+    { 
+        GLState::ResetStats(); 
+        auto start = chrono::steady_clock::now(); 
+        queue.Clear(); 
+        for (size_t d = 0; d < draws.size(); d++)
+            queue.Add(draws[d], keys[d]); 
+        if (sorted)
+            queue.Sort(); 
+        queue.Execute(); 
+        GLCall(glFinish());
+
+        Result result; 
+        result.FrameMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(); 
+        result.Queue = queue.GetStats(); 
+        result.SortMs = result.Queue.SortMs; 
+        result.ExecuteMs = result.Queue.ExecuteMs; 
+        result.State = GLState::GetStats(); 
+        results.push_back(result); 
+    }
+    sort(results.begin(), results.end(), [](const Result& a, const Result& b) { return a.FrameMs < b.FrameMs; }); 
+    return results[results.size() / 2]; 
+}
+
+static void Print(const char* name, const Result& r, bool last)
+{ 
+    cout << "    \"" << name << "\": { \"frame_ms\": " << r.FrameMs << ", \"sort_ms\": " << r.SortMs 
+         << ", \"execute_ms\": " << r.ExecuteMs << ", \"program_changes\": " << r.Queue.ProgramChanges 
+         << ", \"texture_changes\": " << r.Queue.TextureChanges << ", \"vertex_array_changes\": " << r.Queue.VertexArrayChanges 
+         << ", \"blend_changes\": " << r.Queue.BlendChanges << ", \"gl_state_issued\": " << r.State.Issued 
+         << ", \"gl_state_elided\": " << r.State.Elided << " }" << (last ? "\n" : ",\n"); 
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int drawCount = 100000; 
+    int iterations = 20; 
+    unsigned int programCount = 16; 
+    unsigned int textureCount = 64; 
+    unsigned int geometryCount = 32; 
+    for (int i = 1; i < argc; i++)
+    { 
+        if (!strcmp(argv[i], "--draws") && i + 1 < argc)
+            drawCount = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--iterations") && i + 1 < argc)
+            iterations = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--programs") && i + 1 < argc)
+            programCount = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--textures") && i + 1 < argc)
+            textureCount = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--geometry") && i + 1 < argc)
+            geometryCount = atoi(argv[++i]); 
+        else
+        { 
+            cerr << "usage: RenderQueueBench [--draws n] [--iterations n] [--programs n] [--textures n] [--geometry n]" << endl; 
+            return -1; 
+        }
+    }
+    if (iterations < 1)
+        iterations = 1; 
+    if (!programCount || !textureCount || !geometryCount)
+    { 
+        cerr << "every kind of state needs at least one object" << endl; 
+        return -1; 
+    }
+
+    ContextOptions options; 
+    options.Title = "RenderQueueBench"; 
+    options.SwapInterval = 0; 
+    options.Headless = true; 
+    Context context(options); 
+    if (!context.IsValid())
+        return -1; 
+
+    {
+    vector<Shader*> programs; 
+    vector<int> transformHandles, colorHandles; 
+    for (unsigned int i = 0; i < programCount; i++)
+    { 
+        Shader* program = new Shader("res/shaders/Object.shader"); 
+        programs.push_back(program); 
+        transformHandles.push_back(program->GetUniform("u_Transform")); 
+        colorHandles.push_back(program->GetUniform("u_Color")); 
+    }
+
+    vector<Texture*> textures; 
+    for (unsigned int i = 0; i < textureCount; i++)
+    { 
+        unsigned char pixel[4] = { (unsigned char)(i * 37), (unsigned char)(i * 91), (unsigned char)(i * 13), 255 }; 
+        Texture* texture = new Texture(1, 1); 
+        texture->SetData(pixel); 
+        textures.push_back(texture); 
+    }
+
+    //every vertex array has buffers of its own, like separate meshes would
+    Float2 positions[] = { 
+       { -0.5f, -0.5f }, 
+       {  0.5f, -0.5f }, 
+       {  0.5f,  0.5f }, 
+       { -0.5f,  0.5f }, 
+    }; 
+    unsigned int indices[] = { 0, 1, 2, 2, 3, 0 };
+    vector<VertexArray*> geometry; 
+    vector<VertexBuffer*> vertexBuffers; 
+    vector<IndexBuffer*> indexBuffers; 
+    for (unsigned int i = 0; i < geometryCount; i++)
+    { 
+        VertexArray* va = new VertexArray(); 
+        VertexBuffer* vb = new VertexBuffer(positions, sizeof(positions)); 
+        IndexBuffer* ib = new IndexBuffer(indices, 6); 
+        va->AddBuffer<Float2>(*vb); 
+        va->SetIndexBuffer(*ib); 
+        geometry.push_back(va); 
+        vertexBuffers.push_back(vb); 
+        indexBuffers.push_back(ib); 
+    }
+
+    //a fifth translucent, spread over two layers, in random order
+    srand(1); 
+    vector<RenderQueue::Draw> draws(drawCount); 
+    vector<unsigned long long> keys(drawCount); 
+    for (unsigned int i = 0; i < drawCount; i++)
+    { 
+        RenderQueue::Draw& draw = draws[i]; 
+        unsigned int program = rand() % programCount; 
+        draw.Program = programs[program]; 
+        draw.TextureMap = textures[rand() % textureCount]; 
+        draw.Geometry = geometry[rand() % geometryCount]; 
+        draw.IndexCount = 6; 
+        draw.FirstIndex = 0; 
+        draw.BaseVertex = 0; 
+        draw.TransformHandle = transformHandles[program]; 
+        draw.Transform[0] = Random() * 2.0f - 1.0f; 
+        draw.Transform[1] = Random() * 2.0f - 1.0f; 
+        draw.Transform[2] = 0.01f; 
+        draw.Transform[3] = Random() * 6.28f; 
+        draw.ColorHandle = colorHandles[program]; 
+        bool translucent = rand() % 5 == 0; 
+        draw.Color[0] = Random(); 
+        draw.Color[1] = Random(); 
+        draw.Color[2] = Random(); 
+        draw.Color[3] = translucent ? 0.5f : 1.0f; 
+        keys[i] = RenderQueue::MakeKey(rand() % 2, translucent, draw.Program->GetRendererID(), draw.TextureMap->GetRendererID(), 
+            draw.Geometry->GetRendererID(), Random()); 
+    }
+
+    GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); 
+    RenderQueue queue(drawCount); 
+    //first run warms up the driver and the queue's buffers
+    Run(queue, draws, keys, true, 1); 
+    Result unsorted = Run(queue, draws, keys, false, iterations); 
+    Result sorted = Run(queue, draws, keys, true, iterations); 
+
+    cout.setf(ios::fixed); 
+    cout.precision(4); 
+    cout << "{\n  \"renderer\": \"" << glGetString(GL_RENDERER) << "\",\n"
+         << "  \"draws\": " << drawCount << ",\n"
+         << "  \"programs\": " << programCount << ",\n"
+         << "  \"textures\": " << textureCount << ",\n"
+         << "  \"vertex_arrays\": " << geometryCount << ",\n"
+         << "  \"iterations\": " << iterations << ",\n"
+         << "  \"results\": {\n"; 
+    Print("unsorted", unsorted, false); 
+    Print("sorted", sorted, false); 
+    cout << "    \"state_changes_avoided\": " << sorted.Queue.GetAvoided() << "\n  },\n"
+         << "  \"speedup\": " << unsorted.FrameMs / sorted.FrameMs << "\n}" << endl; 
+
+    for (VertexArray* va : geometry)
+        delete va; 
+    for (VertexBuffer* vb : vertexBuffers)
+        delete vb; 
+    for (IndexBuffer* ib : indexBuffers)
+        delete ib; 
+    for (Texture* texture : textures)
+        delete texture; 
+    for (Shader* program : programs)
+        delete program; 
+    }
+    return 0; 
+}
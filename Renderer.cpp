@@ -1,4 +1,8 @@
 #include "Renderer.h"
+#include "VertexArray.h"
+#include "IndexBuffer.h"
+#include "Shader.h"
+#include "Profiler.h"
 #include <iostream>
 
 void GLClearError()
@@ -10,9 +14,29 @@ bool GLLogCall(const char* function, const char* file, int line)
 { 
     while (GLenum error = glGetError())
     {
-        cout << "[OpenGL Error] (" << error << "): " << function <<
-         " " << file << ":" << line << endl; 
+        GLReportError(error, function, file, line); 
         return false; 
     }
     return true; 
-}
\ No newline at end of file
+}
+
+void Renderer::Clear() const
+{
+    GLCall(glClear(GL_COLOR_BUFFER_BIT));
+}
+
+void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const
+{
+    PROFILE_FUNCTION(); 
+    shader.Bind(); 
+    va.Bind(); 
+    GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), ib.GetType(), nullptr));
+}
+
+void Renderer::DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const
+{
+    PROFILE_FUNCTION(); 
+    shader.Bind(); 
+    va.Bind(); 
+    GLCall(glDrawElementsInstanced(GL_TRIANGLES, ib.GetCount(), ib.GetType(), nullptr, instanceCount));
+}
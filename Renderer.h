@@ -1,15 +1,49 @@
 #pragma once
 
 #include <GL/glew.h>
-#include <signal.h>
+
+#include "GLError.h"
+#include "Log.h"
+#include "Assert.h"
 
 using namespace std; 
 
-#define LOG(x) cout << x << endl; 
-#define ASSERT(x) if (!(x)) raise(SIGTRAP);
-#define GLCall(x) GLClearError();\
-    x;\
-    ASSERT(GLLogCall(#x, __FILE__, __LINE__))
+//kept for older code, new code picks a level
+#define LOG(x) LOG_INFO("{}", x)
+
+//see GLError.h for the checking levels
+#if GL_CHECK_LEVEL == GL_CHECK_OFF
+    #define GLCall(x) x
+#elif GL_CHECK_LEVEL == GL_CHECK_SAMPLED
+    #define GLCall(x) do { \
+        static const GLCallSite _glSite = { #x, __FILE__, __LINE__ }; \
+        GLRecordCall(&_glSite); \
+        x; \
+        GLSampleCheck(&_glSite); \
+    } while (0)
+#else
+    #define GLCall(x) do { \
+        static const GLCallSite _glSite = { #x, __FILE__, __LINE__ }; \
+        GLRecordCall(&_glSite); \
+        GLClearError(); \
+        x; \
+        ASSERT(GLLogCall(#x, __FILE__, __LINE__)) \
+    } while (0)
+#endif
 
 void GLClearError();
 bool GLLogCall(const char* function, const char* file, int line);
+
+class VertexArray; 
+class IndexBuffer; 
+class Shader; 
+
+class Renderer
+{ 
+public: 
+	void Clear() const; 
+	void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const; 
+	//draws the same indexed mesh instanceCount times in one call, per-instance
+	//data comes from VertexArray bindings added with a divisor of 1
+	void DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const; 
+}; 
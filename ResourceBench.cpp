@@ -0,0 +1,131 @@
+#include <GL/glew.h>
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "Renderer.h"
+#include "Context.h"
+#include "GLState.h"
+#include "ResourceManager.h"
+#include "VertexBuffer.h"
+
+using namespace std; 
+
+//Creates and drops thousands of small vertex buffers a frame, once with a
+//glGenBuffers and glDeleteBuffers each and once through the ResourceManager,
+//and prints the CPU time of both as JSON, e.g.
+//
+//  ./ResourceBench --buffers 2000 --frames 200 > resources.json
+//
+//Both fill every buffer with glBufferData, so the difference is the name
+//management and where the deletes happen.
+
+//median of the frames
+static double Median(vector<double>& times)
+{
+    sort(times.begin(), times.end()); 
+    return times[times.size() / 2]; 
+}
+
+static double RunRaw(Context& context, unsigned int bufferCount, unsigned int frames, const vector<char>& data)
+{
+    vector<double> times; 
+    vector<unsigned int> buffers(bufferCount); 
+    for (unsigned int frame = 0; frame < frames; frame++)
+    {
+        auto start = chrono::steady_clock::now(); 
+        for (unsigned int i = 0; i < bufferCount; i++)
+        {
+            GLCall(glGenBuffers(1, &buffers[i]));
+            GLState::BindBuffer(GL_ARRAY_BUFFER, buffers[i]); 
+            GLCall(glBufferData(GL_ARRAY_BUFFER, data.size(), data.data(), GL_STATIC_DRAW));
+        }
+        for (unsigned int i = 0; i < bufferCount; i++)
+            GLState::DeleteBuffer(buffers[i]); 
+        times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count()); 
+        context.SwapBuffers(); 
+    }
+    return Median(times); 
+}
+
+static double RunManaged(Context& context, unsigned int bufferCount, unsigned int frames, const vector<char>& data)
+{
+    vector<double> times; 
+    vector<VertexBuffer> buffers; 
+    buffers.reserve(bufferCount); 
+    for (unsigned int frame = 0; frame < frames; frame++)
+    {
+        auto start = chrono::steady_clock::now(); 
+        for (unsigned int i = 0; i < bufferCount; i++)
+            buffers.emplace_back(data.data(), (unsigned int)data.size()); 
+        buffers.clear(); 
+        times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count()); 
+        //the names of this frame are deleted once the GPU is past it
+        context.SwapBuffers(); 
+    }
+    return Median(times); 
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int bufferCount = 2000; 
+    unsigned int frames = 200; 
+    unsigned int size = 256; 
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--buffers") && i + 1 < argc)
+            bufferCount = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+            frames = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--size") && i + 1 < argc)
+            size = atoi(argv[++i]); 
+        else
+        {
+            cerr << "usage: ResourceBench [--buffers n] [--frames n] [--size bytes]" << endl; 
+            return -1; 
+        }
+    }
+    if (!bufferCount || !frames || !size)
+    {
+        cerr << "needs at least one buffer, frame and byte" << endl; 
+        return -1; 
+    }
+
+    ContextOptions options; 
+    options.Title = "ResourceBench"; 
+    options.SwapInterval = 0; 
+    options.Headless = true; 
+    Context context(options); 
+    if (!context.IsValid())
+        return -1; 
+
+    vector<char> data(size, 1); 
+    //first runs warm up the driver and fill the pools
+    RunRaw(context, bufferCount, 1, data); 
+    RunManaged(context, bufferCount, 1, data); 
+
+    double raw = RunRaw(context, bufferCount, frames, data); 
+    ResourceManager::Stats before = ResourceManager::GetStats(); 
+    double managed = RunManaged(context, bufferCount, frames, data); 
+    GLCall(glFinish());
+    context.SwapBuffers(); 
+    ResourceManager::Stats after = ResourceManager::GetStats(); 
+
+    cout.setf(ios::fixed); 
+    cout.precision(4); 
+    cout << "{\n  \"renderer\": \"" << glGetString(GL_RENDERER) << "\",\n"
+         << "  \"buffers_per_frame\": " << bufferCount << ",\n"
+         << "  \"frames\": " << frames << ",\n"
+         << "  \"buffer_size\": " << size << ",\n"
+         << "  \"raw\": { \"frame_ms\": " << raw << ", \"ns_per_buffer\": " << raw * 1e6 / bufferCount
+         << ", \"gen_calls\": " << (unsigned long long)bufferCount * frames << ", \"delete_calls\": " << (unsigned long long)bufferCount * frames << " },\n"
+         << "  \"managed\": { \"frame_ms\": " << managed << ", \"ns_per_buffer\": " << managed * 1e6 / bufferCount
+         << ", \"gen_calls\": " << after.GenCalls - before.GenCalls << ", \"delete_calls\": " << after.DeleteCalls - before.DeleteCalls
+         << ", \"pending\": " << after.Pending << " },\n"
+         << "  \"speedup\": " << raw / managed << "\n}" << endl; 
+    return 0; 
+}
@@ -0,0 +1,221 @@
+#include "ResourceManager.h"
+#include "Renderer.h"
+#include "GLState.h"
+
+#include <deque>
+#include <vector>
+
+using namespace std; 
+
+static const unsigned int TypeCount = (unsigned int)ResourceType::Count; 
+//destroyed without an EndFrame in between, more likely a loop that never
+//calls it than one frame that really destroys this much
+static const unsigned int UnfencedWarning = 16384; 
+
+struct Slot
+{
+    unsigned int Name; 
+    unsigned short Generation; 
+    bool Alive; 
+}; 
+
+//what one frame destroyed
+struct Garbage
+{
+    void* Fence = nullptr; 
+    vector<unsigned int> Names[TypeCount]; 
+}; 
+
+static vector<Slot> s_Slots[TypeCount]; 
+static vector<unsigned int> s_FreeSlots[TypeCount]; 
+static vector<unsigned int> s_Pool[TypeCount]; 
+static Garbage s_Current; 
+static deque<Garbage> s_Pending; 
+//emptied batches, kept for their capacity
+static vector<Garbage> s_Spare; 
+static ResourceManager::Stats s_Stats; 
+static unsigned int s_Unfenced = 0; 
+
+static void GenNames(ResourceType type, unsigned int count, unsigned int* names)
+{
+    if (type == ResourceType::Buffer)
+        GLCall(glGenBuffers(count, names));
+    else
+        GLCall(glGenTextures(count, names));
+    s_Stats.GenCalls++; 
+}
+
+static void DeleteNames(ResourceType type, vector<unsigned int>& names)
+{
+    if (names.empty())
+        return; 
+    if (type == ResourceType::Buffer)
+        GLState::DeleteBuffers((unsigned int)names.size(), names.data()); 
+    else
+        GLState::DeleteTextures((unsigned int)names.size(), names.data()); 
+    s_Stats.DeleteCalls++; 
+    s_Stats.Pending -= (unsigned int)names.size(); 
+    names.clear(); 
+}
+
+static void Release(Garbage& garbage)
+{
+    for (unsigned int t = 0; t < TypeCount; t++)
+        DeleteNames((ResourceType)t, garbage.Names[t]); 
+    if (garbage.Fence)
+        GLCall(glDeleteSync((GLsync)garbage.Fence));
+    garbage.Fence = nullptr; 
+}
+
+static ResourceHandle Insert(ResourceType type, unsigned int name)
+{
+    vector<Slot>& slots = s_Slots[(unsigned int)type]; 
+    vector<unsigned int>& free = s_FreeSlots[(unsigned int)type]; 
+
+    ResourceHandle handle; 
+    handle.Type = type; 
+    if (free.empty())
+    {
+        handle.Index = (unsigned int)slots.size(); 
+        slots.push_back({ 0, 0, false }); 
+    }
+    else
+    {
+        handle.Index = free.back(); 
+        free.pop_back(); 
+    }
+    Slot& slot = slots[handle.Index]; 
+    //0 stays the invalid handle
+    if (++slot.Generation == 0)
+        slot.Generation = 1; 
+    slot.Name = name; 
+    slot.Alive = true; 
+    handle.Generation = slot.Generation; 
+    s_Stats.Live++; 
+    return handle; 
+}
+
+static Slot* Find(ResourceHandle handle)
+{
+    vector<Slot>& slots = s_Slots[(unsigned int)handle.Type]; 
+    if (handle.Index >= slots.size())
+        return nullptr; 
+    Slot& slot = slots[handle.Index]; 
+    if (!slot.Alive || slot.Generation != handle.Generation)
+        return nullptr; 
+    return &slot; 
+}
+
+ResourceHandle ResourceManager::Create(ResourceType type)
+{
+    vector<unsigned int>& pool = s_Pool[(unsigned int)type]; 
+    if (pool.empty())
+    {
+        pool.resize(PoolBatch); 
+        GenNames(type, PoolBatch, pool.data()); 
+        s_Stats.Pooled += PoolBatch; 
+    }
+    unsigned int name = pool.back(); 
+    pool.pop_back(); 
+    s_Stats.Pooled--; 
+    return Insert(type, name); 
+}
+
+ResourceHandle ResourceManager::Adopt(ResourceType type, unsigned int name)
+{
+    return Insert(type, name); 
+}
+
+void ResourceManager::Destroy(ResourceHandle handle)
+{
+    Slot* slot = Find(handle); 
+    if (!slot)
+        return; 
+    //the GPU may still read it, the name goes once this frame is done
+    s_Current.Names[(unsigned int)handle.Type].push_back(slot->Name); 
+    slot->Alive = false; 
+    slot->Name = 0; 
+    s_FreeSlots[(unsigned int)handle.Type].push_back(handle.Index); 
+    s_Stats.Live--; 
+    s_Stats.Pending++; 
+    if (++s_Unfenced == UnfencedWarning)
+        LOG_WARN("{} resources destroyed since the last ResourceManager::EndFrame, swap through Context::SwapBuffers or Context::SwapWindow", s_Unfenced); 
+}
+
+unsigned int ResourceManager::GetName(ResourceHandle handle)
+{
+    Slot* slot = Find(handle); 
+    return slot ? slot->Name : 0; 
+}
+
+void ResourceManager::EndFrame()
+{
+    s_Unfenced = 0; 
+    bool empty = true; 
+    for (unsigned int t = 0; t < TypeCount; t++)
+        empty &= s_Current.Names[t].empty(); 
+    if (!empty)
+    {
+        GLsync fence; 
+        GLCall(fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        s_Current.Fence = fence; 
+        s_Pending.push_back(Garbage()); 
+        swap(s_Pending.back(), s_Current); 
+        if (!s_Spare.empty())
+        {
+            swap(s_Current, s_Spare.back()); 
+            s_Spare.pop_back(); 
+        }
+    }
+
+    //fences pass in order, stop at the first the GPU has not reached
+    while (!s_Pending.empty())
+    {
+        GLenum result; 
+        GLCall(result = glClientWaitSync((GLsync)s_Pending.front().Fence, 0, 0));
+        if (result == GL_TIMEOUT_EXPIRED)
+            break; 
+        Release(s_Pending.front()); 
+        s_Spare.push_back(Garbage()); 
+        swap(s_Spare.back(), s_Pending.front()); 
+        s_Pending.pop_front(); 
+    }
+}
+
+void ResourceManager::Shutdown()
+{
+    //nothing waits for the GPU here, deleting a name it still uses is safe in GL
+    Release(s_Current); 
+    for (Garbage& garbage : s_Pending)
+        Release(garbage); 
+    s_Pending.clear(); 
+    s_Spare.clear(); 
+    s_Unfenced = 0; 
+
+    for (unsigned int t = 0; t < TypeCount; t++)
+    {
+        //the live ones too, their owners may outlive the context
+        vector<unsigned int> names; 
+        names.swap(s_Pool[t]); 
+        for (unsigned int i = 0; i < s_Slots[t].size(); i++)
+        {
+            Slot& slot = s_Slots[t][i]; 
+            if (!slot.Alive)
+                continue; 
+            names.push_back(slot.Name); 
+            //the generation stays, so the owners' handles go stale
+            slot.Alive = false; 
+            slot.Name = 0; 
+            s_FreeSlots[t].push_back(i); 
+        }
+        s_Stats.Pending += (unsigned int)names.size(); 
+        DeleteNames((ResourceType)t, names); 
+    }
+    s_Stats.Live = 0; 
+    s_Stats.Pooled = 0; 
+}
+
+ResourceManager::Stats ResourceManager::GetStats()
+{
+    return s_Stats; 
+}
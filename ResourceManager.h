@@ -0,0 +1,132 @@
+#pragma once
+
+enum class ResourceType : unsigned char
+{
+	Buffer, Texture, Count
+}; 
+
+//Refers to a slot of the ResourceManager. Once the resource is destroyed the
+//slot's generation moves on, so a stale handle resolves to nothing instead
+//of to whatever reuses the slot or the GL name.
+struct ResourceHandle
+{
+	unsigned int Index = 0; 
+	//0 is never handed out
+	unsigned short Generation = 0; 
+	ResourceType Type = ResourceType::Buffer; 
+
+	inline bool IsValid() const { return Generation != 0; }
+}; 
+
+//Hands out buffer and texture names from pools filled PoolBatch at a time,
+//and deletes them in batches once the GPU has finished the frame they were
+//destroyed in. Creating and destroying a resource makes no GL call of its
+//own, EndFrame makes a fence and at most one delete per type each frame.
+//
+//Main thread only, with the context current. Loader threads generate their
+//own names and hand them over with Adopt.
+class ResourceManager
+{
+public:
+	static const unsigned int PoolBatch = 256; 
+
+	struct Stats
+	{
+		unsigned int Live = 0; 
+		//destroyed, waiting for the GPU
+		unsigned int Pending = 0; 
+		unsigned int Pooled = 0; 
+		//driver calls made to create and delete names, since the start
+		unsigned int GenCalls = 0; 
+		unsigned int DeleteCalls = 0; 
+	}; 
+
+	static ResourceHandle Create(ResourceType type); 
+	//takes over a name generated elsewhere
+	static ResourceHandle Adopt(ResourceType type, unsigned int name); 
+	//stale and already destroyed handles are ignored
+	static void Destroy(ResourceHandle handle); 
+	//0 unless the handle is live
+	static unsigned int GetName(ResourceHandle handle); 
+
+	//fences what was destroyed this frame and deletes what earlier frames
+	//destroyed if the GPU is past them; Context::SwapBuffers and, for loops
+	//that open their window by hand, Context::SwapWindow call it
+	static void EndFrame(); 
+	//deletes everything right away, pooled names included; called by the
+	//Context before it goes, or by Context::Terminate, so later destructors
+	//find nothing left to delete
+	static void Shutdown(); 
+
+	static Stats GetStats(); 
+}; 
+
+//Owns one resource, moves but never copies, so a name is deleted exactly once.
+template<ResourceType Type>
+class GpuResource
+{
+private:
+	ResourceHandle m_Handle; 
+	//cached, looking it up on every bind would be wasted
+	unsigned int m_Name; 
+public:
+	GpuResource()
+	  : m_Name(0)
+	{
+	}
+	~GpuResource()
+	{
+		Reset(); 
+	}
+
+	GpuResource(const GpuResource&) = delete; 
+	GpuResource& operator=(const GpuResource&) = delete; 
+
+	GpuResource(GpuResource&& other) noexcept
+	  : m_Handle(other.m_Handle), m_Name(other.m_Name)
+	{
+		other.m_Handle = ResourceHandle(); 
+		other.m_Name = 0; 
+	}
+	GpuResource& operator=(GpuResource&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Reset(); 
+			m_Handle = other.m_Handle; 
+			m_Name = other.m_Name; 
+			other.m_Handle = ResourceHandle(); 
+			other.m_Name = 0; 
+		}
+		return *this; 
+	}
+
+	static GpuResource Create()
+	{
+		GpuResource resource; 
+		resource.m_Handle = ResourceManager::Create(Type); 
+		resource.m_Name = ResourceManager::GetName(resource.m_Handle); 
+		return resource; 
+	}
+	static GpuResource Adopt(unsigned int name)
+	{
+		GpuResource resource; 
+		resource.m_Handle = ResourceManager::Adopt(Type, name); 
+		resource.m_Name = name; 
+		return resource; 
+	}
+
+	void Reset()
+	{
+		if (m_Handle.IsValid())
+			ResourceManager::Destroy(m_Handle); 
+		m_Handle = ResourceHandle(); 
+		m_Name = 0; 
+	}
+
+	inline unsigned int Get() const { return m_Name; }
+	inline ResourceHandle GetHandle() const { return m_Handle; }
+}; 
+
+typedef GpuResource<ResourceType::Buffer> GpuBuffer; 
+typedef GpuResource<ResourceType::Texture> GpuTexture; 
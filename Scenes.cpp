@@ -0,0 +1,130 @@
+#include "Scenes.h"
+#include "Renderer.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "Shader.h"
+
+//one quad with an animated u_Color, like Shapes.cpp
+class ShapesScene : public Scene
+{ 
+private: 
+    VertexArray m_VertexArray; 
+    VertexBuffer m_VertexBuffer; 
+    IndexBuffer m_IndexBuffer; 
+    Shader m_Shader; 
+    Renderer m_Renderer; 
+    int m_Color; 
+    float m_R; 
+    float m_Increment; 
+
+    static const Float2 Positions[4]; 
+    static const unsigned int Indices[6]; 
+public: 
+    ShapesScene()
+      : m_VertexBuffer(Positions, sizeof(Positions)), m_IndexBuffer(Indices, 6),
+        m_Shader("res/shaders/Basic.shader"), m_R(0.0f), m_Increment(0.05f)
+    { 
+        m_VertexArray.AddBuffer<Float2>(m_VertexBuffer); 
+        m_VertexArray.SetIndexBuffer(m_IndexBuffer); 
+        m_Color = m_Shader.GetUniform("u_Color"); 
+    }
+
+    const char* GetName() const override { return "Shapes"; }
+
+    void Render() override
+    { 
+        m_Renderer.Clear(); 
+        m_Shader.SetUniform4f(m_Color, m_R, 0.3f, 0.8f, 1.0f); 
+        m_Renderer.Draw(m_VertexArray, m_IndexBuffer, m_Shader); 
+
+        if (m_R <= 0.0f)
+            m_Increment = 0.05f; 
+        else if (m_R >= 1.0f)
+            m_Increment = -0.05f; 
+        m_R += m_Increment; 
+    }
+}; 
+
+const Float2 ShapesScene::Positions[4] = { 
+    { -0.5f, -0.5f }, 
+    {  0.5f, -0.5f }, 
+    {  0.5f,  0.5f }, 
+    { -0.5f,  0.5f }, 
+}; 
+const unsigned int ShapesScene::Indices[6] = { 0, 1, 2, 2, 3, 0 }; 
+
+//a single glDrawArrays triangle, like RedTriangle.cpp and Test.cpp
+class TriangleScene : public Scene
+{ 
+private: 
+    const char* m_Name; 
+    VertexArray m_VertexArray; 
+    VertexBuffer m_VertexBuffer; 
+    Shader m_Shader; 
+
+    static const Float2 Positions[3]; 
+public: 
+    TriangleScene(const char* name, unsigned int program)
+      : m_Name(name), m_VertexBuffer(Positions, sizeof(Positions)), m_Shader(program)
+    { 
+        m_VertexArray.AddBuffer<Float2>(m_VertexBuffer); 
+        //only Basic.shader has it, it stays black in RedTriangle.cpp otherwise
+        m_Shader.SetUniform4f("u_Color", 1.0f, 0.0f, 0.0f, 1.0f); 
+    }
+
+    const char* GetName() const override { return m_Name; }
+
+    void Render() override
+    { 
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+        m_Shader.Bind(); 
+        m_VertexArray.Bind(); 
+        GLCall(glDrawArrays(GL_TRIANGLES, 0, 3));
+    }
+}; 
+
+const Float2 TriangleScene::Positions[3] = { 
+    { -0.5f, -0.5f }, 
+    {  0.0f,  0.5f }, 
+    {  0.5f, -0.5f }, 
+}; 
+
+static const char* TestVertexShader = 
+    "#version 330 core\n"
+    "\n"
+    "layout (location = 0) in vec2 position;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "  gl_Position = vec4(position.x, position.y, 0.0, 1.0);\n"
+    "}\n";
+
+static const char* TestFragmentShader = 
+    "#version 330 core\n"
+    "\n"
+    "layout(location = 0) out vec4 color;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "   color = vec4(1.0, 0.0, 0.0, 1.0);\n"
+    "}\n";
+
+Scene* CreateScene(const std::string& name)
+{
+    if (name == "Shapes")
+        return new ShapesScene(); 
+    if (name == "RedTriangle")
+    { 
+        ShaderProgramSource source = ParseShader("res/shaders/Basic.shader"); 
+        return new TriangleScene("RedTriangle", CreateShader(source.VertexSource, source.FragmentSource)); 
+    }
+    if (name == "Test")
+        return new TriangleScene("Test", CreateShader(TestVertexShader, TestFragmentShader)); 
+    return nullptr; 
+}
+
+std::vector<std::string> GetSceneNames()
+{
+    return { "Shapes", "RedTriangle", "Test" }; 
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+//The Shapes, RedTriangle and Test programs as reusable scenes, so they can
+//be driven by something other than their own main loop (e.g. Benchmark).
+class Scene
+{ 
+public: 
+	virtual ~Scene() {}
+	virtual const char* GetName() const = 0; 
+	virtual void Render() = 0; 
+}; 
+
+//needs a current context, returns null for an unknown name
+Scene* CreateScene(const std::string& name); 
+std::vector<std::string> GetSceneNames(); 
@@ -0,0 +1,292 @@
+#include "Shader.h"
+#include "Renderer.h"
+#include "GLState.h"
+
+#include <iostream>
+#include <fstream> 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+ShaderProgramSource ParseShader(const string& filepath)
+{ 
+    //whole file in one read, then sliced line by line without a stringstream
+    ifstream stream(filepath, ios::binary | ios::ate); 
+    string text; 
+    if (stream)
+    { 
+        text.resize((size_t)stream.tellg()); 
+        stream.seekg(0); 
+        stream.read(&text[0], text.size()); 
+    }
+
+    enum class ShaderType
+    { 
+        NONE = -1, VERTEX = 0, FRAGMENT = 1, COMPUTE = 2
+    };
+
+    string sources[3]; 
+    for (string& source : sources)
+        source.reserve(text.size()); 
+    ShaderType type = ShaderType::NONE; 
+    size_t begin = 0; 
+    while (begin < text.size())
+    { 
+        size_t end = text.find('\n', begin); 
+        if (end == string::npos)
+            end = text.size(); 
+        const char* line = text.c_str() + begin; 
+        size_t length = end - begin; 
+        auto contains = [line, length](const char* word) {
+            return search(line, line + length, word, word + strlen(word)) != line + length; 
+        };
+
+        if (contains("#shader"))
+        { 
+            if (contains("vertex"))
+               type = ShaderType::VERTEX; 
+            else if (contains("fragment"))
+                type = ShaderType::FRAGMENT; 
+            else if (contains("compute"))
+                type = ShaderType::COMPUTE; 
+        }
+        else if (type != ShaderType::NONE)
+        { 
+            sources[int(type)].append(line, length).push_back('\n'); 
+        }
+        begin = end + 1; 
+    }
+
+    return { move(sources[0]), move(sources[1]), move(sources[2]) };
+}
+
+unsigned int CompileShader(unsigned int type, const string& source)
+{ 
+    unsigned int id = glCreateShader(type);
+    //pointer to the begining of our data
+    const char* src = source.c_str(); 
+    glShaderSource(id, 1, &src, nullptr); 
+    glCompileShader(id); 
+
+    //Error Handling: Anything wrong with the shder?
+    int result; 
+    glGetShaderiv(id, GL_COMPILE_STATUS, &result); 
+
+    if (result == GL_FALSE)
+    { 
+        int length; 
+        glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
+        char* message = (char*)alloca(length * sizeof(char)); 
+        glGetShaderInfoLog(id, length, &length, message); 
+        LOG_ERROR("Failed to compile {} shader!\n{}", type == GL_VERTEX_SHADER ? "vertex" : type == GL_COMPUTE_SHADER ? "compute" : "fragment", message); 
+        glDeleteShader(id); 
+        return 0; 
+    }
+
+    return id; 
+}
+
+unsigned int CreateShader(const string& vertexShader, const string& fragmentShader, bool retrievable)
+{
+    unsigned int program = glCreateProgram(); 
+    unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexShader); 
+    unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
+
+    if (retrievable)
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE); 
+
+    glAttachShader(program, vs);  
+    glAttachShader(program, fs);
+    glLinkProgram(program); 
+    glValidateProgram(program); 
+
+    glDeleteShader(vs); 
+    glDeleteShader(fs); 
+
+    return program; 
+}
+
+unsigned int CreateComputeShader(const string& computeShader)
+{
+    unsigned int program = glCreateProgram(); 
+    unsigned int cs = CompileShader(GL_COMPUTE_SHADER, computeShader); 
+
+    glAttachShader(program, cs); 
+    glLinkProgram(program); 
+    glValidateProgram(program); 
+
+    glDeleteShader(cs); 
+
+    return program; 
+}
+
+Shader::Shader(const string& filepath)
+{
+    ShaderProgramSource source = ParseShader(filepath); 
+    if (!source.ComputeSource.empty())
+        m_RendererID = CreateComputeShader(source.ComputeSource); 
+    else
+        m_RendererID = CreateShader(source.VertexSource, source.FragmentSource); 
+    ReflectUniforms(); 
+}
+
+Shader::Shader(unsigned int program)
+  : m_RendererID(program)
+{
+    ReflectUniforms(); 
+}
+
+Shader::~Shader()
+{
+    GLState::DeleteProgram(m_RendererID); 
+}
+
+void Shader::ReflectUniforms()
+{
+    m_Uniforms.clear(); 
+    if (!m_RendererID)
+        return; 
+
+    int count = 0; 
+    int maxLength = 0; 
+    if (GLEW_ARB_program_interface_query)
+    { 
+        GLCall(glGetProgramInterfaceiv(m_RendererID, GL_UNIFORM, GL_ACTIVE_RESOURCES, &count)); 
+        GLCall(glGetProgramInterfaceiv(m_RendererID, GL_UNIFORM, GL_MAX_NAME_LENGTH, &maxLength)); 
+    }
+    else
+    { 
+        GLCall(glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORMS, &count)); 
+        GLCall(glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength)); 
+    }
+
+    vector<char> name(maxLength + 1); 
+    for (int i = 0; i < count; i++)
+    { 
+        Uniform uniform; 
+        int length = 0; 
+        int blockIndex = -1; 
+
+        if (GLEW_ARB_program_interface_query)
+        { 
+            const GLenum props[4] = { GL_TYPE, GL_ARRAY_SIZE, GL_LOCATION, GL_BLOCK_INDEX }; 
+            int values[4]; 
+            GLCall(glGetProgramResourceiv(m_RendererID, GL_UNIFORM, i, 4, props, 4, nullptr, values)); 
+            GLCall(glGetProgramResourceName(m_RendererID, GL_UNIFORM, i, (GLsizei)name.size(), &length, name.data())); 
+            uniform.Type = values[0]; 
+            uniform.Size = values[1]; 
+            uniform.Location = values[2]; 
+            blockIndex = values[3]; 
+        }
+        else
+        { 
+            GLenum type; 
+            GLuint index = i; 
+            GLCall(glGetActiveUniform(m_RendererID, index, (GLsizei)name.size(), &length, &uniform.Size, &type, name.data())); 
+            GLCall(glGetActiveUniformsiv(m_RendererID, 1, &index, GL_UNIFORM_BLOCK_INDEX, &blockIndex)); 
+            uniform.Type = type; 
+            uniform.Location = glGetUniformLocation(m_RendererID, name.data()); 
+        }
+
+        //members of uniform blocks are fed through a UniformBuffer instead
+        if (blockIndex != -1)
+            continue; 
+
+        uniform.Name.assign(name.data(), length); 
+        //arrays are reported as "name[0]", look them up by their plain name
+        size_t bracket = uniform.Name.find('['); 
+        if (bracket != string::npos)
+            uniform.Name.resize(bracket); 
+        uniform.HasValue = false; 
+        m_Uniforms.push_back(uniform); 
+    }
+
+    sort(m_Uniforms.begin(), m_Uniforms.end(), [](const Uniform& a, const Uniform& b) { return a.Name < b.Name; }); 
+}
+
+void Shader::Bind() const 
+{
+    GLState::UseProgram(m_RendererID); 
+}
+
+void Shader::Unbind() const 
+{
+    GLState::UseProgram(0); 
+}
+
+int Shader::GetUniform(const string& name) const
+{
+    auto it = lower_bound(m_Uniforms.begin(), m_Uniforms.end(), name,
+        [](const Uniform& uniform, const string& n) { return uniform.Name < n; }); 
+    if (it == m_Uniforms.end() || it->Name != name)
+        return -1; 
+    return int(it - m_Uniforms.begin()); 
+}
+
+bool Shader::Changed(int handle, const float* value, int count)
+{
+    Uniform& uniform = m_Uniforms[handle]; 
+    if (uniform.Size == 1 && uniform.HasValue && memcmp(uniform.Value, value, count * sizeof(float)) == 0)
+    { 
+        m_Stats.Elided++; 
+        return false; 
+    }
+    memcpy(uniform.Value, value, count * sizeof(float)); 
+    uniform.HasValue = true; 
+    m_Stats.Uploads++; 
+    return true; 
+}
+
+void Shader::SetUniform1i(int handle, int value)
+{
+    if (handle < 0)
+        return; 
+    //the shadow copy only compares bits, so an int fits in a float slot
+    float bits; 
+    memcpy(&bits, &value, sizeof(int)); 
+    if (Changed(handle, &bits, 1))
+        GLCall(glProgramUniform1i(m_RendererID, m_Uniforms[handle].Location, value)); 
+}
+
+void Shader::SetUniform1f(int handle, float value)
+{
+    if (handle < 0)
+        return; 
+    if (Changed(handle, &value, 1))
+        GLCall(glProgramUniform1f(m_RendererID, m_Uniforms[handle].Location, value)); 
+}
+
+void Shader::SetUniform2f(int handle, float v0, float v1)
+{
+    if (handle < 0)
+        return; 
+    float value[2] = { v0, v1 }; 
+    if (Changed(handle, value, 2))
+        GLCall(glProgramUniform2f(m_RendererID, m_Uniforms[handle].Location, v0, v1)); 
+}
+
+void Shader::SetUniform4f(int handle, float v0, float v1, float v2, float v3)
+{
+    if (handle < 0)
+        return; 
+    float value[4] = { v0, v1, v2, v3 }; 
+    if (Changed(handle, value, 4))
+        GLCall(glProgramUniform4f(m_RendererID, m_Uniforms[handle].Location, v0, v1, v2, v3)); 
+}
+
+void Shader::SetUniformMat4f(int handle, const float* matrix)
+{
+    if (handle < 0)
+        return; 
+    if (Changed(handle, matrix, 16))
+        GLCall(glProgramUniformMatrix4fv(m_RendererID, m_Uniforms[handle].Location, 1, GL_FALSE, matrix)); 
+}
+
+bool Shader::BindUniformBlock(const string& name, unsigned int binding)
+{
+    unsigned int index = glGetUniformBlockIndex(m_RendererID, name.c_str()); 
+    if (index == GL_INVALID_INDEX)
+        return false; 
+    GLCall(glUniformBlockBinding(m_RendererID, index, binding)); 
+    return true; 
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct ShaderProgramSource
+{ 
+	std::string VertexSource; 
+	std::string FragmentSource; 
+	//only set for compute programs, which have nothing else
+	std::string ComputeSource; 
+}; 
+
+//splits a .shader file into its "#shader vertex", "#shader fragment" and "#shader compute" parts
+ShaderProgramSource ParseShader(const std::string& filepath); 
+
+unsigned int CompileShader(unsigned int type, const std::string& source); 
+
+//compiles and links a program, retrievable asks the driver to keep the binary
+//around so glGetProgramBinary can save it
+unsigned int CreateShader(const std::string& vertexShader, const std::string& fragmentShader, bool retrievable = false); 
+//needs 4.3 or ARB_compute_shader
+unsigned int CreateComputeShader(const std::string& computeShader); 
+
+//Owns a linked program. All active uniforms are looked up once when the
+//Shader is created, and the last value sent to each one is kept on the CPU so
+//setting the same value again never reaches the driver. Uniforms are set with
+//glProgramUniform, so the program does not have to be bound.
+class Shader
+{ 
+public: 
+	struct Stats
+	{ 
+		unsigned int Uploads = 0; 
+		unsigned int Elided = 0; 
+	}; 
+private: 
+	struct Uniform
+	{ 
+		std::string Name; 
+		int Location; 
+		unsigned int Type; 
+		int Size; 
+		bool HasValue; 
+		//big enough for a mat4, arrays are not shadowed
+		float Value[16]; 
+	}; 
+
+	unsigned int m_RendererID; 
+	//sorted by name, handles are indices into it
+	std::vector<Uniform> m_Uniforms; 
+	Stats m_Stats; 
+
+	void ReflectUniforms(); 
+	//true when the value differs from the shadow copy, which is then updated
+	bool Changed(int handle, const float* value, int count); 
+public: 
+	Shader(const std::string& filepath); 
+	//takes ownership of an already linked program
+	explicit Shader(unsigned int program); 
+	~Shader(); 
+
+	Shader(const Shader&) = delete; 
+	Shader& operator=(const Shader&) = delete; 
+
+	void Bind() const; 
+	void Unbind() const; 
+
+	//-1 when the program has no such active uniform
+	int GetUniform(const std::string& name) const; 
+
+	void SetUniform1i(int handle, int value); 
+	void SetUniform1f(int handle, float value); 
+	void SetUniform2f(int handle, float v0, float v1); 
+	void SetUniform4f(int handle, float v0, float v1, float v2, float v3); 
+	void SetUniformMat4f(int handle, const float* matrix); 
+
+	void SetUniform1i(const std::string& name, int value) { SetUniform1i(GetUniform(name), value); }
+	void SetUniform1f(const std::string& name, float value) { SetUniform1f(GetUniform(name), value); }
+	void SetUniform2f(const std::string& name, float v0, float v1) { SetUniform2f(GetUniform(name), v0, v1); }
+	void SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3) { SetUniform4f(GetUniform(name), v0, v1, v2, v3); }
+	void SetUniformMat4f(const std::string& name, const float* matrix) { SetUniformMat4f(GetUniform(name), matrix); }
+
+	//points a uniform block at a UniformBuffer binding, false if there is no such block
+	bool BindUniformBlock(const std::string& name, unsigned int binding); 
+
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+	inline const Stats& GetStats() const { return m_Stats; }
+	inline void ResetStats() { m_Stats = Stats(); }
+}; 
@@ -0,0 +1,193 @@
+#include <GL/glew.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "Renderer.h"
+#include "Context.h"
+#include "GLState.h"
+#include "Shader.h"
+#include "ShaderCompiler.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+
+using namespace std; 
+
+//Builds the same number of programs twice and prints the times as JSON, e.g.
+//
+//  ./ShaderBench --programs 200 > shaders.json
+//
+//First one at a time with CreateShader, which waits for each, to find the
+//slowest single program. Then all at once through a ShaderCompiler while a
+//render loop keeps drawing, with Basic.shader standing in for every program
+//that is not ready yet. With KHR_parallel_shader_compile the batch should
+//take about as long as the slowest program, not as long as all of them.
+//
+//Every program is different and salted with the start time, so neither the
+//driver's shader cache nor the first run helps the second.
+
+static double Now()
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now().time_since_epoch()).count(); 
+}
+
+static const char* VertexSource =
+    "#version 330 core\n"
+    "layout (location = 0) in vec2 position;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = vec4(position.x, position.y, 0.0, 1.0);\n"
+    "}\n"; 
+
+//enough arithmetic that compiling is measurable, constants differ per variant
+static string FragmentSource(unsigned int variant, unsigned long long salt, unsigned int terms)
+{
+    string source =
+        "#version 330 core\n"
+        "layout(location = 0) out vec4 color;\n"
+        "uniform vec4 u_Color;\n"
+        "void main()\n"
+        "{\n"
+        "    vec4 c = u_Color;\n"; 
+    source += "    // variant " + to_string(variant) + " salt " + to_string(salt) + "\n"; 
+    unsigned int seed = variant * 2654435761u + (unsigned int)salt; 
+    for (unsigned int i = 0; i < terms; i++)
+    {
+        seed = seed * 1664525u + 1013904223u; 
+        float k = 0.5f + (seed >> 8) / 16777216.0f; 
+        source += "    c = sin(c * " + to_string(k) + " + vec4(" + to_string(i * 0.01f) + ", c.zwx));\n"; 
+    }
+    source += "    color = c;\n}\n"; 
+    return source; 
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int programCount = 200; 
+    unsigned int terms = 48; 
+    unsigned int drawsPerFrame = 64; 
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--programs") && i + 1 < argc)
+            programCount = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--terms") && i + 1 < argc)
+            terms = atoi(argv[++i]); 
+        else if (!strcmp(argv[i], "--draws") && i + 1 < argc)
+            drawsPerFrame = atoi(argv[++i]); 
+        else
+        {
+            cerr << "usage: ShaderBench [--programs n] [--terms n] [--draws n]" << endl; 
+            return -1; 
+        }
+    }
+    if (!programCount)
+    {
+        cerr << "needs at least one program" << endl; 
+        return -1; 
+    }
+
+    ContextOptions options; 
+    options.Title = "ShaderBench"; 
+    options.SwapInterval = 0; 
+    options.Headless = true; 
+    Context context(options); 
+    if (!context.IsValid())
+        return -1; 
+
+    {
+    unsigned long long salt = (unsigned long long)chrono::system_clock::now().time_since_epoch().count(); 
+
+    //one at a time, every link waits for the compiler
+    double slowestMs = 0.0; 
+    double serialStart = Now(); 
+    for (unsigned int i = 0; i < programCount; i++)
+    {
+        string fragment = FragmentSource(i, salt, terms); 
+        double start = Now(); 
+        unsigned int program = CreateShader(VertexSource, fragment); 
+        double ms = Now() - start; 
+        if (ms > slowestMs)
+            slowestMs = ms; 
+        GLState::DeleteProgram(program); 
+    }
+    double serialMs = Now() - serialStart; 
+
+    Shader fallback("res/shaders/Basic.shader"); 
+    fallback.SetUniform4f(fallback.GetUniform("u_Color"), 0.5f, 0.5f, 0.5f, 1.0f); 
+
+    float triangle[] = { -0.5f, -0.5f, 0.5f, -0.5f, 0.0f, 0.5f }; 
+    VertexArray va; 
+    VertexBuffer vb(triangle, sizeof(triangle)); 
+    va.AddBuffer<Float2>(vb); 
+    va.Bind(); 
+
+    //all at once, the render loop never waits for them
+    ShaderCompiler compiler; 
+    vector<unsigned int> handles; 
+    vector<bool> ready(programCount, false); 
+    double batchStart = Now(); 
+    for (unsigned int i = 0; i < programCount; i++)
+        handles.push_back(compiler.Submit(VertexSource, FragmentSource(programCount + i, salt, terms), "variant " + to_string(i))); 
+    double submitMs = Now() - batchStart; 
+
+    unsigned int pending = programCount; 
+    unsigned int frames = 0; 
+    unsigned long long fallbackDraws = 0; 
+    unsigned long long draws = 0; 
+    double longestFrameMs = 0.0; 
+    double batchMs = 0.0; 
+    while (pending)
+    {
+        double frameStart = Now(); 
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+        for (unsigned int d = 0; d < drawsPerFrame; d++)
+        {
+            //walks through the programs so every one of them is asked for
+            unsigned int i = (frames * drawsPerFrame + d) % programCount; 
+            unsigned int program = compiler.GetProgram(handles[i], fallback.GetRendererID()); 
+            if (program == fallback.GetRendererID())
+                fallbackDraws++; 
+            else if (!ready[i])
+            {
+                ready[i] = true; 
+                GLCall(glProgramUniform4f(program, glGetUniformLocation(program, "u_Color"), 0.2f, 0.3f, 0.8f, 1.0f));
+            }
+            GLState::UseProgram(program); 
+            GLCall(glDrawArrays(GL_TRIANGLES, 0, 3));
+            draws++; 
+        }
+        context.SwapBuffers(); 
+        frames++; 
+
+        pending = 0; 
+        for (unsigned int handle : handles)
+            pending += compiler.Poll(handle) == ShaderCompiler::Status::Pending; 
+        if (!pending)
+            batchMs = Now() - batchStart; 
+        double frameMs = Now() - frameStart; 
+        if (frameMs > longestFrameMs)
+            longestFrameMs = frameMs; 
+    }
+    GLCall(glFinish());
+
+    const ShaderCompiler::Stats& stats = compiler.GetStats(); 
+    cout.setf(ios::fixed); 
+    cout.precision(4); 
+    cout << "{\n  \"renderer\": \"" << glGetString(GL_RENDERER) << "\",\n"
+         << "  \"parallel\": " << (compiler.IsParallel() ? "true" : "false") << ",\n"
+         << "  \"programs\": " << programCount << ",\n"
+         << "  \"serial\": { \"total_ms\": " << serialMs << ", \"slowest_ms\": " << slowestMs << " },\n"
+         << "  \"batch\": { \"total_ms\": " << batchMs << ", \"submit_ms\": " << submitMs
+         << ", \"ready\": " << stats.Ready << ", \"failed\": " << stats.Failed << " },\n"
+         << "  \"batch_over_slowest\": " << batchMs / slowestMs << ",\n"
+         << "  \"batch_over_serial\": " << batchMs / serialMs << ",\n"
+         << "  \"render_loop\": { \"frames\": " << frames << ", \"draws\": " << draws
+         << ", \"fallback_draws\": " << fallbackDraws << ", \"longest_frame_ms\": " << longestFrameMs << " }\n"
+         << "}" << endl; 
+    }
+    return 0; 
+}
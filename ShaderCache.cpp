@@ -0,0 +1,175 @@
+#include "ShaderCache.h"
+#include "Shader.h"
+#include "Renderer.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+
+static const unsigned int CacheMagic = 0x53484243; //"SHBC"
+
+//64 bit FNV-1a
+static unsigned long long HashString(const string& s, unsigned long long hash = 14695981039346656037ull)
+{ 
+    for (unsigned char c : s)
+    { 
+        hash ^= c; 
+        hash *= 1099511628211ull; 
+    }
+    return hash; 
+}
+
+static string GLString(GLenum name)
+{ 
+    const GLubyte* s = glGetString(name); 
+    return s ? (const char*)s : ""; 
+}
+
+ShaderCache::ShaderCache(const string& directory)
+  : m_Directory(directory)
+{
+    m_DriverID = GLString(GL_VENDOR) + "|" + GLString(GL_RENDERER) + "|" + GLString(GL_VERSION); 
+
+    //some drivers (macOS among them) expose the entry points but no formats
+    int formats = 0; 
+    if (GLEW_ARB_get_program_binary)
+        GLCall(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats)); 
+    m_Supported = formats > 0; 
+
+    if (m_Supported)
+    { 
+        error_code ec; 
+        filesystem::create_directories(m_Directory, ec); 
+        if (ec)
+            m_Supported = false; 
+    }
+}
+
+string ShaderCache::EntryPath(unsigned long long key) const
+{
+    stringstream ss; 
+    ss << m_Directory << "/" << hex << key << ".bin"; 
+    return ss.str(); 
+}
+
+unsigned int ShaderCache::Load(const string& filepath)
+{
+    ShaderProgramSource source = ParseShader(filepath); 
+    return Load(source.VertexSource, source.FragmentSource); 
+}
+
+unsigned int ShaderCache::Load(const string& vertexSource, const string& fragmentSource)
+{
+    auto start = chrono::steady_clock::now(); 
+
+    unsigned int program = 0; 
+    string path; 
+    if (m_Supported)
+    { 
+        unsigned long long key = HashString(m_DriverID); 
+        key = HashString(vertexSource, key); 
+        //separator so moving text between the two stages changes the key
+        key = HashString("#fragment", key); 
+        key = HashString(fragmentSource, key); 
+        path = EntryPath(key); 
+        program = LoadBinary(path); 
+    }
+
+    if (program)
+    { 
+        m_Stats.Hits++; 
+    }
+    else
+    { 
+        m_Stats.Misses++; 
+        program = CreateShader(vertexSource, fragmentSource, m_Supported); 
+
+        int linked = 0; 
+        GLCall(glGetProgramiv(program, GL_LINK_STATUS, &linked)); 
+        if (!linked)
+        { 
+            char infoLog[512]; 
+            glGetProgramInfoLog(program, 512, NULL, infoLog); 
+            LOG_ERROR("ERROR::SHADER::LINK_FAILED\n{}", infoLog); 
+            GLCall(glDeleteProgram(program)); 
+            program = 0; 
+        }
+        else if (m_Supported)
+        { 
+            SaveBinary(path, program); 
+        }
+    }
+
+    m_Stats.LoadSeconds += chrono::duration<double>(chrono::steady_clock::now() - start).count(); 
+    return program; 
+}
+
+unsigned int ShaderCache::LoadBinary(const string& path)
+{
+    ifstream stream(path, ios::binary | ios::ate); 
+    if (!stream)
+        return 0; 
+    size_t fileSize = (size_t)stream.tellg(); 
+    stream.seekg(0); 
+
+    unsigned int header[3]; 
+    if (!stream.read((char*)header, sizeof(header)) || header[0] != CacheMagic)
+        return 0; 
+    //a truncated or corrupt file gets compiled from source, not a length it does not hold
+    if (!header[2] || header[2] > fileSize - sizeof(header))
+        return 0; 
+
+    GLenum format = header[1]; 
+    vector<char> binary(header[2]); 
+    if (!stream.read(binary.data(), binary.size()))
+        return 0; 
+
+    unsigned int program = glCreateProgram(); 
+    GLCall(glProgramBinary(program, format, binary.data(), (GLsizei)binary.size())); 
+
+    //the driver is free to reject a binary, e.g. after an update it did not change the version string for
+    int linked = 0; 
+    GLCall(glGetProgramiv(program, GL_LINK_STATUS, &linked)); 
+    if (!linked)
+    { 
+        m_Stats.Rejected++; 
+        GLCall(glDeleteProgram(program)); 
+        return 0; 
+    }
+    return program; 
+}
+
+void ShaderCache::SaveBinary(const string& path, unsigned int program)
+{
+    int length = 0; 
+    GLCall(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length)); 
+    if (length <= 0)
+        return; 
+
+    vector<char> binary(length); 
+    GLenum format = 0; 
+    GLCall(glGetProgramBinary(program, length, &length, &format, binary.data())); 
+
+    //write to a temporary and rename so a crash never leaves a torn entry behind
+    string temp = path + ".tmp"; 
+    { 
+        ofstream stream(temp, ios::binary | ios::trunc); 
+        unsigned int header[3] = { CacheMagic, format, (unsigned int)length }; 
+        stream.write((const char*)header, sizeof(header)); 
+        stream.write(binary.data(), length); 
+        if (!stream)
+            return; 
+    }
+    error_code ec; 
+    filesystem::rename(temp, path, ec); 
+}
+
+void ShaderCache::PrintStats() const
+{
+    cout << "Shader cache: " << m_Stats.Hits << " hits, " << m_Stats.Misses << " misses, "
+         << m_Stats.Rejected << " rejected, " << m_Stats.LoadSeconds * 1000.0 << " ms"
+         << (m_Supported ? "" : " (program binaries not supported)") << endl; 
+}
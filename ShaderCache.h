@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+
+//Keeps linked program binaries on disk so later launches skip compiling and
+//linking. Entries are keyed by a hash of the parsed shader source plus the
+//driver vendor, renderer and version, so a driver update or an edited shader
+//simply misses and falls back to compiling from source.
+class ShaderCache
+{ 
+public: 
+	struct Stats
+	{ 
+		unsigned int Hits = 0; 
+		unsigned int Misses = 0; 
+		//binaries found on disk that the driver refused to load
+		unsigned int Rejected = 0; 
+		double LoadSeconds = 0.0; 
+	}; 
+private: 
+	std::string m_Directory; 
+	std::string m_DriverID; 
+	bool m_Supported; 
+	Stats m_Stats; 
+
+	std::string EntryPath(unsigned long long key) const; 
+	unsigned int LoadBinary(const std::string& path); 
+	void SaveBinary(const std::string& path, unsigned int program); 
+public: 
+	//needs a current context
+	ShaderCache(const std::string& directory = "shadercache"); 
+
+	//returns a linked program for a .shader file, 0 if it failed to build
+	unsigned int Load(const std::string& filepath); 
+	unsigned int Load(const std::string& vertexSource, const std::string& fragmentSource); 
+
+	void PrintStats() const; 
+
+	inline bool IsSupported() const { return m_Supported; }
+	inline const Stats& GetStats() const { return m_Stats; }
+}; 
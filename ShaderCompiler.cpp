@@ -0,0 +1,154 @@
+#include "ShaderCompiler.h"
+#include "Shader.h"
+#include "Renderer.h"
+#include "GLState.h"
+
+#include <iostream>
+
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+ShaderCompiler::ShaderCompiler()
+{
+    m_Parallel = GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile; 
+
+    //let the driver pick how many threads it wants to use, the ARB entry
+    //point is the only one on drivers without the KHR extension
+    if (GLEW_KHR_parallel_shader_compile)
+        GLCall(glMaxShaderCompilerThreadsKHR(0xFFFFFFFF)); 
+    else if (GLEW_ARB_parallel_shader_compile)
+        GLCall(glMaxShaderCompilerThreadsARB(0xFFFFFFFF)); 
+}
+
+ShaderCompiler::~ShaderCompiler()
+{
+    for (Entry& entry : m_Entries)
+    { 
+        if (entry.State == Status::Pending)
+        { 
+            GLCall(glDeleteShader(entry.VertexShader)); 
+            GLCall(glDeleteShader(entry.FragmentShader)); 
+        }
+        if (entry.Program)
+            GLState::DeleteProgram(entry.Program); 
+    }
+}
+
+unsigned int ShaderCompiler::Submit(const string& filepath)
+{
+    ShaderProgramSource source = ParseShader(filepath); 
+    return Submit(source.VertexSource, source.FragmentSource, filepath); 
+}
+
+unsigned int ShaderCompiler::Submit(const string& vertexSource, const string& fragmentSource, const string& name)
+{
+    Entry entry; 
+    entry.Name = name; 
+    entry.State = Status::Pending; 
+
+    //no status queries here, every one of them would wait for the compiler
+    const char* vs = vertexSource.c_str(); 
+    entry.VertexShader = glCreateShader(GL_VERTEX_SHADER); 
+    GLCall(glShaderSource(entry.VertexShader, 1, &vs, nullptr)); 
+    GLCall(glCompileShader(entry.VertexShader)); 
+
+    const char* fs = fragmentSource.c_str(); 
+    entry.FragmentShader = glCreateShader(GL_FRAGMENT_SHADER); 
+    GLCall(glShaderSource(entry.FragmentShader, 1, &fs, nullptr)); 
+    GLCall(glCompileShader(entry.FragmentShader)); 
+
+    entry.Program = glCreateProgram(); 
+    GLCall(glAttachShader(entry.Program, entry.VertexShader)); 
+    GLCall(glAttachShader(entry.Program, entry.FragmentShader)); 
+    GLCall(glLinkProgram(entry.Program)); 
+
+    m_Entries.push_back(entry); 
+    m_Stats.Submitted++; 
+    return (unsigned int)m_Entries.size() - 1; 
+}
+
+void ShaderCompiler::Finalize(Entry& entry)
+{
+    int linked = 0; 
+    GLCall(glGetProgramiv(entry.Program, GL_LINK_STATUS, &linked)); 
+
+    if (!linked)
+    { 
+        //the link log is empty when a stage failed to compile, so print those too
+        unsigned int stages[2] = { entry.VertexShader, entry.FragmentShader }; 
+        for (unsigned int shader : stages)
+        { 
+            int compiled = 0; 
+            GLCall(glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled)); 
+            if (compiled)
+                continue; 
+
+            char infoLog[512]; 
+            glGetShaderInfoLog(shader, 512, NULL, infoLog); 
+            LOG_ERROR("Failed to compile {} shader {}\n{}", shader == entry.VertexShader ? "vertex" : "fragment", entry.Name, infoLog); 
+        }
+
+        char infoLog[512]; 
+        glGetProgramInfoLog(entry.Program, 512, NULL, infoLog); 
+        LOG_ERROR("ERROR::SHADER::LINK_FAILED {}\n{}", entry.Name, infoLog); 
+
+        GLCall(glDeleteProgram(entry.Program)); 
+        entry.Program = 0; 
+        entry.State = Status::Failed; 
+        m_Stats.Failed++; 
+    }
+    else
+    { 
+        entry.State = Status::Ready; 
+        m_Stats.Ready++; 
+    }
+
+    GLCall(glDeleteShader(entry.VertexShader)); 
+    GLCall(glDeleteShader(entry.FragmentShader)); 
+}
+
+ShaderCompiler::Status ShaderCompiler::Poll(unsigned int handle)
+{
+    Entry& entry = m_Entries[handle]; 
+    if (entry.State != Status::Pending)
+        return entry.State; 
+
+    if (m_Parallel)
+    { 
+        int done = 0; 
+        GLCall(glGetProgramiv(entry.Program, GL_COMPLETION_STATUS_KHR, &done)); 
+        if (!done)
+            return Status::Pending; 
+    }
+
+    Finalize(entry); 
+    return entry.State; 
+}
+
+unsigned int ShaderCompiler::GetProgram(unsigned int handle, unsigned int fallback)
+{
+    if (Poll(handle) != Status::Ready)
+        return fallback; 
+    return m_Entries[handle].Program; 
+}
+
+void ShaderCompiler::WaitAll()
+{
+    for (Entry& entry : m_Entries)
+    { 
+        if (entry.State == Status::Pending)
+            Finalize(entry); 
+    }
+}
+
+unsigned int ShaderCompiler::Release(unsigned int handle)
+{
+    Entry& entry = m_Entries[handle]; 
+    if (entry.State == Status::Pending)
+        Finalize(entry); 
+
+    unsigned int program = entry.Program; 
+    entry.Program = 0; 
+    return program; 
+}
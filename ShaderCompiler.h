@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+//Submits many programs at once and only asks the driver about them when they
+//are first needed. With KHR_parallel_shader_compile the driver compiles them
+//on its own threads and GL_COMPLETION_STATUS_KHR tells us without blocking
+//whether one is done, so the render loop can keep drawing with a fallback.
+//Without the extension the first query blocks, but only on that program.
+class ShaderCompiler
+{ 
+public: 
+	enum class Status { Pending, Ready, Failed }; 
+
+	struct Stats
+	{ 
+		unsigned int Submitted = 0; 
+		unsigned int Ready = 0; 
+		unsigned int Failed = 0; 
+	}; 
+private: 
+	struct Entry
+	{ 
+		unsigned int Program; 
+		unsigned int VertexShader; 
+		unsigned int FragmentShader; 
+		std::string Name; 
+		Status State; 
+	}; 
+
+	std::vector<Entry> m_Entries; 
+	bool m_Parallel; 
+	Stats m_Stats; 
+
+	void Finalize(Entry& entry); 
+public: 
+	//needs a current context
+	ShaderCompiler(); 
+	~ShaderCompiler(); 
+
+	//starts compiling and linking, returns a handle for the other calls
+	unsigned int Submit(const std::string& filepath); 
+	unsigned int Submit(const std::string& vertexSource, const std::string& fragmentSource, const std::string& name = ""); 
+
+	//never blocks when the driver compiles in parallel
+	Status Poll(unsigned int handle); 
+	//the linked program once it is ready, fallback until then or when it failed
+	unsigned int GetProgram(unsigned int handle, unsigned int fallback = 0); 
+	//blocks until every submitted program is done
+	void WaitAll(); 
+
+	//the compiler no longer owns the program, it is up to the caller to delete it
+	unsigned int Release(unsigned int handle); 
+
+	inline bool IsParallel() const { return m_Parallel; }
+	inline const Stats& GetStats() const { return m_Stats; }
+}; 
@@ -0,0 +1,127 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+#include "SpatialIndex.h"
+#include "Culling.h"
+
+using namespace std; 
+
+//Build, update and query times of the SpatialIndex as the object count
+//grows, next to brute force culling with the Culler, printed as JSON:
+//
+//  ./SpatialBench --max 4000000 > spatial.json
+//
+//Objects are small boxes on a square map whose side grows with the count,
+//so the density and with it the visible count per view stay the same.
+//Updates move 10% of the objects and refit; picks are point queries.
+
+static double Milliseconds(chrono::steady_clock::time_point start)
+{ 
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(); 
+}
+
+static float Random(float range)
+{ 
+    return rand() / (float)RAND_MAX * range; 
+}
+
+int main(int argc, char** argv)
+{
+    unsigned int maxObjects = 1000000; 
+    for (int i = 1; i < argc; i++)
+    { 
+        if (!strcmp(argv[i], "--max") && i + 1 < argc)
+            maxObjects = atoi(argv[++i]); 
+    }
+
+    const int queries = 1000; 
+    const int picks = 10000; 
+    cout << "{\n  \"results\": ["; 
+    bool first = true; 
+    for (unsigned int count = 10000; count <= maxObjects; count *= 10)
+    { 
+        srand(1); 
+        //one object per 4 square units
+        float world = sqrt((float)count * 4.0f); 
+        vector<float> x(count), y(count), size(count); 
+        SpatialIndex index; 
+        Culler culler; 
+        for (unsigned int i = 0; i < count; i++)
+        { 
+            x[i] = Random(world); 
+            y[i] = Random(world); 
+            size[i] = 0.5f + Random(1.5f); 
+            index.Insert(x[i], y[i], x[i] + size[i], y[i] + size[i]); 
+            culler.Add(x[i], y[i], x[i] + size[i], y[i] + size[i]); 
+        }
+
+        auto start = chrono::steady_clock::now(); 
+        index.Build(); 
+        double build = Milliseconds(start); 
+
+        //a 100 x 100 view, 2500 objects or so whatever the count
+        vector<ViewRect> views(queries); 
+        for (ViewRect& view : views)
+        { 
+            view.MinX = Random(world - 100.0f); 
+            view.MinY = Random(world - 100.0f); 
+            view.MaxX = view.MinX + 100.0f; 
+            view.MaxY = view.MinY + 100.0f; 
+        }
+
+        vector<unsigned int> result; 
+        unsigned long long found = 0; 
+        start = chrono::steady_clock::now(); 
+        for (const ViewRect& view : views)
+        { 
+            result.clear(); 
+            index.Query(view, result); 
+            found += result.size(); 
+        }
+        double query = Milliseconds(start) / queries; 
+
+        vector<unsigned int> visible(culler.GetPaddedCount()); 
+        unsigned long long bruteFound = 0; 
+        int bruteQueries = queries / 10; 
+        start = chrono::steady_clock::now(); 
+        for (int q = 0; q < bruteQueries; q++)
+            bruteFound += culler.Cull(views[q], visible.data()); 
+        double brute = Milliseconds(start) / bruteQueries; 
+
+        start = chrono::steady_clock::now(); 
+        unsigned long long hits = 0; 
+        for (int p = 0; p < picks; p++)
+        { 
+            result.clear(); 
+            index.Query(Random(world), Random(world), result); 
+            hits += result.size(); 
+        }
+        double pick = Milliseconds(start) * 1000.0 / picks; 
+
+        //a tenth of the objects move a little, as in a frame of a busy scene
+        for (unsigned int i = 0; i < count; i += 10)
+        { 
+            x[i] += Random(2.0f) - 1.0f; 
+            y[i] += Random(2.0f) - 1.0f; 
+        }
+        start = chrono::steady_clock::now(); 
+        for (unsigned int i = 0; i < count; i += 10)
+            index.Move(i, x[i], y[i], x[i] + size[i], y[i] + size[i]); 
+        index.Refit(); 
+        double update = Milliseconds(start); 
+
+        cout << (first ? "" : ",") << "\n    { \"objects\": " << count << ", \"nodes\": " << index.GetNodeCount() << ", "
+             << "\"build_ms\": " << build << ", \"update_ms\": " << update << ", "
+             << "\"query_ms\": " << query << ", \"brute_force_query_ms\": " << brute << ", "
+             << "\"visible_per_query\": " << found / queries << ", "
+             << "\"brute_force_visible_per_query\": " << bruteFound / bruteQueries << ", "
+             << "\"pick_us\": " << pick << ", \"hits_per_pick\": " << (double)hits / picks << " }"; 
+        first = false; 
+    }
+    cout << "\n  ]\n}" << endl; 
+    return 0;
+}
@@ -0,0 +1,270 @@
+#include "SpatialIndex.h"
+
+#include <algorithm>
+#include <cfloat>
+
+const unsigned int SpatialIndex::LeafSize; 
+const unsigned int SpatialIndex::Invalid; 
+
+//what removed objects and empty nodes are set to, it overlaps nothing
+static const float s_Empty[4] = { FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX }; 
+
+template<typename A, typename B>
+static inline void Grow(A& bounds, const B& box)
+{ 
+    bounds.MinX = std::min(bounds.MinX, box.MinX); 
+    bounds.MinY = std::min(bounds.MinY, box.MinY); 
+    bounds.MaxX = std::max(bounds.MaxX, box.MaxX); 
+    bounds.MaxY = std::max(bounds.MaxY, box.MaxY); 
+}
+
+template<typename A>
+static inline void SetEmpty(A& bounds)
+{ 
+    bounds.MinX = s_Empty[0]; 
+    bounds.MinY = s_Empty[1]; 
+    bounds.MaxX = s_Empty[2]; 
+    bounds.MaxY = s_Empty[3]; 
+}
+
+SpatialIndex::SpatialIndex()
+  : m_BuiltArea(0.0f), m_Area(0.0f), m_Dirty(false)
+{
+}
+
+unsigned int SpatialIndex::Insert(float minX, float minY, float maxX, float maxY)
+{
+    unsigned int object; 
+    if (m_FreeIndices.empty())
+    { 
+        object = (unsigned int)m_Slots.size(); 
+        m_Slots.push_back(Invalid); 
+        m_InTree.push_back(false); 
+    }
+    else
+    { 
+        object = m_FreeIndices.back(); 
+        m_FreeIndices.pop_back(); 
+    }
+
+    //stays out of the tree until the next Build
+    m_Slots[object] = (unsigned int)m_Pending.size(); 
+    m_InTree[object] = false; 
+    m_Pending.push_back(object); 
+    m_PendingBoxes.push_back({ minX, minY, maxX, maxY }); 
+    return object; 
+}
+
+void SpatialIndex::Remove(unsigned int object)
+{
+    unsigned int slot = m_Slots[object]; 
+    if (m_InTree[object])
+    { 
+        //the slot stays as a box nothing overlaps until the next Build
+        m_Objects[slot] = Invalid; 
+        SetEmpty(m_Boxes[slot]); 
+        m_Dirty = true; 
+    }
+    else
+    { 
+        unsigned int last = m_Pending.back(); 
+        m_Pending[slot] = last; 
+        m_PendingBoxes[slot] = m_PendingBoxes.back(); 
+        m_Slots[last] = slot; 
+        m_Pending.pop_back(); 
+        m_PendingBoxes.pop_back(); 
+    }
+    m_Slots[object] = Invalid; 
+    m_InTree[object] = false; 
+    m_FreeIndices.push_back(object); 
+}
+
+void SpatialIndex::Move(unsigned int object, float minX, float minY, float maxX, float maxY)
+{
+    Box box = { minX, minY, maxX, maxY }; 
+    if (m_InTree[object])
+    { 
+        m_Boxes[m_Slots[object]] = box; 
+        m_Dirty = true; 
+    }
+    else
+    { 
+        m_PendingBoxes[m_Slots[object]] = box; 
+    }
+}
+
+void SpatialIndex::Build()
+{
+    struct Item
+    { 
+        unsigned int Object; 
+        Box Bounds; 
+        float CenterX, CenterY; 
+    }; 
+
+    std::vector<Item> items; 
+    items.reserve(GetObjectCount()); 
+    auto add = [&](unsigned int object, const Box& box)
+    { 
+        items.push_back({ object, box, (box.MinX + box.MaxX) * 0.5f, (box.MinY + box.MaxY) * 0.5f }); 
+    }; 
+    for (unsigned int slot = 0; slot < m_Objects.size(); slot++)
+    { 
+        if (m_Objects[slot] != Invalid)
+            add(m_Objects[slot], m_Boxes[slot]); 
+    }
+    for (unsigned int i = 0; i < m_Pending.size(); i++)
+        add(m_Pending[i], m_PendingBoxes[i]); 
+    m_Pending.clear(); 
+    m_PendingBoxes.clear(); 
+
+    m_Nodes.clear(); 
+    m_Nodes.reserve(items.empty() ? 0 : 2 * (items.size() / LeafSize + 1)); 
+    if (!items.empty())
+        m_Nodes.push_back(Node()); 
+
+    //top down, splitting each range at the median centroid along its longer side
+    struct Range { unsigned int Node, Begin, End; }; 
+    std::vector<Range> ranges; 
+    if (!items.empty())
+        ranges.push_back({ 0, 0, (unsigned int)items.size() }); 
+    while (!ranges.empty())
+    { 
+        Range range = ranges.back(); 
+        ranges.pop_back(); 
+
+        Node node; 
+        SetEmpty(node); 
+        float minCX = FLT_MAX, minCY = FLT_MAX, maxCX = -FLT_MAX, maxCY = -FLT_MAX; 
+        for (unsigned int i = range.Begin; i < range.End; i++)
+        { 
+            Grow(node, items[i].Bounds); 
+            minCX = std::min(minCX, items[i].CenterX); 
+            maxCX = std::max(maxCX, items[i].CenterX); 
+            minCY = std::min(minCY, items[i].CenterY); 
+            maxCY = std::max(maxCY, items[i].CenterY); 
+        }
+
+        unsigned int count = range.End - range.Begin; 
+        bool splitX = maxCX - minCX >= maxCY - minCY; 
+        //everything at one spot can not be split any further
+        if (count <= LeafSize || (maxCX == minCX && maxCY == minCY))
+        { 
+            node.Start = range.Begin; 
+            node.Count = count; 
+            m_Nodes[range.Node] = node; 
+            continue; 
+        }
+
+        unsigned int middle = range.Begin + count / 2; 
+        std::nth_element(items.begin() + range.Begin, items.begin() + middle, items.begin() + range.End, 
+            [splitX](const Item& a, const Item& b) { return splitX ? a.CenterX < b.CenterX : a.CenterY < b.CenterY; }); 
+
+        node.Start = (unsigned int)m_Nodes.size(); 
+        node.Count = 0; 
+        m_Nodes[range.Node] = node; 
+        m_Nodes.push_back(Node()); 
+        m_Nodes.push_back(Node()); 
+        ranges.push_back({ node.Start, range.Begin, middle }); 
+        ranges.push_back({ node.Start + 1, middle, range.End }); 
+    }
+
+    m_Objects.resize(items.size()); 
+    m_Boxes.resize(items.size()); 
+    for (unsigned int slot = 0; slot < items.size(); slot++)
+    { 
+        m_Objects[slot] = items[slot].Object; 
+        m_Boxes[slot] = items[slot].Bounds; 
+        m_Slots[items[slot].Object] = slot; 
+        m_InTree[items[slot].Object] = true; 
+    }
+
+    m_Dirty = true; 
+    Refit(); 
+    m_BuiltArea = m_Area; 
+}
+
+void SpatialIndex::Refit()
+{
+    //children always come after their parent, so going backwards sees them first
+    m_Area = 0.0f; 
+    for (unsigned int i = (unsigned int)m_Nodes.size(); i-- > 0; )
+    { 
+        Node& node = m_Nodes[i]; 
+        SetEmpty(node); 
+        if (node.Count)
+        { 
+            for (unsigned int slot = node.Start; slot < node.Start + node.Count; slot++)
+                Grow(node, m_Boxes[slot]); 
+        }
+        else
+        { 
+            Grow(node, m_Nodes[node.Start]); 
+            Grow(node, m_Nodes[node.Start + 1]); 
+        }
+        if (node.MaxX >= node.MinX)
+            m_Area += (node.MaxX - node.MinX) * (node.MaxY - node.MinY); 
+    }
+    m_Dirty = false; 
+}
+
+bool SpatialIndex::NeedsRebuild() const
+{
+    unsigned int inTree = (unsigned int)m_Objects.size(); 
+    return m_Pending.size() > 32 + inTree / 16 || m_Area > 2.0f * m_BuiltArea; 
+}
+
+template<typename Overlaps>
+void SpatialIndex::Query(Overlaps overlaps, std::vector<unsigned int>& result) const
+{
+    if (!m_Nodes.empty())
+    { 
+        m_Stack.clear(); 
+        m_Stack.push_back(0); 
+        while (!m_Stack.empty())
+        { 
+            const Node& node = m_Nodes[m_Stack.back()]; 
+            m_Stack.pop_back(); 
+            m_Stats.NodesVisited++; 
+            if (!overlaps(node))
+                continue; 
+
+            if (node.Count)
+            { 
+                m_Stats.ObjectsTested += node.Count; 
+                for (unsigned int slot = node.Start; slot < node.Start + node.Count; slot++)
+                { 
+                    if (overlaps(m_Boxes[slot]))
+                        result.push_back(m_Objects[slot]); 
+                }
+            }
+            else
+            { 
+                m_Stack.push_back(node.Start + 1); 
+                m_Stack.push_back(node.Start); 
+            }
+        }
+    }
+
+    m_Stats.ObjectsTested += (unsigned int)m_Pending.size(); 
+    for (unsigned int i = 0; i < m_Pending.size(); i++)
+    { 
+        if (overlaps(m_PendingBoxes[i]))
+            result.push_back(m_Pending[i]); 
+    }
+}
+
+void SpatialIndex::Query(const ViewRect& rect, std::vector<unsigned int>& result)
+{
+    if (m_Dirty)
+        Refit(); 
+    Query([&rect](const auto& box)
+    { 
+        return box.MinX <= rect.MaxX && box.MaxX >= rect.MinX && box.MinY <= rect.MaxY && box.MaxY >= rect.MinY; 
+    }, result); 
+}
+
+void SpatialIndex::Query(float x, float y, std::vector<unsigned int>& result)
+{
+    Query(ViewRect { x, y, x, y }, result); 
+}
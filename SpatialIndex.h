@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+
+#include "Culling.h"
+
+//Bounding volume hierarchy over 2D boxes, for culling and picking scenes
+//too big to test object by object. Nodes live in one flat array, the two
+//children of a node next to each other and always after it, and the
+//objects' boxes are copied in leaf order, so a query walks memory mostly
+//forward instead of chasing pointers.
+//
+//Moving objects only refits the boxes, which keeps the tree valid but lets
+//it get looser as things move around; objects added after the build sit in
+//a short list that is tested one by one. NeedsRebuild() says when either
+//has gone far enough that Build() pays off again.
+class SpatialIndex
+{ 
+public: 
+	static const unsigned int LeafSize = 4; 
+	static const unsigned int Invalid = 0xffffffff; 
+
+	struct Stats
+	{ 
+		unsigned int NodesVisited = 0; 
+		unsigned int ObjectsTested = 0; 
+	}; 
+private: 
+	//a leaf when Count is non zero, otherwise its children are Start and Start + 1
+	struct Node
+	{ 
+		float MinX, MinY, MaxX, MaxY; 
+		unsigned int Start; 
+		unsigned int Count; 
+	}; 
+
+	struct Box
+	{ 
+		float MinX, MinY, MaxX, MaxY; 
+	}; 
+
+	std::vector<Node> m_Nodes; 
+	//per leaf slot, the object and its box
+	std::vector<unsigned int> m_Objects; 
+	std::vector<Box> m_Boxes; 
+	//per object, its leaf slot or where it is in m_Pending
+	std::vector<unsigned int> m_Slots; 
+	std::vector<bool> m_InTree; 
+	std::vector<unsigned int> m_Pending; 
+	std::vector<Box> m_PendingBoxes; 
+	//free object indices, objects keep theirs until removed
+	std::vector<unsigned int> m_FreeIndices; 
+
+	//summed node area, how loose the tree is
+	float m_BuiltArea; 
+	float m_Area; 
+	bool m_Dirty; 
+	mutable std::vector<unsigned int> m_Stack; 
+	mutable Stats m_Stats; 
+
+	template<typename Overlaps>
+	void Query(Overlaps overlaps, std::vector<unsigned int>& result) const; 
+public: 
+	SpatialIndex(); 
+
+	//returns the object's index, stable until it is removed
+	unsigned int Insert(float minX, float minY, float maxX, float maxY); 
+	void Remove(unsigned int object); 
+	void Move(unsigned int object, float minX, float minY, float maxX, float maxY); 
+
+	//builds the tree over every object from scratch
+	void Build(); 
+	//fits the node boxes around moved objects again, bottom up
+	void Refit(); 
+	//the tree is twice as loose as when it was built or there are many objects outside it
+	bool NeedsRebuild() const; 
+
+	//objects overlapping the rect, appended to result; refits first if needed
+	void Query(const ViewRect& rect, std::vector<unsigned int>& result); 
+	//objects containing the point, for picking
+	void Query(float x, float y, std::vector<unsigned int>& result); 
+
+	inline unsigned int GetNodeCount() const { return (unsigned int)m_Nodes.size(); }
+	inline unsigned int GetObjectCount() const { return (unsigned int)(m_Slots.size() - m_FreeIndices.size()); }
+	void ResetStats() { m_Stats = Stats(); }
+	inline const Stats& GetStats() const { return m_Stats; }
+}; 
@@ -0,0 +1,131 @@
+#include <GL/glew.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <chrono>
+
+#include "Renderer.h"
+#include "Context.h"
+#include "ShaderCache.h"
+#include "BatchRenderer.h"
+#include "TextureAtlas.h"
+#include "TextureUploader.h"
+#include "GLState.h"
+
+using namespace std; 
+
+//Packs a few thousand generated sprites of random sizes into one atlas,
+//streaming a handful per frame through the TextureUploader, and draws all of
+//them with the BatchRenderer. Since they share a texture the whole screen
+//is a single draw call.
+
+//a filled circle with a soft edge, so the padding is easy to check
+static void MakeSprite(int size, const float color[3], vector<unsigned char>& pixels)
+{ 
+    pixels.resize(size * size * 4); 
+    float radius = size * 0.5f; 
+    for (int y = 0; y < size; y++)
+    { 
+        for (int x = 0; x < size; x++)
+        { 
+            float dx = x + 0.5f - radius; 
+            float dy = y + 0.5f - radius; 
+            float alpha = radius - sqrt(dx * dx + dy * dy); 
+            alpha = alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha); 
+            unsigned char* p = &pixels[(y * size + x) * 4]; 
+            for (int c = 0; c < 3; c++)
+                p[c] = (unsigned char)(color[c] * 255.0f); 
+            p[3] = (unsigned char)(alpha * 255.0f); 
+        }
+    }
+}
+
+int main(void)
+{
+    ContextOptions options; 
+    options.Title = "Sprites"; 
+    options.SwapInterval = 0; 
+    Context context(options); 
+    if (!context.IsValid())
+        return -1; 
+    GLInitDebugOutput(); 
+
+    {
+    ShaderCache shaderCache; 
+    unsigned int shader = shaderCache.Load("res/shaders/Batch.shader");
+    BatchRenderer::SetupShader(shader); 
+    GLState::SetEnabled(GL_BLEND, true); 
+    GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); 
+
+    BatchRenderer batch; 
+    TextureAtlas atlas(2048, 2048); 
+    TextureUploader uploader; 
+
+    const int spriteCount = 4000; 
+    const int spritesPerFrame = 64; 
+    vector<AtlasRegion> regions; 
+    vector<unsigned char> pixels; 
+    srand(1); 
+
+    double lastReport = chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count(); 
+    unsigned int frames = 0; 
+    bool full = false; 
+    while (!context.ShouldClose())
+    { 
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+        //new sprites are streamed in a few at a time, the frame never waits on them
+        for (int i = 0; i < spritesPerFrame && !full && (int)regions.size() < spriteCount; i++)
+        { 
+            int size = 8 + rand() % 33; 
+            float color[3] = { rand() / (float)RAND_MAX, rand() / (float)RAND_MAX, rand() / (float)RAND_MAX }; 
+            MakeSprite(size, color, pixels); 
+
+            AtlasRegion region; 
+            if (atlas.Add(size, size, pixels.data(), region, &uploader))
+                regions.push_back(region); 
+            else
+                full = true; 
+        }
+        uploader.EndFrame(); 
+
+        batch.BeginFrame(); 
+        batch.Begin(); 
+        const int columns = 80; 
+        const float cell = 2.0f / columns; 
+        const float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f }; 
+        for (unsigned int i = 0; i < regions.size(); i++)
+        { 
+            float w = regions[i].Width / 40.0f * cell; 
+            float h = regions[i].Height / 40.0f * cell; 
+            batch.DrawQuad(-1.0f + (i % columns) * cell, 1.0f - (i / columns + 1) * cell, w, h,
+                           atlas.GetTexture().GetRendererID(), regions[i].UV, white); 
+        }
+        batch.End(); 
+        frames++; 
+
+        double now = chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count(); 
+        if (now - lastReport >= 1.0)
+        { 
+            const TextureUploader::Stats& uploads = uploader.GetStats(); 
+            cout << frames / (now - lastReport) << " fps, " << regions.size() << " sprites in "
+                 << batch.GetStats().DrawCalls << " draw calls, atlas " << atlas.GetOccupancy() * 100.0f << "% occupied ("
+                 << atlas.GetEfficiency() * 100.0f << "% of the packed area), "
+                 << uploads.Bytes / (1024.0 * 1024.0) << " MB uploaded at " << uploader.GetBandwidth() << " MB/s, "
+                 << uploads.FenceWaits << " fence waits" << endl; 
+            uploader.ResetStats(); 
+            lastReport = now; 
+            frames = 0; 
+        }
+
+        context.SwapBuffers(); 
+        context.PollEvents(); 
+    }
+
+    GLState::DeleteProgram(shader); 
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include "StreamBuffer.h"
+#include "Renderer.h"
+#include "GLState.h"
+
+#include <chrono>
+
+StreamBuffer::StreamBuffer(unsigned int target, unsigned int capacity)
+  : m_Target(target), m_Capacity(capacity), m_Mapped(nullptr),
+    m_Head(0), m_FrameStart(0), m_FrameWrapped(false)
+{
+    GLCall(glGenBuffers(1, &m_RendererID));
+    GLState::BindBuffer(m_Target, m_RendererID);
+
+    m_Persistent = GLEW_ARB_buffer_storage; 
+    if (m_Persistent)
+    { 
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT; 
+        GLCall(glBufferStorage(m_Target, m_Capacity, nullptr, flags));
+        GLCall(m_Mapped = (unsigned char*)glMapBufferRange(m_Target, 0, m_Capacity, flags));
+    }
+    else
+    { 
+        GLCall(glBufferData(m_Target, m_Capacity, nullptr, GL_STREAM_DRAW));
+    }
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    for (Fence& fence : m_Fences)
+        GLCall(glDeleteSync((GLsync)fence.Sync)); 
+
+    if (m_Mapped)
+    { 
+        GLState::BindBuffer(m_Target, m_RendererID);
+        GLCall(glUnmapBuffer(m_Target));
+    }
+    GLState::DeleteBuffer(m_RendererID); 
+}
+
+bool StreamBuffer::Overlaps(unsigned int start, unsigned int end, bool wrapped, unsigned int offset, unsigned int size) const
+{
+    //a wrapped range covers [start, capacity) and [0, end)
+    if (wrapped)
+        return offset < end || offset + size > start; 
+    return offset < end && offset + size > start; 
+}
+
+void StreamBuffer::WaitOldest()
+{
+    GLsync sync = (GLsync)m_Fences.front().Sync; 
+    m_Fences.pop_front(); 
+
+    GLenum result; 
+    GLCall(result = glClientWaitSync(sync, 0, 0));
+    if (result == GL_TIMEOUT_EXPIRED)
+    { 
+        //the GPU is behind, this is the time we lose to it
+        auto start = std::chrono::steady_clock::now(); 
+        do
+        { 
+            GLCall(result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000));
+        } while (result == GL_TIMEOUT_EXPIRED);
+        m_Stats.FenceWaits++; 
+        m_Stats.WaitSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); 
+    }
+    GLCall(glDeleteSync(sync));
+}
+
+void* StreamBuffer::Map(unsigned int size, unsigned int& offset, unsigned int alignment)
+{
+    ASSERT(size <= m_Capacity);
+
+    offset = (m_Head + alignment - 1) / alignment * alignment; 
+    bool wraps = offset + size > m_Capacity; 
+    if (wraps)
+        offset = 0; 
+
+    //this frame alone has filled the ring, fence it so we can wait for its own draws
+    bool frameEmpty = m_Head == m_FrameStart && !m_FrameWrapped; 
+    if (!frameEmpty && Overlaps(m_FrameStart, m_Head, m_FrameWrapped, offset, size))
+        EndFrame(); 
+    if (wraps)
+        m_FrameWrapped = true; 
+
+    //fences complete in order, so waiting on the oldest first never waits too long
+    while (!m_Fences.empty())
+    { 
+        bool overlaps = false; 
+        for (const Fence& fence : m_Fences)
+            overlaps = overlaps || Overlaps(fence.Start, fence.End, fence.Wrapped, offset, size); 
+        if (!overlaps)
+            break; 
+        WaitOldest(); 
+    }
+
+    m_Head = offset + size; 
+    m_Stats.BytesWritten += size; 
+
+    if (m_Persistent)
+        return m_Mapped + offset; 
+
+    //the fences already make sure nobody reads this range any more
+    GLState::BindBuffer(m_Target, m_RendererID);
+    void* pointer; 
+    GLCall(pointer = glMapBufferRange(m_Target, offset, size,
+        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT));
+    return pointer; 
+}
+
+void StreamBuffer::Unmap()
+{
+    if (m_Persistent)
+        return; 
+    GLState::BindBuffer(m_Target, m_RendererID);
+    GLCall(glUnmapBuffer(m_Target));
+}
+
+void StreamBuffer::EndFrame()
+{
+    if (m_Head == m_FrameStart && !m_FrameWrapped)
+        return; 
+
+    Fence fence; 
+    GLCall(fence.Sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    fence.Start = m_FrameStart; 
+    fence.End = m_Head; 
+    fence.Wrapped = m_FrameWrapped; 
+    m_Fences.push_back(fence); 
+
+    m_FrameStart = m_Head; 
+    m_FrameWrapped = false; 
+}
+
+void StreamBuffer::Bind() const
+{
+    GLState::BindBuffer(m_Target, m_RendererID);
+}
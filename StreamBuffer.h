@@ -0,0 +1,72 @@
+#pragma once
+
+#include <deque>
+
+//Ring buffer for data that changes every frame. Each frame's writes are
+//followed by a fence, and a range is only written again once the GPU has
+//passed the fence of the frame that last used it, so the CPU fills the next
+//frame while the GPU still reads the current one. Size it for the frames in
+//flight, e.g. three times the data of one frame.
+//
+//With ARB_buffer_storage (core in 4.4) the buffer is mapped once, persistent
+//and coherent. Otherwise each allocation is mapped with glMapBufferRange using
+//the unsynchronized and invalidate flags, the fences keep that safe, and
+//Unmap() has to be called before drawing.
+class StreamBuffer
+{ 
+public: 
+	struct Stats
+	{ 
+		unsigned int BytesWritten = 0; 
+		unsigned int FenceWaits = 0; 
+		double WaitSeconds = 0.0; 
+	}; 
+private: 
+	struct Fence
+	{ 
+		void* Sync; 
+		unsigned int Start; 
+		unsigned int End; 
+		bool Wrapped; 
+	}; 
+
+	unsigned int m_RendererID; 
+	unsigned int m_Target; 
+	unsigned int m_Capacity; 
+	bool m_Persistent; 
+	unsigned char* m_Mapped; 
+
+	unsigned int m_Head; 
+	//start of the range written since the last fence
+	unsigned int m_FrameStart; 
+	bool m_FrameWrapped; 
+	std::deque<Fence> m_Fences; 
+	Stats m_Stats; 
+
+	bool Overlaps(unsigned int start, unsigned int end, bool wrapped, unsigned int offset, unsigned int size) const; 
+	void WaitOldest(); 
+public: 
+	StreamBuffer(unsigned int target, unsigned int capacity); 
+	~StreamBuffer(); 
+
+	StreamBuffer(const StreamBuffer&) = delete; 
+	StreamBuffer& operator=(const StreamBuffer&) = delete; 
+
+	//returns where to write size bytes and their offset in the buffer, the
+	//offset is a multiple of alignment so it can be used as a base vertex
+	void* Map(unsigned int size, unsigned int& offset, unsigned int alignment = 4); 
+	void Unmap(); 
+
+	//fences everything written so far, call after the draws that read it
+	void EndFrame(); 
+
+	void Bind() const; 
+
+	//call once a frame to get per-frame numbers
+	void ResetStats() { m_Stats = Stats(); }
+
+	inline bool IsPersistent() const { return m_Persistent; }
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+	inline unsigned int GetCapacity() const { return m_Capacity; }
+	inline const Stats& GetStats() const { return m_Stats; }
+}; 
@@ -4,56 +4,10 @@
 #include <iostream>
 
 #include "GLError.h"
+#include "Shader.h"
+#include "Context.h"
 
 
-static unsigned int CompileShader(unsigned int type, const std::string& source)
-{ 
-    //std::cout << "Compiling Shader" << std::endl; 
-      
-    unsigned int id = glCreateShader(type);
-    //pointer to the begining of our data
-    const char* src = source.c_str(); 
-    glShaderSource(id, 1, &src, nullptr); 
-    glCompileShader(id); 
-
-    //Error Handling: Anything wrong with the shder?
-    int result; 
-    glGetShaderiv(id, GL_COMPILE_STATUS, &result); 
-
-    if (result == GL_FALSE)
-    { 
-        int length; 
-        glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
-        char* message = (char*)alloca(length * sizeof(char)); 
-        glGetShaderInfoLog(id, length, &length, message); 
-        std::cout << "Failed to compile shader!" << (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader!" << std::endl; 
-        std::cout << message << std::endl; 
-        glDeleteShader(id); 
-        return 0; 
-    }
-
-    return id; 
-}
-
-static unsigned int CreateShader(const std::string& vertexShader, const std::string& fragmentshader)
-{
-    //std::cout << "Creating Shader" << std::endl; 
-
-    unsigned int program = glCreateProgram(); 
-    unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexShader); 
-    unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragmentshader);
-
-    glAttachShader(program, vs);  
-    glAttachShader(program, fs);
-    glLinkProgram(program); 
-    glValidateProgram(program); 
-
-    glDeleteShader(vs); 
-    glDeleteShader(fs); 
-
-    return program; 
-}
-
 int main(void)
 {
     GLFWwindow* window;
@@ -188,12 +142,12 @@ int main(void)
         glDrawArrays(GL_TRIANGLES, 0, 3);
 
         /* Swap front and back buffers */
-        glfwSwapBuffers(window);
+        Context::SwapWindow(window); 
 
         /* Poll for and process events */
         glfwPollEvents();
     }
 
-    glfwTerminate();
+    Context::Terminate(); 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "Texture.h"
+#include "Renderer.h"
+#include "GLState.h"
+
+#include <vector>
+
+//edits go straight to the texture, no bind needed; a name is only a texture
+//once it has been bound, which the constructor does
+static inline bool HasDirectStateAccess()
+{
+    return GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access; 
+}
+
+Texture::Texture(int width, int height, unsigned int levels)
+  : m_Texture(GpuTexture::Create()), m_Width(width), m_Height(height)
+{
+    unsigned int maxLevels = MipLevelsFor(width, height); 
+    m_Levels = (levels == 0 || levels > maxLevels) ? maxLevels : levels; 
+
+    BindForEdit(); 
+    if (GLEW_VERSION_4_2 || GLEW_ARB_texture_storage)
+    { 
+        GLCall(glTexStorage2D(GL_TEXTURE_2D, m_Levels, GL_RGBA8, m_Width, m_Height));
+    }
+    else
+    { 
+        //same chain glTexStorage2D would make, MAX_LEVEL keeps the texture complete
+        for (unsigned int level = 0; level < m_Levels; level++)
+        { 
+            int w = m_Width >> level; 
+            int h = m_Height >> level; 
+            GLCall(glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, w > 0 ? w : 1, h > 0 ? h : 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+        }
+        GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_Levels - 1));
+    }
+
+    SetFilter(m_Levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR, GL_LINEAR); 
+    SetWrap(GL_CLAMP_TO_EDGE); 
+}
+
+unsigned int Texture::MipLevelsFor(int width, int height)
+{
+    unsigned int levels = 1; 
+    int size = width > height ? width : height; 
+    while (size > 1)
+    { 
+        size >>= 1; 
+        levels++; 
+    }
+    return levels; 
+}
+
+void Texture::SetData(const void* pixels)
+{
+    SetSubData(0, 0, m_Width, m_Height, pixels); 
+}
+
+void Texture::Clear(unsigned int level)
+{
+    if (GLEW_VERSION_4_4 || GLEW_ARB_clear_texture)
+    { 
+        //null data clears to zero, nothing crosses the bus
+        GLCall(glClearTexImage(m_Texture.Get(), level, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+        return; 
+    }
+    int width = m_Width >> level; 
+    int height = m_Height >> level; 
+    width = width > 0 ? width : 1; 
+    height = height > 0 ? height : 1; 
+    std::vector<unsigned char> zeros((size_t)width * height * 4, 0); 
+    SetSubData(0, 0, width, height, zeros.data(), level); 
+}
+
+void Texture::SetSubData(int x, int y, int width, int height, const void* pixels, unsigned int level)
+{
+    //with a pixel unpack buffer bound the pointer would be read as an offset into it
+    GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0); 
+    if (HasDirectStateAccess())
+    { 
+        GLCall(glTextureSubImage2D(m_Texture.Get(), level, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        return; 
+    }
+    BindForEdit(); 
+    GLCall(glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+}
+
+void Texture::GenerateMipmaps()
+{
+    if (m_Levels == 1)
+        return; 
+    if (HasDirectStateAccess())
+    { 
+        GLCall(glGenerateTextureMipmap(m_Texture.Get()));
+        return; 
+    }
+    BindForEdit(); 
+    GLCall(glGenerateMipmap(GL_TEXTURE_2D));
+}
+
+void Texture::SetFilter(unsigned int minFilter, unsigned int magFilter)
+{
+    if (HasDirectStateAccess())
+    { 
+        GLCall(glTextureParameteri(m_Texture.Get(), GL_TEXTURE_MIN_FILTER, minFilter));
+        GLCall(glTextureParameteri(m_Texture.Get(), GL_TEXTURE_MAG_FILTER, magFilter));
+        return; 
+    }
+    BindForEdit(); 
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
+}
+
+void Texture::SetWrap(unsigned int wrap)
+{
+    if (HasDirectStateAccess())
+    { 
+        GLCall(glTextureParameteri(m_Texture.Get(), GL_TEXTURE_WRAP_S, wrap));
+        GLCall(glTextureParameteri(m_Texture.Get(), GL_TEXTURE_WRAP_T, wrap));
+        return; 
+    }
+    BindForEdit(); 
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap));
+}
+
+void Texture::Bind(unsigned int slot) const
+{
+    GLState::BindTexture(slot, GL_TEXTURE_2D, m_Texture.Get()); 
+}
+
+void Texture::BindForEdit() const
+{
+    GLState::BindTextureForEdit(0, GL_TEXTURE_2D, m_Texture.Get()); 
+}
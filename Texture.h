@@ -0,0 +1,47 @@
+#pragma once
+
+#include "ResourceManager.h"
+
+//2D RGBA8 texture with immutable storage. The size and the number of mip
+//levels are fixed at creation with glTexStorage2D, so the driver never has
+//to check the texture for completeness again. On 4.1 without
+//ARB_texture_storage every level is allocated with glTexImage2D instead.
+class Texture
+{ 
+private: 
+	GpuTexture m_Texture; 
+	int m_Width; 
+	int m_Height; 
+	unsigned int m_Levels; 
+public: 
+	//levels 0 allocates the full mip chain
+	Texture(int width, int height, unsigned int levels = 1); 
+
+	Texture(const Texture&) = delete; 
+	Texture& operator=(const Texture&) = delete; 
+	Texture(Texture&&) = default; 
+	Texture& operator=(Texture&&) = default; 
+
+	static unsigned int MipLevelsFor(int width, int height); 
+
+	//synchronous upload from client memory, use a TextureUploader to stream
+	void SetData(const void* pixels); 
+	void SetSubData(int x, int y, int width, int height, const void* pixels, unsigned int level = 0); 
+	//every texel of the level to transparent black, with glClearTexImage on 4.4
+	//or ARB_clear_texture, otherwise by uploading zeros
+	void Clear(unsigned int level = 0); 
+	//rebuilds every level below the first from it
+	void GenerateMipmaps(); 
+
+	void SetFilter(unsigned int minFilter, unsigned int magFilter); 
+	void SetWrap(unsigned int wrap); 
+
+	void Bind(unsigned int slot = 0) const; 
+	//binds it on unit 0 and leaves unit 0 active, for glTex* calls on GL_TEXTURE_2D
+	void BindForEdit() const; 
+
+	inline unsigned int GetRendererID() const { return m_Texture.Get(); }
+	inline int GetWidth() const { return m_Width; }
+	inline int GetHeight() const { return m_Height; }
+	inline unsigned int GetLevels() const { return m_Levels; }
+}; 
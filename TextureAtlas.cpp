@@ -0,0 +1,149 @@
+#include "TextureAtlas.h"
+#include "TextureUploader.h"
+
+#include <cstddef>
+
+SkylinePacker::SkylinePacker(int width, int height)
+  : m_Width(width), m_Height(height)
+{
+    Clear(); 
+}
+
+void SkylinePacker::Clear()
+{
+    m_Skyline.clear(); 
+    m_Skyline.push_back({ 0, 0, m_Width }); 
+    m_UsedArea = 0; 
+}
+
+int SkylinePacker::Fit(unsigned int segment, int width, int height) const
+{
+    int x = m_Skyline[segment].X; 
+    if (x + width > m_Width)
+        return -1; 
+
+    //the rectangle rests on the highest segment it spans
+    int y = 0; 
+    int remaining = width; 
+    for (unsigned int i = segment; remaining > 0; i++)
+    { 
+        if (m_Skyline[i].Y > y)
+            y = m_Skyline[i].Y; 
+        if (y + height > m_Height)
+            return -1; 
+        remaining -= m_Skyline[i].Width; 
+    }
+    return y; 
+}
+
+bool SkylinePacker::Pack(int width, int height, int& x, int& y)
+{
+    int best = -1; 
+    int bestTop = m_Height + 1; 
+    int bestWidth = m_Width + 1; 
+    for (unsigned int i = 0; i < m_Skyline.size(); i++)
+    { 
+        int fit = Fit(i, width, height); 
+        if (fit < 0)
+            continue; 
+        //lowest top edge first, then the narrowest segment so wide gaps stay for wide images
+        int top = fit + height; 
+        if (top < bestTop || (top == bestTop && m_Skyline[i].Width < bestWidth))
+        { 
+            best = i; 
+            bestTop = top; 
+            bestWidth = m_Skyline[i].Width; 
+        }
+    }
+    if (best < 0)
+        return false; 
+
+    x = m_Skyline[best].X; 
+    y = bestTop - height; 
+    m_Skyline.insert(m_Skyline.begin() + best, { x, bestTop, width }); 
+
+    //cut away what the new segment covers of the ones after it
+    unsigned int i = best + 1; 
+    while (i < m_Skyline.size())
+    { 
+        Segment& segment = m_Skyline[i]; 
+        int covered = x + width - segment.X; 
+        if (covered <= 0)
+            break; 
+        if (covered < segment.Width)
+        { 
+            segment.X += covered; 
+            segment.Width -= covered; 
+            break; 
+        }
+        m_Skyline.erase(m_Skyline.begin() + i); 
+    }
+
+    //neighbours at the same height become one segment
+    for (i = 0; i + 1 < m_Skyline.size(); )
+    { 
+        if (m_Skyline[i].Y == m_Skyline[i + 1].Y)
+        { 
+            m_Skyline[i].Width += m_Skyline[i + 1].Width; 
+            m_Skyline.erase(m_Skyline.begin() + i + 1); 
+        }
+        else
+        { 
+            i++; 
+        }
+    }
+
+    m_UsedArea += (unsigned long long)width * height; 
+    return true; 
+}
+
+float SkylinePacker::GetOccupancy() const
+{
+    return (float)((double)m_UsedArea / ((double)m_Width * m_Height)); 
+}
+
+float SkylinePacker::GetEfficiency() const
+{
+    unsigned long long covered = 0; 
+    for (const Segment& segment : m_Skyline)
+        covered += (unsigned long long)segment.Width * segment.Y; 
+    return covered ? (float)((double)m_UsedArea / covered) : 1.0f; 
+}
+
+TextureAtlas::TextureAtlas(int width, int height, int padding)
+  : m_Texture(width, height), m_Packer(width, height), m_Padding(padding), m_RegionCount(0)
+{
+    Clear(); 
+}
+
+bool TextureAtlas::Add(int width, int height, const void* pixels, AtlasRegion& region, TextureUploader* uploader)
+{
+    int x, y; 
+    if (!m_Packer.Pack(width + 2 * m_Padding, height + 2 * m_Padding, x, y))
+        return false; 
+
+    region.X = x + m_Padding; 
+    region.Y = y + m_Padding; 
+    region.Width = width; 
+    region.Height = height; 
+    region.UV[0] = (float)region.X / m_Texture.GetWidth(); 
+    region.UV[1] = (float)region.Y / m_Texture.GetHeight(); 
+    region.UV[2] = (float)(region.X + width) / m_Texture.GetWidth(); 
+    region.UV[3] = (float)(region.Y + height) / m_Texture.GetHeight(); 
+
+    if (uploader)
+        uploader->Upload(m_Texture, region.X, region.Y, width, height, pixels); 
+    else
+        m_Texture.SetSubData(region.X, region.Y, width, height, pixels); 
+    m_RegionCount++; 
+    return true; 
+}
+
+void TextureAtlas::Clear()
+{
+    m_Packer.Clear(); 
+    m_RegionCount = 0; 
+
+    //immutable storage starts out undefined, and the padding has to be transparent
+    m_Texture.Clear(); 
+}
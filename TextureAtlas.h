@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+
+#include "Texture.h"
+
+class TextureUploader; 
+
+//Skyline bottom-left rectangle packer. The packed area is described by its
+//top edge, a list of horizontal segments, and each rectangle goes where it
+//ends up lowest, so the free space stays in one piece above the skyline.
+//Space that ends up below the skyline is never used again.
+class SkylinePacker
+{ 
+private: 
+	struct Segment
+	{ 
+		int X; 
+		int Y; 
+		int Width; 
+	}; 
+
+	int m_Width; 
+	int m_Height; 
+	std::vector<Segment> m_Skyline; 
+	unsigned long long m_UsedArea; 
+
+	//lowest y a width wide rectangle fits at with its left edge on segment, -1 if it does not
+	int Fit(unsigned int segment, int width, int height) const; 
+public: 
+	SkylinePacker(int width, int height); 
+
+	//false when there is no room left
+	bool Pack(int width, int height, int& x, int& y); 
+	void Clear(); 
+
+	//packed area over the whole area
+	float GetOccupancy() const; 
+	//packed area over the area below the skyline, what is lost to gaps
+	float GetEfficiency() const; 
+}; 
+
+//where an image ended up in the atlas, UV is u0, v0, u1, v1
+struct AtlasRegion
+{ 
+	int X, Y; 
+	int Width, Height; 
+	float UV[4]; 
+}; 
+
+//One texture many small images are packed into at runtime, so sprites drawn
+//from it all share a texture slot and end up in the same batch. Images are
+//padded by a transparent border so linear filtering does not bleed in their
+//neighbours.
+class TextureAtlas
+{ 
+private: 
+	Texture m_Texture; 
+	SkylinePacker m_Packer; 
+	int m_Padding; 
+	unsigned int m_RegionCount; 
+public: 
+	TextureAtlas(int width, int height, int padding = 1); 
+
+	//packs a width x height RGBA8 image and uploads it, through the uploader
+	//when there is one; false when the atlas is full
+	bool Add(int width, int height, const void* pixels, AtlasRegion& region, TextureUploader* uploader = nullptr); 
+	//forgets every region and clears the texture
+	void Clear(); 
+
+	inline const Texture& GetTexture() const { return m_Texture; }
+	inline unsigned int GetRegionCount() const { return m_RegionCount; }
+	inline float GetOccupancy() const { return m_Packer.GetOccupancy(); }
+	inline float GetEfficiency() const { return m_Packer.GetEfficiency(); }
+}; 
@@ -0,0 +1,61 @@
+#include "TextureUploader.h"
+#include "Texture.h"
+#include "StreamBuffer.h"
+#include "Renderer.h"
+#include "GLState.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+TextureUploader::TextureUploader(unsigned int capacity)
+{
+    m_Buffer = new StreamBuffer(GL_PIXEL_UNPACK_BUFFER, capacity); 
+    //left bound, every client memory glTex*Image call would read from it
+    GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0); 
+}
+
+TextureUploader::~TextureUploader()
+{
+    delete m_Buffer; 
+}
+
+void TextureUploader::Upload(Texture& texture, int x, int y, int width, int height, const void* pixels, unsigned int level)
+{
+    auto start = std::chrono::steady_clock::now(); 
+    unsigned int waitsBefore = m_Buffer->GetStats().FenceWaits; 
+    double waitBefore = m_Buffer->GetStats().WaitSeconds; 
+
+    unsigned int rowSize = width * 4; 
+    unsigned int rowsPerChunk = m_Buffer->GetCapacity() / 2 / rowSize; 
+    ASSERT(rowsPerChunk > 0);
+
+    texture.BindForEdit(); 
+    const unsigned char* source = (const unsigned char*)pixels; 
+    for (int row = 0; row < height; row += rowsPerChunk)
+    { 
+        int rows = height - row < (int)rowsPerChunk ? height - row : rowsPerChunk; 
+        unsigned int size = rows * rowSize; 
+
+        //RGBA8 rows are always 4 byte aligned, which is what GL_UNPACK_ALIGNMENT expects
+        unsigned int offset; 
+        void* destination = m_Buffer->Map(size, offset, 4); 
+        memcpy(destination, source + (size_t)row * rowSize, size); 
+        m_Buffer->Unmap(); 
+
+        m_Buffer->Bind(); 
+        GLCall(glTexSubImage2D(GL_TEXTURE_2D, level, x, y + row, width, rows, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)(uintptr_t)offset));
+    }
+    GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0); 
+
+    m_Stats.Uploads++; 
+    m_Stats.Bytes += (unsigned long long)rowSize * height; 
+    m_Stats.Seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); 
+    m_Stats.FenceWaits += m_Buffer->GetStats().FenceWaits - waitsBefore; 
+    m_Stats.WaitSeconds += m_Buffer->GetStats().WaitSeconds - waitBefore; 
+}
+
+void TextureUploader::EndFrame()
+{
+    m_Buffer->EndFrame(); 
+}
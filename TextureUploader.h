@@ -0,0 +1,43 @@
+#pragma once
+
+class Texture; 
+class StreamBuffer; 
+
+//Streams pixels into textures through a StreamBuffer of pixel unpack memory.
+//Upload() copies the pixels into the ring and issues glTexSubImage2D from
+//there, which returns at once; the driver does the transfer to the texture
+//later, while the CPU goes on. The ring's fences keep the CPU from writing
+//over pixels the transfer has not read yet.
+class TextureUploader
+{ 
+public: 
+	struct Stats
+	{ 
+		unsigned int Uploads = 0; 
+		unsigned long long Bytes = 0; 
+		//time spent in Upload, copying into the ring and issuing the transfer
+		double Seconds = 0.0; 
+		unsigned int FenceWaits = 0; 
+		double WaitSeconds = 0.0; 
+	}; 
+private: 
+	StreamBuffer* m_Buffer; 
+	Stats m_Stats; 
+public: 
+	//capacity is the pixel memory in flight, uploads larger than half of it are split by rows
+	TextureUploader(unsigned int capacity = 16 * 1024 * 1024); 
+	~TextureUploader(); 
+
+	TextureUploader(const TextureUploader&) = delete; 
+	TextureUploader& operator=(const TextureUploader&) = delete; 
+
+	void Upload(Texture& texture, int x, int y, int width, int height, const void* pixels, unsigned int level = 0); 
+
+	//fences this frame's uploads, call once a frame
+	void EndFrame(); 
+
+	void ResetStats() { m_Stats = Stats(); }
+	const Stats& GetStats() const { return m_Stats; }
+	//MB/s the CPU side has pushed so far
+	double GetBandwidth() const { return m_Stats.Seconds > 0.0 ? m_Stats.Bytes / m_Stats.Seconds / (1024.0 * 1024.0) : 0.0; }
+}; 
@@ -0,0 +1,25 @@
+#include "UniformBuffer.h"
+#include "Renderer.h"
+#include "GLState.h"
+
+UniformBuffer::UniformBuffer(unsigned int size, unsigned int binding)
+  : m_Size(size), m_Binding(binding)
+{
+    GLCall(glGenBuffers(1, &m_RendererID));
+    GLState::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+    GLCall(glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+    //stays attached to the binding point, programs pick it up via Shader::BindUniformBlock
+    GLState::BindBufferBase(GL_UNIFORM_BUFFER, binding, m_RendererID);
+}
+
+UniformBuffer::~UniformBuffer()
+{
+    GLState::DeleteBuffer(m_RendererID); 
+}
+
+void UniformBuffer::SetData(const void* data, unsigned int size, unsigned int offset)
+{
+    ASSERT(offset + size <= m_Size);
+    GLState::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+    GLCall(glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data));
+}
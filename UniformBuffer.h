@@ -0,0 +1,25 @@
+#pragma once
+
+//A uniform buffer attached to a fixed binding point. Data shared by many
+//programs (camera, time, ...) is uploaded once per frame here instead of once
+//per program with glUniform. The CPU side struct has to follow std140 rules:
+//vec3/vec4 and mat4 columns start on 16 byte boundaries and array elements
+//are padded to 16 bytes.
+class UniformBuffer
+{ 
+private: 
+	unsigned int m_RendererID; 
+	unsigned int m_Size; 
+	unsigned int m_Binding; 
+public: 
+	UniformBuffer(unsigned int size, unsigned int binding); 
+	~UniformBuffer(); 
+
+	UniformBuffer(const UniformBuffer&) = delete; 
+	UniformBuffer& operator=(const UniformBuffer&) = delete; 
+
+	void SetData(const void* data, unsigned int size, unsigned int offset = 0); 
+
+	inline unsigned int GetBinding() const { return m_Binding; }
+	inline unsigned int GetSize() const { return m_Size; }
+}; 
@@ -0,0 +1,117 @@
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "StreamBuffer.h"
+#include "IndexBuffer.h"
+#include "Renderer.h"
+#include "GLState.h"
+
+VertexArray::VertexArray()
+  : m_NextAttrib(0), m_IndexType(GL_UNSIGNED_INT)
+{
+    GLCall(glGenVertexArrays(1, &m_RendererID));
+    m_SeparateFormat = GLEW_ARB_vertex_attrib_binding; 
+}
+
+VertexArray::~VertexArray()
+{
+    GLState::DeleteVertexArray(m_RendererID); 
+}
+
+void VertexArray::SpecifyPointers(const Binding& binding, unsigned int buffer, unsigned int bufferOffset) const
+{
+    GLState::BindBuffer(GL_ARRAY_BUFFER, buffer); 
+
+    const std::vector<VertexBufferElement>& elements = binding.Layout.GetElements(); 
+    for (unsigned int i = 0; i < elements.size(); i++)
+    { 
+        const VertexBufferElement& element = elements[i]; 
+        unsigned int location = binding.FirstAttrib + i; 
+        const void* offset = (const void*)(size_t)(bufferOffset + element.Offset); 
+
+        if (element.Integer)
+            GLCall(glVertexAttribIPointer(location, element.Count, element.Type, binding.Layout.GetStride(), offset)); 
+        else
+            GLCall(glVertexAttribPointer(location, element.Count, element.Type, element.Normalized ? GL_TRUE : GL_FALSE,
+                binding.Layout.GetStride(), offset)); 
+    }
+}
+
+unsigned int VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout, unsigned int divisor)
+{
+    return AddBinding(vb.GetRendererID(), layout, divisor); 
+}
+
+unsigned int VertexArray::AddBuffer(const StreamBuffer& sb, const VertexBufferLayout& layout, unsigned int divisor)
+{
+    return AddBinding(sb.GetRendererID(), layout, divisor); 
+}
+
+unsigned int VertexArray::AddBinding(unsigned int buffer, const VertexBufferLayout& layout, unsigned int divisor)
+{
+    Bind(); 
+
+    Binding binding; 
+    binding.Layout = layout; 
+    binding.FirstAttrib = m_NextAttrib; 
+    binding.Divisor = divisor; 
+    unsigned int index = (unsigned int)m_Bindings.size(); 
+
+    const std::vector<VertexBufferElement>& elements = layout.GetElements(); 
+    for (unsigned int i = 0; i < elements.size(); i++)
+    { 
+        const VertexBufferElement& element = elements[i]; 
+        unsigned int location = binding.FirstAttrib + i; 
+        GLCall(glEnableVertexAttribArray(location)); 
+
+        if (!m_SeparateFormat)
+        { 
+            GLCall(glVertexAttribDivisor(location, divisor)); 
+            continue; 
+        }
+
+        //the format is stored in the VAO once, independent of any buffer
+        if (element.Integer)
+            GLCall(glVertexAttribIFormat(location, element.Count, element.Type, element.Offset)); 
+        else
+            GLCall(glVertexAttribFormat(location, element.Count, element.Type, element.Normalized ? GL_TRUE : GL_FALSE, element.Offset)); 
+        GLCall(glVertexAttribBinding(location, index)); 
+    }
+    if (m_SeparateFormat)
+        GLCall(glVertexBindingDivisor(index, divisor)); 
+
+    m_NextAttrib += (unsigned int)elements.size(); 
+    m_Bindings.push_back(binding); 
+    SetBinding(index, buffer); 
+    return index; 
+}
+
+void VertexArray::SetBuffer(unsigned int binding, const VertexBuffer& vb, unsigned int offset)
+{
+    SetBinding(binding, vb.GetRendererID(), offset); 
+}
+
+void VertexArray::SetBinding(unsigned int binding, unsigned int buffer, unsigned int offset)
+{
+    Bind(); 
+    if (m_SeparateFormat)
+        GLCall(glBindVertexBuffer(binding, buffer, offset, m_Bindings[binding].Layout.GetStride())); 
+    else
+        SpecifyPointers(m_Bindings[binding], buffer, offset); 
+}
+
+void VertexArray::SetIndexBuffer(const IndexBuffer& ib)
+{
+    Bind(); 
+    ib.Bind(); 
+    m_IndexType = ib.GetType(); 
+}
+
+void VertexArray::Bind() const 
+{
+    GLState::BindVertexArray(m_RendererID); 
+}
+
+void VertexArray::Unbind() const 
+{
+    GLState::BindVertexArray(0); 
+}
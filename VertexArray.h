@@ -0,0 +1,65 @@
+#pragma once
+
+#include "VertexBufferLayout.h"
+
+class VertexBuffer; 
+class StreamBuffer; 
+class IndexBuffer; 
+
+//Owns a VAO. When ARB_vertex_attrib_binding is there (core in 4.3) the layout
+//is described once with glVertexAttribFormat and buffers are swapped with a
+//single glBindVertexBuffer, otherwise every buffer change re-specifies the
+//attribute pointers.
+class VertexArray
+{ 
+private: 
+	struct Binding
+	{ 
+		VertexBufferLayout Layout; 
+		unsigned int FirstAttrib; 
+		unsigned int Divisor; 
+	}; 
+
+	unsigned int m_RendererID; 
+	unsigned int m_NextAttrib; 
+	std::vector<Binding> m_Bindings; 
+	bool m_SeparateFormat; 
+	//of the index buffer last set, for draws that only have the vertex array
+	unsigned int m_IndexType; 
+
+	void SpecifyPointers(const Binding& binding, unsigned int buffer, unsigned int offset) const; 
+	unsigned int AddBinding(unsigned int buffer, const VertexBufferLayout& layout, unsigned int divisor); 
+	void SetBinding(unsigned int binding, unsigned int buffer, unsigned int offset = 0); 
+public: 
+	VertexArray(); 
+	~VertexArray(); 
+
+	VertexArray(const VertexArray&) = delete; 
+	VertexArray& operator=(const VertexArray&) = delete; 
+
+	//adds the attributes of a layout on the next free locations and returns its binding index,
+	//with a divisor of 1 the buffer advances once per instance instead of once per vertex
+	unsigned int AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout, unsigned int divisor = 0); 
+	unsigned int AddBuffer(const StreamBuffer& sb, const VertexBufferLayout& layout, unsigned int divisor = 0); 
+
+	template<typename Vertex>
+	unsigned int AddBuffer(const VertexBuffer& vb, unsigned int divisor = 0)
+	{ 
+		return AddBuffer(vb, VertexBufferLayout::Of<Vertex>(), divisor); 
+	}
+	template<typename Vertex>
+	unsigned int AddBuffer(const StreamBuffer& sb, unsigned int divisor = 0)
+	{ 
+		return AddBuffer(sb, VertexBufferLayout::Of<Vertex>(), divisor); 
+	}
+
+	//points a binding at another buffer with the same layout, offset bytes in
+	void SetBuffer(unsigned int binding, const VertexBuffer& vb, unsigned int offset = 0); 
+	void SetIndexBuffer(const IndexBuffer& ib); 
+
+	void Bind() const; 
+	void Unbind() const; 
+
+	inline unsigned int GetIndexType() const { return m_IndexType; }
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+}; 
@@ -1,28 +1,54 @@
 #include "VertexBuffer.h"
 #include "Renderer.h"
+#include "GLState.h"
 
 VertexBuffer::VertexBuffer(const void* data, unsigned int size)
+  : m_Buffer(GpuBuffer::Create()), m_Size(size)
 {
-	//generates buffer(s)
-    GLCall(glGenBuffers(1, &m_RendererID));
     //select buffer to render data
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    GLState::BindBuffer(GL_ARRAY_BUFFER, m_Buffer.Get()); 
     //cout << "Binded buffer to opengl" << endl;
     GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));  
     //cout << "Generated buffer data addeed posistions" << endl;
 }
 
-VertexBuffer::~VertexBuffer()
+VertexBuffer::VertexBuffer(unsigned int size)
+  : m_Buffer(GpuBuffer::Create()), m_Size(size)
 {
-	GLCall(glDeleteBuffers(1, &m_RendererID)); 
+    GLState::BindBuffer(GL_ARRAY_BUFFER, m_Buffer.Get()); 
+    //no data yet, just reserve the storage
+    GLCall(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+}
+
+VertexBuffer* VertexBuffer::Adopt(unsigned int rendererID, unsigned int size)
+{
+    VertexBuffer* vb = new VertexBuffer(); 
+    vb->m_Buffer = GpuBuffer::Adopt(rendererID); 
+    vb->m_Size = size; 
+    return vb; 
+}
+
+void VertexBuffer::SetData(const void* data, unsigned int size)
+{
+    ASSERT(size <= m_Size);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, m_Buffer.Get()); 
+    GLCall(glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, GL_DYNAMIC_DRAW));
+    GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data));
+}
+
+void VertexBuffer::UpdateData(const void* data, unsigned int size, unsigned int offset)
+{
+    ASSERT(offset + size <= m_Size);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, m_Buffer.Get()); 
+    GLCall(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
 }
 
 void VertexBuffer::Bind() const 
 {
-   GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+   GLState::BindBuffer(GL_ARRAY_BUFFER, m_Buffer.Get()); 
 }
 
 void VertexBuffer::Unbind() const 
 {
-   GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
-}
\ No newline at end of file
+   GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
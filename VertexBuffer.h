@@ -1,13 +1,38 @@
 #pragma once
 
+#include "ResourceManager.h"
+
+//The name comes from the ResourceManager's pool and goes back through its
+//deferred deletion, so creating and dropping buffers costs no glGen/glDelete.
 class VertexBuffer
 { 
 private: 
-	unsigned int m_RendererID; 
+	GpuBuffer m_Buffer; 
+	unsigned int m_Size; 
+
+	VertexBuffer() {}
 public: 
+	//static buffer, uploaded once
 	VertexBuffer(const void* data, unsigned int size); 
-	~VertexBuffer(); 
+	//dynamic buffer of the given capacity, filled later with SetData
+	VertexBuffer(unsigned int size); 
+
+	VertexBuffer(const VertexBuffer&) = delete; 
+	VertexBuffer& operator=(const VertexBuffer&) = delete; 
+	VertexBuffer(VertexBuffer&&) = default; 
+	VertexBuffer& operator=(VertexBuffer&&) = default; 
+
+	//takes over a buffer created elsewhere, e.g. by the AssetLoader upload thread
+	static VertexBuffer* Adopt(unsigned int rendererID, unsigned int size); 
+
+	//orphans the old storage so the driver never waits on a draw still reading it
+	void SetData(const void* data, unsigned int size); 
+	//overwrites part of the buffer in place, the rest stays as it is
+	void UpdateData(const void* data, unsigned int size, unsigned int offset); 
 
 	void Bind() const; 
 	void Unbind() const; 
-};
\ No newline at end of file
+
+	inline unsigned int GetSize() const { return m_Size; }
+	inline unsigned int GetRendererID() const { return m_Buffer.Get(); }
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+//16 bit float, GL_HALF_FLOAT attributes take half the bandwidth of floats
+struct Half
+{ 
+	unsigned short Bits; 
+
+	static Half FromFloat(float value)
+	{ 
+		unsigned int f; 
+		memcpy(&f, &value, sizeof(f)); 
+		unsigned int sign = (f >> 16) & 0x8000; 
+		int exponent = int((f >> 23) & 0xff) - 127 + 15; 
+		unsigned int mantissa = f & 0x7fffff; 
+
+		if (exponent <= 0)
+			return { (unsigned short)sign }; 
+		if (exponent >= 31)
+			return { (unsigned short)(sign | 0x7c00) }; 
+		//round to nearest
+		unsigned int bits = sign | (exponent << 10) | (mantissa >> 13); 
+		if (mantissa & 0x1000)
+			bits++; 
+		return { (unsigned short)bits }; 
+	}
+}; 
+
+//One vertex attribute of N components. Normalized integer attributes are
+//read as floats in [0, 1] (or [-1, 1] when signed) by the shader, Integer
+//ones reach the shader as ivec/uvec.
+template<typename T, unsigned int N, bool Normalized = false, bool Integer = false>
+struct Attrib
+{ 
+	T Value[N]; 
+
+	T& operator[](unsigned int i) { return Value[i]; }
+	const T& operator[](unsigned int i) const { return Value[i]; }
+}; 
+
+typedef Attrib<float, 1> Float1; 
+typedef Attrib<float, 2> Float2; 
+typedef Attrib<float, 3> Float3; 
+typedef Attrib<float, 4> Float4; 
+typedef Attrib<Half, 2> Half2; 
+typedef Attrib<Half, 4> Half4; 
+typedef Attrib<unsigned char, 4, true> UNorm8x4; 
+typedef Attrib<short, 2, true> SNorm16x2; 
+typedef Attrib<unsigned short, 2, true> UNorm16x2; 
+typedef Attrib<int, 1, false, true> Int1; 
+typedef Attrib<unsigned int, 1, false, true> UInt1; 
+
+template<typename T> struct GLTypeOf; 
+template<> struct GLTypeOf<float>          { static constexpr unsigned int Value = GL_FLOAT; }; 
+template<> struct GLTypeOf<Half>           { static constexpr unsigned int Value = GL_HALF_FLOAT; }; 
+template<> struct GLTypeOf<char>           { static constexpr unsigned int Value = GL_BYTE; }; 
+template<> struct GLTypeOf<unsigned char>  { static constexpr unsigned int Value = GL_UNSIGNED_BYTE; }; 
+template<> struct GLTypeOf<short>          { static constexpr unsigned int Value = GL_SHORT; }; 
+template<> struct GLTypeOf<unsigned short> { static constexpr unsigned int Value = GL_UNSIGNED_SHORT; }; 
+template<> struct GLTypeOf<int>            { static constexpr unsigned int Value = GL_INT; }; 
+template<> struct GLTypeOf<unsigned int>   { static constexpr unsigned int Value = GL_UNSIGNED_INT; }; 
+
+template<typename A> struct AttribTraits; 
+template<typename T, unsigned int N, bool Normalized, bool Integer>
+struct AttribTraits<Attrib<T, N, Normalized, Integer>>
+{ 
+	static constexpr unsigned int Type = GLTypeOf<T>::Value; 
+	static constexpr unsigned int Count = N; 
+	static constexpr bool IsNormalized = Normalized; 
+	static constexpr bool IsInteger = Integer; 
+}; 
+//plain scalars work too, a float member is a Float1
+template<> struct AttribTraits<float> : AttribTraits<Float1> {}; 
+
+struct VertexBufferElement
+{ 
+	unsigned int Type; 
+	unsigned int Count; 
+	bool Normalized; 
+	bool Integer; 
+	unsigned int Offset; 
+}; 
+
+//Declares the attributes of a vertex struct in member order, e.g.
+//
+//  struct MyVertex { Float2 Position; UNorm8x4 Color; };
+//  template<> struct VertexFormat<MyVertex> : VertexAttributes<Float2, UNorm8x4> {};
+//
+//Offsets follow the C++ layout rules and the stride is checked against
+//sizeof(MyVertex) at compile time, so the two cannot drift apart.
+template<typename... Attribs>
+struct VertexAttributes
+{ 
+	static constexpr unsigned int Count = sizeof...(Attribs); 
+
+	static constexpr unsigned int Offset(unsigned int index)
+	{ 
+		constexpr unsigned int sizes[] = { sizeof(Attribs)... }; 
+		constexpr unsigned int aligns[] = { alignof(Attribs)... }; 
+		unsigned int offset = 0; 
+		for (unsigned int i = 0; i <= index; i++)
+		{ 
+			offset = (offset + aligns[i] - 1) / aligns[i] * aligns[i]; 
+			if (i < index)
+				offset += sizes[i]; 
+		}
+		return offset; 
+	}
+
+	static constexpr unsigned int Stride()
+	{ 
+		constexpr unsigned int aligns[] = { alignof(Attribs)... }; 
+		unsigned int align = 1; 
+		for (unsigned int a : aligns)
+			align = a > align ? a : align; 
+		unsigned int end = Offset(Count - 1) + LastSize(); 
+		return (end + align - 1) / align * align; 
+	}
+
+	static constexpr unsigned int LastSize()
+	{ 
+		constexpr unsigned int sizes[] = { sizeof(Attribs)... }; 
+		return sizes[Count - 1]; 
+	}
+}; 
+
+template<typename Vertex> struct VertexFormat; 
+
+//a buffer holding a single attribute, e.g. plain Float2 positions
+template<typename T, unsigned int N, bool Normalized, bool Integer>
+struct VertexFormat<Attrib<T, N, Normalized, Integer>> : VertexAttributes<Attrib<T, N, Normalized, Integer>> {}; 
+
+class VertexBufferLayout
+{ 
+private: 
+	std::vector<VertexBufferElement> m_Elements; 
+	unsigned int m_Stride; 
+
+	template<typename... Attribs, size_t... I>
+	void Build(VertexAttributes<Attribs...>, std::index_sequence<I...>)
+	{ 
+		m_Elements = { VertexBufferElement{ AttribTraits<Attribs>::Type, AttribTraits<Attribs>::Count,
+			AttribTraits<Attribs>::IsNormalized, AttribTraits<Attribs>::IsInteger,
+			VertexAttributes<Attribs...>::Offset(I) }... }; 
+		m_Stride = VertexAttributes<Attribs...>::Stride(); 
+	}
+public: 
+	VertexBufferLayout() : m_Stride(0) {}
+	//for layouts only known at runtime, e.g. read from a mesh file
+	VertexBufferLayout(const std::vector<VertexBufferElement>& elements, unsigned int stride)
+		: m_Elements(elements), m_Stride(stride) {}
+
+	template<typename Vertex>
+	static VertexBufferLayout Of()
+	{ 
+		typedef VertexFormat<Vertex> Format; 
+		static_assert(Format::Stride() == sizeof(Vertex), "VertexFormat does not match the members of the vertex struct"); 
+
+		VertexBufferLayout layout; 
+		layout.Build(Format(), std::make_index_sequence<Format::Count>()); 
+		return layout; 
+	}
+
+	inline const std::vector<VertexBufferElement>& GetElements() const { return m_Elements; }
+	inline unsigned int GetStride() const { return m_Stride; }
+}; 
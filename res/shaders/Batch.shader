@@ -0,0 +1,49 @@
+#shader vertex
+#version 410 core
+
+layout (location = 0) in vec2 position;
+layout (location = 1) in vec4 color;
+layout (location = 2) in vec2 texCoord;
+layout (location = 3) in float texIndex;
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+flat out int v_TexIndex;
+
+void main()
+{
+	v_Color = color;
+	v_TexCoord = texCoord;
+	v_TexIndex = int(texIndex);
+	gl_Position = vec4(position.x, position.y, 0.0, 1.0);
+}
+
+#shader fragment 
+#version 410 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+flat in int v_TexIndex;
+
+uniform sampler2D u_Textures[8];
+
+void main()
+{
+	//the slot index varies per quad, so it is not dynamically uniform and
+	//has to be resolved with constant indices
+	vec4 texColor;
+	switch (v_TexIndex)
+	{
+		case 0: texColor = texture(u_Textures[0], v_TexCoord); break;
+		case 1: texColor = texture(u_Textures[1], v_TexCoord); break;
+		case 2: texColor = texture(u_Textures[2], v_TexCoord); break;
+		case 3: texColor = texture(u_Textures[3], v_TexCoord); break;
+		case 4: texColor = texture(u_Textures[4], v_TexCoord); break;
+		case 5: texColor = texture(u_Textures[5], v_TexCoord); break;
+		case 6: texColor = texture(u_Textures[6], v_TexCoord); break;
+		case 7: texColor = texture(u_Textures[7], v_TexCoord); break;
+	}
+	color = texColor * v_Color;
+}
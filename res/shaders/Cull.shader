@@ -0,0 +1,57 @@
+#shader compute
+#version 430 core
+
+//one invocation per object, visible ones append a draw command
+layout (local_size_x = 64) in;
+
+struct CullObject
+{
+	//min x, min y, max x, max y
+	vec4 Bounds;
+	uint Mesh;
+	uint Padding0;
+	uint Padding1;
+	uint Padding2;
+};
+
+struct CullMesh
+{
+	uint Count;
+	uint FirstIndex;
+	int BaseVertex;
+	uint Padding;
+};
+
+//DrawElementsIndirectCommand
+struct Command
+{
+	uint Count;
+	uint InstanceCount;
+	uint FirstIndex;
+	int BaseVertex;
+	uint BaseInstance;
+};
+
+layout (std430, binding = 0) readonly buffer Objects { CullObject objects[]; };
+layout (std430, binding = 1) readonly buffer Meshes { CullMesh meshes[]; };
+layout (std430, binding = 2) writeonly buffer Commands { Command commands[]; };
+layout (std430, binding = 3) buffer Counter { uint visibleCount; };
+
+//min x, min y, max x, max y
+uniform vec4 u_View;
+uniform int u_Count;
+
+void main()
+{
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= uint(u_Count))
+		return;
+
+	vec4 bounds = objects[index].Bounds;
+	if (bounds.x > u_View.z || bounds.z < u_View.x || bounds.y > u_View.w || bounds.w < u_View.y)
+		return;
+
+	CullMesh mesh = meshes[objects[index].Mesh];
+	uint slot = atomicAdd(visibleCount, 1u);
+	commands[slot] = Command(mesh.Count, 1u, mesh.FirstIndex, mesh.BaseVertex, index);
+}
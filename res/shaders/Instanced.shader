@@ -0,0 +1,30 @@
+#shader vertex
+#version 410 core
+
+layout (location = 0) in vec2 position;
+//per instance: x, y, scale, rotation
+layout (location = 1) in vec4 transform;
+layout (location = 2) in vec4 color;
+
+out vec4 v_Color;
+
+void main()
+{
+	float s = sin(transform.w);
+	float c = cos(transform.w);
+	vec2 p = transform.z * vec2(c * position.x - s * position.y, s * position.x + c * position.y);
+	v_Color = color;
+	gl_Position = vec4(p + transform.xy, 0.0, 1.0);
+}
+
+#shader fragment 
+#version 410 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+
+void main()
+{
+	color = v_Color;
+}
@@ -0,0 +1,27 @@
+#shader vertex
+#version 410 core
+
+layout (location = 0) in vec2 position;
+
+//x, y, scale, rotation
+uniform vec4 u_Transform;
+
+void main()
+{
+	float s = sin(u_Transform.w);
+	float c = cos(u_Transform.w);
+	vec2 p = u_Transform.z * vec2(c * position.x - s * position.y, s * position.x + c * position.y);
+	gl_Position = vec4(p + u_Transform.xy, 0.0, 1.0);
+}
+
+#shader fragment 
+#version 410 core
+
+layout(location = 0) out vec4 color;
+
+uniform vec4 u_Color;
+
+void main()
+{
+	color = u_Color;
+}